@@ -26,9 +26,9 @@ bool ToWeakFunction(State* state, int index,
   if (GetType(state, index) != LuaType::Function)
     return false;
   std::shared_ptr<Handle> handle = Weak::New(state, index);
-  *out = [state, handle](ArgTypes... args) -> ReturnType {
+  *out = [handle](ArgTypes... args) -> ReturnType {
     return internal::PCallHelper<ReturnType, ArgTypes...>::Run(
-        state, handle, std::move(args)...);
+        handle, std::move(args)...);
   };
   return true;
 }
@@ -48,6 +48,10 @@ struct MemberTraits<std::function<Sig>> {
 };
 
 // Define how callbacks are converted.
+//
+// A coroutine can be passed as callback without return value, it will be
+// resumed with the arguments of callback, so scripts can wait for async
+// operations by yielding.
 template<typename ReturnType, typename... ArgTypes>
 struct Type<std::function<ReturnType(ArgTypes...)>> {
   static constexpr const char* name = "function";
@@ -62,12 +66,15 @@ struct Type<std::function<ReturnType(ArgTypes...)>> {
       *out = nullptr;
       return true;
     }
+    if (GetType(state, index) == LuaType::Thread)
+      return internal::ResumeHelper<ReturnType, ArgTypes...>::Convert(
+          state, index, out);
     if (GetType(state, index) != LuaType::Function)
       return false;
     std::shared_ptr<Handle> handle = Persistent::New(state, index);
-    *out = [state, handle](ArgTypes... args) -> ReturnType {
+    *out = [handle](ArgTypes... args) -> ReturnType {
       return internal::PCallHelper<ReturnType, ArgTypes...>::Run(
-          state, handle, std::move(args)...);
+          handle, std::move(args)...);
     };
     return true;
   }
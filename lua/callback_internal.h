@@ -12,6 +12,7 @@
 
 #include "base/template_util.h"
 #include "lua/call_context.h"
+#include "lua/coroutine.h"
 #include "lua/handle.h"
 #include "lua/pcall.h"
 #include "lua/table.h"
@@ -191,11 +192,11 @@ inline void PushCFunction(State* state, const std::function<Sig>& callback) {
 // Call PCall for the gloal handle.
 template<typename ReturnType, typename...ArgTypes>
 struct PCallHelper {
-  static ReturnType Run(State* state, const std::shared_ptr<Handle>& handle,
+  static ReturnType Run(const std::shared_ptr<Handle>& handle,
                         ArgTypes... args) {
     ReturnType result = ReturnType();
+    State* state = handle->state();
     int top = GetTop(state);
-    DCHECK_EQ(state, handle->state());
     handle->Push();
     if (!PCall(state, &result, args...)) {
       std::string error;
@@ -207,23 +208,76 @@ struct PCallHelper {
   }
 };
 
-// The void return type version for PCallHelper.
+// The void return type version for PCallHelper, the function is run in a
+// coroutine so it can yield, for example to wait for an async operation.
 template<typename...ArgTypes>
 struct PCallHelper<void, ArgTypes...> {
-  static void Run(State* state, const std::shared_ptr<Handle>& handle,
-                  ArgTypes... args) {
+  static void Run(const std::shared_ptr<Handle>& handle, ArgTypes... args) {
+    State* state = handle->state();
     int top = GetTop(state);
-    DCHECK_EQ(state, handle->state());
+    State* thread = PushIdleThread(state);
     handle->Push();
-    if (!PCall(state, nullptr, args...)) {
-      std::string error;
-      lua::Pop(state, &error);
-      LOG(ERROR) << "Error when calling lua function: " << error;
-    }
+    lua_xmove(state, thread, 1);
+    Push(thread, args...);
+    // A yielded coroutine is kept alive by whoever resumes it, and only the
+    // finished coroutine can be reused.
+    if (Resume(thread, state, sizeof...(ArgTypes)) == LUA_OK)
+      ReleaseIdleThread(state, top + 1);
     SetTop(state, top);  // reset everything on stack
   }
 };
 
+// Converts a coroutine to callback which resumes the coroutine with the
+// arguments, only callbacks without return values can wait for coroutines.
+template<typename ReturnType, typename...ArgTypes>
+struct ResumeHelper {
+  static bool Convert(State* state, int index,
+                      std::function<ReturnType(ArgTypes...)>* out) {
+    return false;
+  }
+};
+
+template<typename...ArgTypes>
+struct ResumeHelper<void, ArgTypes...> {
+  // The reference to the coroutine is dropped once it gets resumed.
+  using Ref = std::shared_ptr<std::unique_ptr<Persistent>>;
+
+  static bool Convert(State* state, int index,
+                      std::function<void(ArgTypes...)>* out) {
+    Ref ref = std::make_shared<std::unique_ptr<Persistent>>();
+    lua::Push(state, ValueOnStack(state, index));
+    ref->reset(new Persistent(state));
+    *out = [ref](ArgTypes... args) {
+      Run(ref, std::move(args)...);
+    };
+    return true;
+  }
+
+  static void Run(const Ref& ref, ArgTypes... args) {
+    if (!*ref) {
+      LOG(ERROR) << "The coroutine has already been resumed";
+      return;
+    }
+    State* state = (*ref)->state();
+    int top = GetTop(state);
+    (*ref)->Push();
+    State* thread = lua_tothread(state, -1);
+    // The coroutine is kept on stack while running.
+    ref->reset();
+    if (lua_status(thread) != LUA_YIELD) {
+      // Happens when the callback is called before the coroutine yields, the
+      // arguments are returned by its next yield instead.
+      Push(state, args...);
+      SetPendingResume(state, thread, sizeof...(ArgTypes));
+      SetTop(state, top);
+      return;
+    }
+    Push(thread, args...);
+    Resume(thread, state, sizeof...(ArgTypes));
+    SetTop(state, top);
+  }
+};
+
 }  // namespace internal
 
 }  // namespace lua
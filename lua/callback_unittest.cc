@@ -218,3 +218,127 @@ TEST_F(CallbackTest, WeakFunctionIsStoredWeak) {
   lua::CollectGarbage(state_);
   EXPECT_EQ(callback(123), 0);
 }
+
+class CoroutineTest : public CallbackTest {
+ protected:
+  void SetUp() override {
+    CallbackTest::SetUp();
+    luaL_openlibs(state_);
+    // wait(callback) stores the callback for later calls.
+    std::function<void(const std::function<void(int)>&)> wait =
+        [this](const std::function<void(int)>& callback) {
+      resume_ = callback;
+    };
+    lua::Push(state_, wait);
+    lua_setglobal(state_, "wait");
+  }
+
+  std::function<void(int)> resume_;
+};
+
+TEST_F(CoroutineTest, ResumeCoroutine) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "co = coroutine.create(function()\n"
+      "  wait(coroutine.running())\n"
+      "  result = coroutine.yield()\n"
+      "end)\n"
+      "coroutine.resume(co)"));
+  ASSERT_TRUE(resume_);
+  resume_(123);
+  int result = 0;
+  lua_getglobal(state_, "result");
+  ASSERT_TRUE(lua::Pop(state_, &result));
+  EXPECT_EQ(result, 123);
+  EXPECT_EQ(lua::GetTop(state_), 0);
+  // Resuming twice is ignored.
+  resume_(456);
+  lua_getglobal(state_, "result");
+  ASSERT_TRUE(lua::Pop(state_, &result));
+  EXPECT_EQ(result, 123);
+}
+
+TEST_F(CoroutineTest, CallbackCanYield) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "return function(a)\n"
+      "  wait(coroutine.running())\n"
+      "  result = a + coroutine.yield()\n"
+      "end"));
+  std::function<void(int)> callback;
+  ASSERT_TRUE(lua::To(state_, -1, &callback));
+  lua::SetTop(state_, 0);
+  callback(1);
+  ASSERT_TRUE(resume_);
+  resume_(2);
+  int result = 0;
+  lua_getglobal(state_, "result");
+  ASSERT_TRUE(lua::Pop(state_, &result));
+  EXPECT_EQ(result, 3);
+  EXPECT_EQ(lua::GetTop(state_), 0);
+}
+
+TEST_F(CoroutineTest, CoroutineIsNotStoredAfterResume) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "local co = coroutine.create(function()\n"
+      "  wait(coroutine.running())\n"
+      "  coroutine.yield()\n"
+      "end)\n"
+      "coroutine.resume(co)\n"
+      "return setmetatable({}, {__mode = 'v'}), co"));
+  // weak[1] = co
+  lua_pushvalue(state_, 2);
+  lua_rawseti(state_, 1, 1);
+  lua::SetTop(state_, 1);
+  resume_(0);
+  lua::CollectGarbage(state_);
+  lua_rawgeti(state_, 1, 1);
+  EXPECT_EQ(lua::GetType(state_, -1), lua::LuaType::Nil);
+}
+
+TEST_F(CoroutineTest, ResumeBeforeYield) {
+  // finish(n) calls the stored callback before the coroutine yields.
+  std::function<void(int)> finish = [this](int value) {
+    resume_(value);
+  };
+  lua::Push(state_, finish);
+  lua_setglobal(state_, "finish");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "return function(a)\n"
+      "  wait(coroutine.running())\n"
+      "  finish(2)\n"
+      "  result = a + coroutine.yield()\n"
+      "end"));
+  std::function<void(int)> callback;
+  ASSERT_TRUE(lua::To(state_, -1, &callback));
+  lua::SetTop(state_, 0);
+  callback(1);
+  int result = 0;
+  lua_getglobal(state_, "result");
+  ASSERT_TRUE(lua::Pop(state_, &result));
+  EXPECT_EQ(result, 3);
+  EXPECT_EQ(lua::GetTop(state_), 0);
+}
+
+TEST_F(CoroutineTest, ErrorHandler) {
+  std::string error;
+  std::function<void(const std::string&)> handler =
+      [&error](const std::string& message) {
+    error = message;
+  };
+  lua::Push(state_, handler);
+  lua::SetErrorHandler(state_, -1);
+  ASSERT_FALSE(luaL_dostring(state_,
+      "return function()\n"
+      "  wait(coroutine.running())\n"
+      "  coroutine.yield()\n"
+      "  error('resumed error')\n"
+      "end"));
+  std::function<void()> callback;
+  ASSERT_TRUE(lua::To(state_, -1, &callback));
+  lua::SetTop(state_, 0);
+  callback();
+  EXPECT_TRUE(error.empty());
+  resume_(0);
+  EXPECT_NE(error.find("resumed error"), std::string::npos);
+  EXPECT_NE(error.find("stack traceback"), std::string::npos);
+  EXPECT_EQ(lua::GetTop(state_), 0);
+}
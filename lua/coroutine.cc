@@ -0,0 +1,148 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua/coroutine.h"
+
+#include <string>
+
+#include "base/logging.h"
+
+namespace lua {
+
+namespace {
+
+// The key to store the idle thread in registry.
+const char kIdleThreadKey = 0;
+
+// The key to store the table of pending resume values in registry.
+const char kPendingResumeKey = 0;
+
+// The key to store the error handler in registry.
+const char kErrorHandlerKey = 0;
+
+// Push the values stored for |thread| by SetPendingResume in place of the
+// values it yielded, return -1 if there is nothing stored.
+int PushPendingResume(State* thread) {
+  lua_rawgetp(thread, LUA_REGISTRYINDEX, &kPendingResumeKey);
+  if (GetType(thread, -1) != LuaType::Table) {
+    lua_pop(thread, 1);
+    return -1;
+  }
+  lua_pushthread(thread);
+  lua_rawget(thread, -2);
+  if (GetType(thread, -1) != LuaType::Table) {
+    lua_pop(thread, 2);
+    return -1;
+  }
+  // pending[thread] = nil
+  lua_pushthread(thread);
+  lua_pushnil(thread);
+  lua_rawset(thread, -4);
+  // Only keep the values on stack.
+  lua_replace(thread, 1);
+  lua_settop(thread, 1);
+  lua_getfield(thread, 1, "n");
+  int nargs = static_cast<int>(lua_tointeger(thread, -1));
+  lua_pop(thread, 1);
+  for (int i = 1; i <= nargs; ++i)
+    lua_rawgeti(thread, 1, i);
+  lua_remove(thread, 1);
+  return nargs;
+}
+
+// Pass the error of |thread| to the error handler.
+void ReportError(State* thread, State* from) {
+  std::string error;
+  if (!To(thread, -1, &error))
+    error = "unknown error";
+  luaL_traceback(from, thread, error.c_str(), 0);
+  lua_rawgetp(from, LUA_REGISTRYINDEX, &kErrorHandlerKey);
+  if (GetType(from, -1) == LuaType::Function) {
+    lua_pushvalue(from, -2);
+    if (lua_pcall(from, 1, 0, 0) == LUA_OK) {
+      lua_pop(from, 1);
+      return;
+    }
+    std::string handler_error;
+    To(from, -1, &handler_error);
+    LOG(ERROR) << "Error when calling error handler: " << handler_error;
+  }
+  lua_pop(from, 1);
+  Pop(from, &error);
+  LOG(ERROR) << "Error when calling lua function: " << error;
+}
+
+
+}  // namespace
+
+State* GetMainThread(State* state) {
+  lua_rawgeti(state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+  State* main = lua_tothread(state, -1);
+  lua_pop(state, 1);
+  return main;
+}
+
+State* PushIdleThread(State* state) {
+  lua_rawgetp(state, LUA_REGISTRYINDEX, &kIdleThreadKey);
+  if (GetType(state, -1) == LuaType::Thread) {
+    // Take it out of cache so nested calls do not use it.
+    lua_pushnil(state);
+    lua_rawsetp(state, LUA_REGISTRYINDEX, &kIdleThreadKey);
+    return lua_tothread(state, -1);
+  }
+  lua_pop(state, 1);
+  return lua_newthread(state);
+}
+
+void ReleaseIdleThread(State* state, int index) {
+  DCHECK_EQ(lua_status(lua_tothread(state, index)), LUA_OK);
+  lua_pushvalue(state, index);
+  lua_rawsetp(state, LUA_REGISTRYINDEX, &kIdleThreadKey);
+}
+
+int Resume(State* thread, State* from, int nargs) {
+  int status = lua_resume(thread, from, nargs);
+  while (status == LUA_YIELD && (nargs = PushPendingResume(thread)) >= 0)
+    status = lua_resume(thread, from, nargs);
+  if (status == LUA_OK)
+    lua_settop(thread, 0);
+  else if (status != LUA_YIELD)
+    ReportError(thread, from);
+  return status;
+}
+
+void SetPendingResume(State* state, State* thread, int nargs) {
+  // args = {..., n = nargs}
+  lua_createtable(state, nargs, 1);
+  lua_insert(state, -nargs - 1);
+  for (int i = nargs; i >= 1; --i)
+    lua_rawseti(state, -i - 1, i);
+  lua_pushinteger(state, nargs);
+  lua_setfield(state, -2, "n");
+  // The table is weak keyed so a coroutine that never yields is collected.
+  lua_rawgetp(state, LUA_REGISTRYINDEX, &kPendingResumeKey);
+  if (GetType(state, -1) != LuaType::Table) {
+    lua_pop(state, 1);
+    lua_newtable(state);
+    lua_createtable(state, 0, 1);
+    lua_pushliteral(state, "k");
+    lua_setfield(state, -2, "__mode");
+    lua_setmetatable(state, -2);
+    lua_pushvalue(state, -1);
+    lua_rawsetp(state, LUA_REGISTRYINDEX, &kPendingResumeKey);
+  }
+  // pending[thread] = args
+  lua_pushthread(thread);
+  lua_xmove(thread, state, 1);
+  lua_pushvalue(state, -3);
+  lua_rawset(state, -3);
+  lua_pop(state, 2);
+}
+
+void SetErrorHandler(State* state, int index) {
+  lua_pushvalue(state, index);
+  lua_rawsetp(state, LUA_REGISTRYINDEX, &kErrorHandlerKey);
+}
+
+}  // namespace lua
@@ -0,0 +1,45 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+//
+// Helpers for running callbacks in coroutines.
+
+#ifndef LUA_COROUTINE_H_
+#define LUA_COROUTINE_H_
+
+#include "lua/stack.h"
+
+namespace lua {
+
+// Return the main thread of |state|.
+State* GetMainThread(State* state);
+
+// Push a coroutine that can be used to run a function, the coroutine is not
+// reused by others until it is released by ReleaseIdleThread.
+State* PushIdleThread(State* state);
+
+// Make the finished coroutine at |index| available for PushIdleThread.
+void ReleaseIdleThread(State* state, int index);
+
+// Resume |thread| with |nargs| arguments on its stack, the values returned by
+// a finished coroutine are dropped.
+//
+// If values were stored by SetPendingResume before the coroutine yields, the
+// yield returns them immediately.
+//
+// There is no Lua caller to catch the errors of the coroutine, so they are
+// passed to the handler set by SetErrorHandler with a traceback, or logged
+// when there is no handler.
+int Resume(State* thread, State* from, int nargs);
+
+// Pop |nargs| values from |state| and store them to be returned by the next
+// yield of |thread|, used when a coroutine is resumed before it yields.
+void SetPendingResume(State* state, State* thread, int nargs);
+
+// Set the function at |index| as the handler of errors raised in coroutines
+// resumed by Resume, nil removes the handler.
+void SetErrorHandler(State* state, int index);
+
+}  // namespace lua
+
+#endif  // LUA_COROUTINE_H_
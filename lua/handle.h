@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "lua/coroutine.h"
 #include "lua/stack.h"
 
 namespace lua {
@@ -30,9 +31,12 @@ inline int CollectGarbage(State* state, GCOp op = GCOp::Collect, int arg = 0) {
 }
 
 // Comman handle class.
+//
+// The handle always refers to the main thread, since the coroutine that
+// created the handle may have been collected when the handle is used.
 class Handle {
  public:
-  explicit Handle(State* state) : state_(state) {}
+  explicit Handle(State* state) : state_(GetMainThread(state)) {}
   virtual ~Handle() {}
 
   // Puts the value back to stack.
@@ -2,6 +2,8 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <stdint.h>
+
 #include <string>
 #include <tuple>
 
@@ -46,6 +48,19 @@ TEST_F(LuaTest, PushesAndGetsMultipleValues) {
   ASSERT_EQ(lua::GetTop(state_), 5);
 }
 
+TEST_F(LuaTest, Uint64RoundTrip) {
+  const uint64_t values[] = {0, 1, (1ull << 63) - 1, 1ull << 63, UINT64_MAX};
+  for (uint64_t value : values) {
+    lua::Push(state_, value);
+    uint64_t out = 0;
+    ASSERT_TRUE(lua::Pop(state_, &out));
+    EXPECT_EQ(out, value);
+  }
+  lua::Push(state_, 1.5);
+  uint64_t out = 0;
+  EXPECT_FALSE(lua::Pop(state_, &out));
+}
+
 TEST_F(LuaTest, PopsValues) {
   lua::Push(state_, 1, 2, 3, 4, 5);
   int i1, i2, i3, i4, i5;
@@ -92,6 +92,24 @@ struct Type<uint32_t> {
   }
 };
 
+// Values not less than 2^63 wrap around to negative integers, which follows
+// how Lua treats unsigned integers and converts back to the same value.
+template<>
+struct Type<uint64_t> {
+  static constexpr const char* name = "integer";
+  static inline void Push(State* state, uint64_t number) {
+    lua_pushinteger(state, static_cast<lua_Integer>(number));
+  }
+  static inline bool To(State* state, int index, uint64_t* out) {
+    int success = 0;
+    lua_Integer ret = lua_tointegerx(state, index, &success);
+    if (!success)
+      return false;
+    *out = static_cast<uint64_t>(ret);
+    return true;
+  }
+};
+
 template<>
 struct Type<float> {
   static constexpr const char* name = "number";
@@ -97,8 +97,11 @@ template<>
 struct Type<nu::RectF> {
   static constexpr const char* name = "yue.RectF";
   static inline void Push(State* state, const nu::RectF& rect) {
-    lua::NewTable(state);
-    lua::RawSet(state, -1,
+    lua::NewTable(state, 0, 4);
+    Refresh(state, -1, rect);
+  }
+  static inline void Refresh(State* state, int index, const nu::RectF& rect) {
+    lua::RawSet(state, index,
                 "x", rect.x(), "y", rect.y(),
                 "width", rect.width(), "height", rect.height());
   }
@@ -143,8 +146,11 @@ template<>
 struct Type<nu::PointF> {
   static constexpr const char* name = "yue.PointF";
   static inline void Push(State* state, const nu::PointF& p) {
-    lua::NewTable(state);
-    lua::RawSet(state, -1, "x", p.x(), "y", p.y());
+    lua::NewTable(state, 0, 2);
+    Refresh(state, -1, p);
+  }
+  static inline void Refresh(State* state, int index, const nu::PointF& p) {
+    lua::RawSet(state, index, "x", p.x(), "y", p.y());
   }
   static inline bool To(State* state, int index, nu::PointF* out) {
     float x = 0, y = 0;
@@ -226,6 +232,9 @@ struct Type<nu::App> {
            RefMethod(&nu::App::SetApplicationMenu, RefType::Reset, "appmenu"),
            "setdockbadgelabel", &nu::App::SetDockBadgeLabel,
            "getdockbadgelabel", &nu::App::GetDockBadgeLabel,
+#endif
+#if defined(OS_LINUX)
+           "warmupfonts", &nu::App::WarmupFonts,
 #endif
            "getcolor", &nu::App::GetColor,
            "getdefaultfont", &nu::App::GetDefaultFont);
@@ -403,11 +412,54 @@ struct Type<nu::Image> {
            "createfrombuffer", &CreateOnHeap<nu::Image,
                                              const nu::Buffer&,
                                              float>,
+           "createfromasar", &nu::Image::CreateFromAsar,
+           "createfromencryptedasar", &nu::Image::CreateFromEncryptedAsar,
            "getsize", &nu::Image::GetSize,
            "getscalefactor", &nu::Image::GetScaleFactor);
   }
 };
 
+template<>
+struct Type<nu::ImageSet> {
+  static constexpr const char* name = "yue.ImageSet";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &CreateOnHeap<nu::ImageSet>,
+           "addfile", &nu::ImageSet::AddFile,
+           "addasarentry", &nu::ImageSet::AddAsarEntry,
+           "getimageforscale", &nu::ImageSet::GetImageForScale,
+           "getimage", &nu::ImageSet::GetImage,
+           "getsize", &nu::ImageSet::GetSize,
+           "getscalefactors", &nu::ImageSet::GetScaleFactors);
+  }
+};
+
+template<>
+struct Type<nu::ImageAtlas> {
+  static constexpr const char* name = "yue.ImageAtlas";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &CreateOnHeap<nu::ImageAtlas, const nu::SizeF&, float>,
+           "createformainscreen", &CreateOnHeap<nu::ImageAtlas,
+                                                const nu::SizeF&>,
+           "addimage", &nu::ImageAtlas::AddImage,
+           "getcanvas", &nu::ImageAtlas::GetCanvas,
+           "getsize", &nu::ImageAtlas::GetSize,
+           "getscalefactor", &nu::ImageAtlas::GetScaleFactor);
+  }
+};
+
+template<>
+struct Type<nu::AtlasImage> {
+  static constexpr const char* name = "yue.AtlasImage";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "getatlas", &nu::AtlasImage::GetAtlas,
+           "getrect", &nu::AtlasImage::GetRect,
+           "getsize", &nu::AtlasImage::GetSize);
+  }
+};
+
 template<>
 struct Type<nu::TextAlign> {
   static constexpr const char* name = "yue.TextAlign";
@@ -452,6 +504,66 @@ struct Type<nu::TextMetrics> {
   }
 };
 
+template<>
+struct Type<nu::AttributedText> {
+  static constexpr const char* name = "yue.AttributedText";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "settext", &nu::AttributedText::SetText,
+           "gettext", &nu::AttributedText::GetText,
+           "setfont", &nu::AttributedText::SetFont,
+           "setcolor", &nu::AttributedText::SetColor,
+           "setalign", &nu::AttributedText::SetAlign,
+           "setvalign", &nu::AttributedText::SetValign,
+           "setfontfor", &SetFontFor,
+           "setcolorfor", &SetColorFor,
+           "clearstyles", &nu::AttributedText::ClearStyles,
+           "setwrapwidth", &nu::AttributedText::SetWrapWidth,
+           "getwrapwidth", &nu::AttributedText::GetWrapWidth,
+           "getmetrics", &nu::AttributedText::GetMetrics);
+  }
+  static nu::AttributedText* Create(CallContext* context,
+                                    const std::string& text) {
+    nu::TextAttributes attributes;
+    if (GetType(context->state, context->current_arg) == LuaType::Table)
+      To(context->state, context->current_arg, &attributes);
+    return new nu::AttributedText(text, attributes);
+  }
+  // The ranges are 1-based and inclusive, like the ones of string.find.
+  static void SetFontFor(nu::AttributedText* text, nu::Font* font,
+                         int start, int end) {
+    text->SetFontFor(font, start - 1, end);
+  }
+  static void SetColorFor(nu::AttributedText* text, nu::Color color,
+                          int start, int end) {
+    text->SetColorFor(color, start - 1, end);
+  }
+};
+
+template<>
+struct Type<nu::TextRun> {
+  static constexpr const char* name = "yue.TextRun";
+  static inline bool To(State* state, int index, nu::TextRun* out) {
+    if (GetType(state, index) != LuaType::Table)
+      return false;
+    nu::AttributedText* text;
+    if (!RawGetAndPop(state, index, "text", &text) ||
+        !RawGetAndPop(state, index, "rect", &out->rect))
+      return false;
+    out->text = text;
+    return true;
+  }
+};
+
+template<>
+struct Type<nu::PainterCommand> {
+  static constexpr const char* name = "yue.PainterCommand";
+  static inline void Push(State* state, nu::PainterCommand command) {
+    lua::Push(state, static_cast<int>(command));
+  }
+};
+
 template<>
 struct Type<nu::Painter> {
   static constexpr const char* name = "yue.Painter";
@@ -481,10 +593,89 @@ struct Type<nu::Painter> {
            "fillrect", &nu::Painter::FillRect,
            "drawimage", &nu::Painter::DrawImage,
            "drawimagefromrect", &nu::Painter::DrawImageFromRect,
+           "drawimageset", &nu::Painter::DrawImageSet,
+           "drawatlasimage", &nu::Painter::DrawAtlasImage,
            "drawcanvas", &nu::Painter::DrawCanvas,
            "drawcanvasfromrect", &nu::Painter::DrawCanvasFromRect,
            "measuretext", &nu::Painter::MeasureText,
-           "drawtext", &nu::Painter::DrawText);
+           "drawtext", &nu::Painter::DrawText,
+           "drawattributedtext", &nu::Painter::DrawAttributedText,
+           "drawtextbatch", &nu::Painter::DrawTextBatch,
+           "executecommands", &ExecuteCommands,
+           "packcommands", &PackCommands);
+    NewTable(state);
+    RawSet(state, -1,
+           "save", nu::PainterCommand::Save,
+           "restore", nu::PainterCommand::Restore,
+           "beginpath", nu::PainterCommand::BeginPath,
+           "closepath", nu::PainterCommand::ClosePath,
+           "moveto", nu::PainterCommand::MoveTo,
+           "lineto", nu::PainterCommand::LineTo,
+           "beziercurveto", nu::PainterCommand::BezierCurveTo,
+           "arc", nu::PainterCommand::Arc,
+           "rect", nu::PainterCommand::Rect,
+           "clip", nu::PainterCommand::Clip,
+           "cliprect", nu::PainterCommand::ClipRect,
+           "translate", nu::PainterCommand::Translate,
+           "rotate", nu::PainterCommand::Rotate,
+           "scale", nu::PainterCommand::Scale,
+           "setcolor", nu::PainterCommand::SetColor,
+           "setstrokecolor", nu::PainterCommand::SetStrokeColor,
+           "setfillcolor", nu::PainterCommand::SetFillColor,
+           "setlinewidth", nu::PainterCommand::SetLineWidth,
+           "stroke", nu::PainterCommand::Stroke,
+           "fill", nu::PainterCommand::Fill,
+           "strokerect", nu::PainterCommand::StrokeRect,
+           "fillrect", nu::PainterCommand::FillRect);
+    RawSet(state, metatable, "commands", ValueOnStack(state, -1));
+    PopAndIgnore(state, 1);
+  }
+  // Read the numbers of table in one pass.
+  static bool ReadCommands(State* state, int index,
+                           std::vector<float>* commands) {
+    if (GetType(state, index) != LuaType::Table)
+      return false;
+    size_t length = RawLen(state, index);
+    commands->resize(length);
+    for (size_t i = 0; i < length; ++i) {
+      lua_rawgeti(state, index, static_cast<int>(i + 1));
+      bool is_number = GetType(state, -1) == LuaType::Number;
+      (*commands)[i] = static_cast<float>(lua_tonumber(state, -1));
+      PopAndIgnore(state, 1);
+      if (!is_number)
+        return false;
+    }
+    return true;
+  }
+  // Accept either a string returned by packcommands, or a table of numbers.
+  static void ExecuteCommands(CallContext* context, nu::Painter* painter) {
+    State* state = context->state;
+    int index = context->current_arg;
+    bool success;
+    if (GetType(state, index) == LuaType::Table) {
+      std::vector<float> commands;
+      success = ReadCommands(state, index, &commands) &&
+                painter->ExecuteCommands(nu::Buffer::Wrap(
+                    commands.data(), commands.size() * sizeof(float)));
+    } else {
+      nu::Buffer buffer;
+      success = To(state, index, &buffer) && painter->ExecuteCommands(buffer);
+    }
+    if (!success) {
+      context->has_error = true;
+      Push(state, "Malformed painter commands");
+    }
+  }
+  static void PackCommands(CallContext* context) {
+    State* state = context->state;
+    std::vector<float> commands;
+    if (!ReadCommands(state, context->current_arg, &commands)) {
+      context->has_error = true;
+      Push(state, "Malformed painter commands");
+      return;
+    }
+    lua_pushlstring(state, reinterpret_cast<const char*>(commands.data()),
+                    commands.size() * sizeof(float));
   }
 };
 
@@ -552,11 +743,15 @@ struct Type<nu::MouseEvent> {
   static constexpr const char* name = "yue.MouseEvent";
   static inline void Push(State* state, const nu::MouseEvent& event) {
     NewTable(state);
-    Type<nu::Event>::SetEventProperties(state, -1, &event);
-    RawSet(state, -1,
-           "button", event.button,
-           "positioninview", event.position_in_view,
-           "positioninwindow", event.position_in_window);
+    Refresh(state, -1, event);
+  }
+  static inline void Refresh(State* state, int index,
+                             const nu::MouseEvent& event) {
+    index = AbsIndex(state, index);
+    Type<nu::Event>::SetEventProperties(state, index, &event);
+    RawSet(state, index, "button", event.button);
+    RefreshField(state, index, "positioninview", event.position_in_view);
+    RefreshField(state, index, "positioninwindow", event.position_in_window);
   }
 };
 
@@ -574,9 +769,12 @@ struct Type<nu::KeyEvent> {
   static constexpr const char* name = "yue.KeyEvent";
   static inline void Push(State* state, const nu::KeyEvent& event) {
     NewTable(state);
-    Type<nu::Event>::SetEventProperties(state, -1, &event);
-    RawSet(state, -1,
-           "key", event.key);
+    Refresh(state, -1, event);
+  }
+  static inline void Refresh(State* state, int index,
+                             const nu::KeyEvent& event) {
+    Type<nu::Event>::SetEventProperties(state, index, &event);
+    RawSet(state, index, "key", event.key);
   }
 };
 
@@ -644,6 +842,11 @@ struct Type<nu::FileSaveDialog> {
   }
 };
 
+void ReadMenuItems(State* state, int options,
+                   std::vector<scoped_refptr<nu::MenuItem>>* items);
+void ReadMenuItems(State* state, int options, nu::MenuBase* menu);
+void StoreMenuItemRefs(State* state, nu::MenuBase* menu, RefType ref_type);
+
 template<>
 struct Type<nu::MenuBase> {
   static constexpr const char* name = "yue.MenuBase";
@@ -652,19 +855,32 @@ struct Type<nu::MenuBase> {
            "append", RefMethod(&nu::MenuBase::Append, RefType::Ref),
            "insert", RefMethod(&Insert, RefType::Ref),
            "remove", RefMethod(&nu::MenuBase::Remove, RefType::Deref),
+           "setitems", &SetItems,
            "itemcount", &nu::MenuBase::ItemCount,
            "itemat", &ItemAt);
+    RawSetProperty(state, metatable,
+                   "onwillopen", &nu::MenuBase::on_will_open);
   }
   static inline void Insert(nu::MenuBase* menu, nu::MenuItem* item, int i) {
     menu->Insert(item, i - 1);
   }
+  static void SetItems(CallContext* context, nu::MenuBase* menu) {
+    std::vector<scoped_refptr<nu::MenuItem>> items;
+    ReadMenuItems(context->state, context->current_arg, &items);
+    std::vector<nu::MenuItem*> raw_items;
+    raw_items.reserve(items.size());
+    for (const auto& item : items)
+      raw_items.push_back(item.get());
+    // Keep the same references that append and remove would keep.
+    StoreMenuItemRefs(context->state, menu, RefType::Deref);
+    menu->SetItems(raw_items);
+    StoreMenuItemRefs(context->state, menu, RefType::Ref);
+  }
   static inline nu::MenuItem* ItemAt(nu::MenuBase* menu, int i) {
     return menu->ItemAt(i - 1);
   }
 };
 
-void ReadMenuItems(State* state, int metatable, nu::MenuBase* menu);
-
 template<>
 struct Type<nu::MenuBar> {
   using base = nu::MenuBase;
@@ -833,7 +1049,8 @@ struct Type<nu::MenuItem> {
   }
 };
 
-void ReadMenuItems(State* state, int options, nu::MenuBase* menu) {
+void ReadMenuItems(State* state, int options,
+                   std::vector<scoped_refptr<nu::MenuItem>>* items) {
   if (GetType(state, options) != LuaType::Table)
     return;
   StackAutoReset reset(state);
@@ -847,7 +1064,30 @@ void ReadMenuItems(State* state, int options, nu::MenuBase* menu) {
       item = Type<nu::MenuItem>::Create(&context);
     }
     PopAndIgnore(state, 1);
-    menu->Append(item);
+    items->emplace_back(item);
+  }
+}
+
+void ReadMenuItems(State* state, int options, nu::MenuBase* menu) {
+  std::vector<scoped_refptr<nu::MenuItem>> items;
+  ReadMenuItems(state, options, &items);
+  for (const auto& item : items)
+    menu->Append(item.get());
+}
+
+// The |menu| must be at index |1|, which is where its references are stored.
+void StoreMenuItemRefs(State* state, nu::MenuBase* menu, RefType ref_type) {
+  StackAutoReset reset(state);
+  PushRefsTable(state, "__yuerefs", 1);
+  int refs = GetTop(state);
+  for (int i = 0; i < menu->ItemCount(); ++i) {
+    Push(state, menu->ItemAt(i));
+    int item = GetTop(state);
+    if (ref_type == RefType::Ref)
+      RawSet(state, refs, ValueOnStack(state, item), 1);
+    else
+      RawSet(state, refs, ValueOnStack(state, item), nullptr);
+    PopAndIgnore(state, 1);
   }
 }
 
@@ -950,6 +1190,43 @@ struct Type<nu::Window::Options> {
   }
 };
 
+template<>
+struct Type<nu::MemoryDump> {
+  static constexpr const char* name = "yue.MemoryDump";
+  static inline void Push(State* state, const nu::MemoryDump& dump) {
+    NewTable(state, 0, 6);
+    RawSet(state, -1,
+           "view", dump.view.get(),
+           "classname", dump.class_name,
+           "selfbytes", static_cast<double>(dump.self_bytes),
+           "totalbytes", static_cast<double>(dump.total_bytes),
+           "viewcount", dump.view_count,
+           "children", dump.children);
+  }
+};
+
+#if defined(OS_LINUX)
+template<>
+struct Type<nu::Window::FrameStats> {
+  static constexpr const char* name = "yue.Window.FrameStats";
+  static inline void Push(State* state, const nu::Window::FrameStats& stats) {
+    NewTable(state, 0, 11);
+    RawSet(state, -1,
+           "framecount", stats.frame_count,
+           "droppedframes", stats.dropped_frames,
+           "fps", stats.fps,
+           "frameintervalhistogram", stats.frame_interval_histogram,
+           "averagepaintduration", stats.average_paint_duration,
+           "maxpaintduration", stats.max_paint_duration,
+           "averagelayoutduration", stats.average_layout_duration,
+           "maxlayoutduration", stats.max_layout_duration,
+           "slowestdrawclassname", stats.slowest_draw_class_name,
+           "slowestdrawbounds", stats.slowest_draw_bounds,
+           "slowestdrawduration", stats.slowest_draw_duration);
+  }
+};
+#endif
+
 template<>
 struct Type<nu::Window> {
   static constexpr const char* name = "yue.Window";
@@ -1009,16 +1286,31 @@ struct Type<nu::Window> {
            "setmenubar",
            RefMethod(&nu::Window::SetMenuBar, RefType::Reset, "menubar"),
            "getmenubar", &nu::Window::GetMenuBar,
+#endif
+#if defined(OS_LINUX)
+           "setresizethrottled", &nu::Window::SetResizeThrottled,
+           "isresizethrottled", &nu::Window::IsResizeThrottled,
+           "getskippedlayoutcount", &nu::Window::GetSkippedLayoutCount,
+           "setframestatsenabled", &nu::Window::SetFrameStatsEnabled,
+           "isframestatsenabled", &nu::Window::IsFrameStatsEnabled,
+           "getframestats", &nu::Window::GetFrameStats,
+           "resetframestats", &nu::Window::ResetFrameStats,
+           "setframestatsoverlayvisible",
+           &nu::Window::SetFrameStatsOverlayVisible,
+           "isframestatsoverlayvisible",
+           &nu::Window::IsFrameStatsOverlayVisible,
 #endif
            "addchildwindow",
            RefMethod(&nu::Window::AddChildWindow, RefType::Ref),
            "removechildview",
            RefMethod(&nu::Window::RemoveChildWindow, RefType::Deref),
-           "getchildwindows", &nu::Window::GetChildWindows);
+           "getchildwindows", &nu::Window::GetChildWindows,
+           "dumpmemory", &nu::MemoryDump::FromWindow);
     RawSetProperty(state, metatable,
                    "onclose", &nu::Window::on_close,
                    "onfocus", &nu::Window::on_focus,
                    "onblur", &nu::Window::on_blur,
+                   "onresizeend", &nu::Window::on_resize_end,
                    "shouldclose", &nu::Window::should_close);
   }
 };
@@ -1046,6 +1338,10 @@ struct Type<nu::View> {
            "setcapture", &nu::View::SetCapture,
            "releasecapture", &nu::View::ReleaseCapture,
            "hascapture", &nu::View::HasCapture,
+#if defined(OS_LINUX)
+           "capturetocanvas", &nu::View::CaptureToCanvas,
+           "capturetocanvasasync", &nu::View::CaptureToCanvasAsync,
+#endif
            "setmousedowncanmovewindow", &nu::View::SetMouseDownCanMoveWindow,
            "ismousedowncanmovewindow", &nu::View::IsMouseDownCanMoveWindow,
            "setfont", &nu::View::SetFont,
@@ -1059,7 +1355,8 @@ struct Type<nu::View> {
            "wantslayer", &nu::View::WantsLayer,
 #endif
            "getparent", &nu::View::GetParent,
-           "getwindow", &nu::View::GetWindow);
+           "getwindow", &nu::View::GetWindow,
+           "dumpmemory", &nu::MemoryDump::FromView);
     RawSetProperty(state, metatable,
                    "onmousedown", &nu::View::on_mouse_down,
                    "onmouseup", &nu::View::on_mouse_up,
@@ -1092,6 +1389,31 @@ struct Type<nu::ComboBox> {
   }
 };
 
+template<>
+struct Type<nu::SceneItem> {
+  static constexpr const char* name = "yue.SceneItem";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &CreateOnHeap<nu::SceneItem>,
+           "setbounds", &nu::SceneItem::SetBounds,
+           "getbounds", &nu::SceneItem::GetBounds,
+           "setzindex", &nu::SceneItem::SetZIndex,
+           "getzindex", &nu::SceneItem::GetZIndex,
+           "setvisible", &nu::SceneItem::SetVisible,
+           "isvisible", &nu::SceneItem::IsVisible,
+           "schedulepaint", &nu::SceneItem::SchedulePaint,
+           "schedulepaintrect", &nu::SceneItem::SchedulePaintRect,
+           "getcontainer", &nu::SceneItem::GetContainer);
+    RawSetProperty(state, index,
+                   "ondraw", &nu::SceneItem::on_draw,
+                   "onmousedown", &nu::SceneItem::on_mouse_down,
+                   "onmouseup", &nu::SceneItem::on_mouse_up,
+                   "onmousemove", &nu::SceneItem::on_mouse_move,
+                   "onmouseenter", &nu::SceneItem::on_mouse_enter,
+                   "onmouseleave", &nu::SceneItem::on_mouse_leave);
+  }
+};
+
 template<>
 struct Type<nu::Container> {
   using base = nu::View;
@@ -1111,7 +1433,14 @@ struct Type<nu::Container> {
            "removechildview",
            RefMethod(&nu::Container::RemoveChildView, RefType::Deref),
            "childcount", &nu::Container::ChildCount,
-           "childat", &ChildAt);
+           "childat", &ChildAt,
+           "additem", RefMethod(&nu::Container::AddItem, RefType::Ref),
+           "removeitem",
+           RefMethod(&nu::Container::RemoveItem, RefType::Deref),
+           "itemcount", &nu::Container::ItemCount,
+           "itemat", &ItemAt,
+           "getitemat", &nu::Container::GetItemAt,
+           "getitemsinrect", &nu::Container::GetItemsInRect);
     RawSetProperty(state, index, "ondraw", &nu::Container::on_draw);
   }
   // Transalte 1-based index to 0-based.
@@ -1121,6 +1450,9 @@ struct Type<nu::Container> {
   static inline nu::View* ChildAt(nu::Container* container, int i) {
     return container->ChildAt(i - 1);
   }
+  static inline nu::SceneItem* ItemAt(nu::Container* container, int i) {
+    return container->ItemAt(i - 1);
+  }
 };
 
 template<>
@@ -1521,9 +1853,21 @@ struct Type<nu::Scroll> {
 #if !defined(OS_WIN)
            "setOverlayScrollbar", &nu::Scroll::SetOverlayScrollbar,
            "isOverlayScrollbar", &nu::Scroll::IsOverlayScrollbar,
+#endif
+#if defined(OS_LINUX)
+           "setvirtualcontentmode", &nu::Scroll::SetVirtualContentMode,
+           "isvirtualcontentmode", &nu::Scroll::IsVirtualContentMode,
+           "setvirtualcontentsize", &nu::Scroll::SetVirtualContentSize,
+           "getvirtualcontentsize", &nu::Scroll::GetVirtualContentSize,
+           "setscrollposition", &nu::Scroll::SetScrollPosition,
+           "getscrollposition", &nu::Scroll::GetScrollPosition,
 #endif
            "setscrollbarpolicy", &nu::Scroll::SetScrollbarPolicy,
            "getscrollbarpolicy", &nu::Scroll::GetScrollbarPolicy);
+#if defined(OS_LINUX)
+    RawSetProperty(state, metatable,
+                   "ondrawcontent", &nu::Scroll::on_draw_content);
+#endif
   }
 };
 
@@ -1559,10 +1903,23 @@ struct Type<nu::Tab> {
            "pageat", &PageAt,
            "selectpageat", &SelectPageAt,
            "getselectedpage", &nu::Tab::GetSelectedPage,
-           "getselectedpageindex", &GetSelectedPageIndex);
+           "getselectedpageindex", &GetSelectedPageIndex,
+           "addlazypage", &nu::Tab::AddLazyPage,
+           "loadpageat", &LoadPageAt,
+           "ispageloadedat", &IsPageLoadedAt,
+           "setprefetchlazypages", &nu::Tab::SetPrefetchLazyPages,
+           "isprefetchlazypages", &nu::Tab::IsPrefetchLazyPages,
+           "setunloadhiddenpagesafter", &nu::Tab::SetUnloadHiddenPagesAfter,
+           "getunloadhiddenpagesafter", &nu::Tab::GetUnloadHiddenPagesAfter);
     RawSetProperty(state, metatable,
                    "onselectedpagechange", &nu::Tab::on_selected_page_change);
   }
+  static void LoadPageAt(nu::Tab* tab, int index) {
+    tab->LoadPageAt(index - 1);
+  }
+  static bool IsPageLoadedAt(nu::Tab* tab, int index) {
+    return tab->IsPageLoadedAt(index - 1);
+  }
   static nu::View* PageAt(nu::Tab* tab, int index) {
     return tab->PageAt(index - 1);
   }
@@ -1662,6 +2019,36 @@ struct Type<nu::Table::ColumnType> {
   }
 };
 
+template<>
+struct Type<nu::TableCell> {
+  static constexpr const char* name = "yue.TableCell";
+  static inline void Push(State* state, const nu::TableCell& cell) {
+    switch (cell.type()) {
+      case nu::TableCell::Type::Integer:
+        lua_pushinteger(state, static_cast<lua_Integer>(cell.GetInteger()));
+        return;
+      case nu::TableCell::Type::Double:
+        lua::Push(state, cell.GetDouble());
+        return;
+      case nu::TableCell::Type::Boolean:
+        lua::Push(state, cell.GetBool());
+        return;
+      case nu::TableCell::Type::String:
+        lua::Push(state, cell.GetString());
+        return;
+      case nu::TableCell::Type::Image:
+        lua::Push(state, cell.GetImage());
+        return;
+      case nu::TableCell::Type::AtlasImage:
+        lua::Push(state, cell.GetAtlasImage());
+        return;
+      default:
+        lua::PushNil(state);
+        return;
+    }
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnOptions> {
   static constexpr const char* name = "yue.Table.ColumnOptions";
@@ -1669,7 +2056,8 @@ struct Type<nu::Table::ColumnOptions> {
                         nu::Table::ColumnOptions* out) {
     if (GetType(state, index) == LuaType::Table) {
       RawGetAndPop(state, index, "type", &out->type);
-      RawGetAndPop(state, index, "ondraw", &out->on_draw);
+      // The cell is passed so images in the model can reach scripts.
+      RawGetAndPop(state, index, "ondraw", &out->on_draw_cell);
       RawGetAndPop(state, index, "width", &out->width);
       int column;
       if (RawGetAndPop(state, index, "column", &column))
@@ -1679,6 +2067,19 @@ struct Type<nu::Table::ColumnOptions> {
   }
 };
 
+#if defined(OS_LINUX)
+// Rows are 1-based in Lua, so a range [start, end) is converted to an
+// inclusive range of [start + 1, end].
+template<>
+struct Type<nu::Range> {
+  static constexpr const char* name = "yue.Range";
+  static inline void Push(State* state, const nu::Range& range) {
+    NewTable(state, 0, 2);
+    RawSet(state, -1, "start", range.start + 1, "end", range.end);
+  }
+};
+#endif
+
 template<>
 struct Type<nu::Table> {
   using base = nu::View;
@@ -1696,11 +2097,116 @@ struct Type<nu::Table> {
            "getcolumncount", &nu::Table::GetColumnCount,
            "setcolumnsvisible", &nu::Table::SetColumnsVisible,
            "iscolumnsvisible", &nu::Table::IsColumnsVisible,
+#if defined(OS_LINUX)
+           "setmultipleselection", &nu::Table::SetMultipleSelection,
+           "ismultipleselection", &nu::Table::IsMultipleSelection,
+           "selectrange", &SelectRange,
+           "deselectrange", &DeselectRange,
+           "togglerange", &ToggleRange,
+           "selectall", &nu::Table::SelectAll,
+           "deselectall", &nu::Table::DeselectAll,
+           "invertselection", &nu::Table::InvertSelection,
+           "isrowselected", &IsRowSelected,
+           "getselectedranges", &nu::Table::GetSelectedRanges,
+#endif
            "setrowheight", &nu::Table::SetRowHeight,
            "getrowheight", &nu::Table::GetRowHeight);
+#if defined(OS_LINUX)
+    RawSetProperty(state, metatable,
+                   "onselectionchange", &nu::Table::on_selection_change);
+#endif
+  }
+#if defined(OS_LINUX)
+  static void SelectRange(nu::Table* table, uint32_t first, uint32_t last) {
+    table->SelectRange(first - 1, last);
+  }
+  static void DeselectRange(nu::Table* table, uint32_t first, uint32_t last) {
+    table->DeselectRange(first - 1, last);
+  }
+  static void ToggleRange(nu::Table* table, uint32_t first, uint32_t last) {
+    table->ToggleRange(first - 1, last);
+  }
+  static bool IsRowSelected(nu::Table* table, uint32_t row) {
+    return table->IsRowSelected(row - 1);
+  }
+#endif
+};
+
+#if defined(OS_LINUX)
+template<>
+struct Type<nu::TreeModel> {
+  static constexpr const char* name = "yue.TreeModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "getchildcount", &nu::TreeModel::GetChildCount,
+           "getchildat", &GetChildAt,
+           "getparent", &nu::TreeModel::GetParent,
+           "haschildren", &nu::TreeModel::HasChildren,
+           "setvalue", &SetValue,
+           "notifychildrenchanged", &nu::TreeModel::NotifyChildrenChanged,
+           "notifynodechanged", &nu::TreeModel::NotifyNodeChanged);
+  }
+  static nu::TreeModel::NodeId GetChildAt(nu::TreeModel* model,
+                                          nu::TreeModel::NodeId parent,
+                                          uint32_t index) {
+    return model->GetChildAt(parent, index - 1);
+  }
+  static void SetValue(nu::TreeModel* model,
+                       uint32_t column,
+                       nu::TreeModel::NodeId node,
+                       ::base::Value value) {
+    model->SetValue(column - 1, node, std::move(value));
+  }
+};
+
+template<>
+struct Type<nu::AbstractTreeModel> {
+  using base = nu::TreeModel;
+  static constexpr const char* name = "yue.AbstractTreeModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable, "create", &Create);
+    RawSetProperty(state, metatable,
+                   "getchildcount", &nu::AbstractTreeModel::get_child_count,
+                   "getchildat", &nu::AbstractTreeModel::get_child_at,
+                   "getparent", &nu::AbstractTreeModel::get_parent,
+                   "haschildren", &nu::AbstractTreeModel::has_children,
+                   "getvalue", &nu::AbstractTreeModel::get_value,
+                   "setvalue", &nu::AbstractTreeModel::set_value,
+                   "loadchildren", &nu::AbstractTreeModel::load_children);
+  }
+  static nu::AbstractTreeModel* Create() {
+    return new nu::AbstractTreeModel(false /* index_starts_from_0 */);
   }
 };
 
+template<>
+struct Type<nu::Tree> {
+  using base = nu::View;
+  static constexpr const char* name = "yue.Tree";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::Tree>,
+           "setmodel", RefMethod(&nu::Tree::SetModel, RefType::Reset, "model"),
+           "getmodel", &nu::Tree::GetModel,
+           "addcolumn", &nu::Tree::AddColumn,
+           "addcolumnwithoptions",
+           RefMethod(&nu::Tree::AddColumnWithOptions,
+                     RefType::Ref, nullptr, 2),
+           "getcolumncount", &nu::Tree::GetColumnCount,
+           "setcolumnsvisible", &nu::Tree::SetColumnsVisible,
+           "iscolumnsvisible", &nu::Tree::IsColumnsVisible,
+           "expandnode", &nu::Tree::ExpandNode,
+           "collapsenode", &nu::Tree::CollapseNode,
+           "isnodeexpanded", &nu::Tree::IsNodeExpanded,
+           "selectnode", &nu::Tree::SelectNode,
+           "getselectednode", &nu::Tree::GetSelectedNode);
+    RawSetProperty(state, metatable,
+                   "onnodeexpand", &nu::Tree::on_node_expand,
+                   "onnodecollapse", &nu::Tree::on_node_collapse);
+  }
+};
+#endif
+
 template<>
 struct Type<nu::TextEdit> {
   using base = nu::View;
@@ -1839,9 +2345,13 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::MessageLoop>(state, "MessageLoop");
   BindType<nu::App>(state, "App");
   BindType<nu::Font>(state, "Font");
+  BindType<nu::AttributedText>(state, "AttributedText");
   BindType<nu::Canvas>(state, "Canvas");
   BindType<nu::Color>(state, "Color");
   BindType<nu::Image>(state, "Image");
+  BindType<nu::ImageSet>(state, "ImageSet");
+  BindType<nu::ImageAtlas>(state, "ImageAtlas");
+  BindType<nu::AtlasImage>(state, "AtlasImage");
   BindType<nu::Painter>(state, "Painter");
   BindType<nu::Event>(state, "Event");
   BindType<nu::FileDialog>(state, "FileDialog");
@@ -1853,6 +2363,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Window>(state, "Window");
   BindType<nu::ComboBox>(state, "ComboBox");
   BindType<nu::Container>(state, "Container");
+  BindType<nu::SceneItem>(state, "SceneItem");
   BindType<nu::Button>(state, "Button");
   BindType<nu::ProtocolStringJob>(state, "ProtocolStringJob");
   BindType<nu::ProtocolFileJob>(state, "ProtocolFileJob");
@@ -1873,6 +2384,11 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Table>(state, "TableModel");
   BindType<nu::TextEdit>(state, "TextEdit");
   BindType<nu::Tray>(state, "Tray");
+#if defined(OS_LINUX)
+  BindType<nu::TreeModel>(state, "TreeModel");
+  BindType<nu::AbstractTreeModel>(state, "AbstractTreeModel");
+  BindType<nu::Tree>(state, "Tree");
+#endif
 #if defined(OS_MACOSX)
   BindType<nu::Toolbar>(state, "Toolbar");
   BindType<nu::Vibrant>(state, "Vibrant");
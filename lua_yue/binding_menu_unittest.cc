@@ -0,0 +1,62 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/builtin_loader.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class YueMenuTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+    yue::InsertBuiltinModuleLoader(state_);
+    ASSERT_FALSE(luaL_dostring(state_,
+        "gui = require('yue.gui')\n"
+        "menu = gui.Menu.create{}\n"
+        "weak = setmetatable({}, {__mode='k'})\n"
+        "function collected(item)\n"
+        "  collectgarbage()\n"
+        "  return next(weak) == nil\n"
+        "end"));
+  }
+
+  bool Run(const char* code) {
+    if (luaL_dostring(state_, code))
+      return false;
+    bool result = false;
+    return lua::Pop(state_, &result) && result;
+  }
+
+  lua::ManagedState state_;
+};
+
+TEST_F(YueMenuTest, SetItemsReleasesRemovedItems) {
+  EXPECT_TRUE(Run(
+      "local item = gui.MenuItem.create('label')\n"
+      "menu:append(item)\n"
+      "menu:setitems{}\n"
+      "weak[item] = true\n"
+      "item = nil\n"
+      "return collected()"));
+}
+
+TEST_F(YueMenuTest, SetItemsKeepsItems) {
+  EXPECT_TRUE(Run(
+      "local item = gui.MenuItem.create('label')\n"
+      "menu:setitems{item}\n"
+      "menu:setitems{item, gui.MenuItem.create('label')}\n"
+      "weak[item] = true\n"
+      "item = nil\n"
+      "return not collected() and menu:itemcount() == 2"));
+}
+
+TEST_F(YueMenuTest, RemoveAfterSetItems) {
+  EXPECT_TRUE(Run(
+      "local item = gui.MenuItem.create('label')\n"
+      "menu:setitems{item}\n"
+      "menu:remove(item)\n"
+      "weak[item] = true\n"
+      "item = nil\n"
+      "return collected()"));
+}
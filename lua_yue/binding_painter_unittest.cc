@@ -0,0 +1,57 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+
+#include "lua_yue/builtin_loader.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class YuePainterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+    yue::InsertBuiltinModuleLoader(state_);
+    ASSERT_FALSE(luaL_dostring(state_,
+        "gui = require('yue.gui')\n"
+        "canvas = gui.Canvas.create({width=10, height=10}, 1)\n"
+        "painter = canvas:getpainter()\n"
+        "commands = gui.Painter.commands"));
+  }
+
+  // Run |code| and return the error message, or empty string on success.
+  std::string RunForError(const char* code) {
+    if (!luaL_dostring(state_, code))
+      return std::string();
+    std::string error;
+    lua::Pop(state_, &error);
+    return error;
+  }
+
+  lua::ManagedState state_;
+};
+
+TEST_F(YuePainterTest, ExecuteCommands) {
+  EXPECT_EQ(RunForError(
+      "local rect = {commands.fillrect, 0, 0, 5, 5}\n"
+      "painter:executecommands(rect)\n"
+      "painter:executecommands(gui.Painter.packcommands(rect))"), "");
+}
+
+TEST_F(YuePainterTest, ExecuteMalformedCommands) {
+  // Missing arguments.
+  EXPECT_EQ(RunForError("painter:executecommands{commands.fillrect, 0, 0}"),
+            "Malformed painter commands");
+  // Unknown opcode.
+  EXPECT_EQ(RunForError("painter:executecommands{999}"),
+            "Malformed painter commands");
+  // Not numbers.
+  EXPECT_EQ(RunForError("painter:executecommands{commands.rotate, 'a'}"),
+            "Malformed painter commands");
+  // Packed string with a partial float.
+  EXPECT_EQ(RunForError("painter:executecommands('abc')"),
+            "Malformed painter commands");
+  EXPECT_EQ(RunForError("gui.Painter.packcommands{commands.rotate, {}}"),
+            "Malformed painter commands");
+}
@@ -0,0 +1,188 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <utility>
+
+#include "base/strings/stringprintf.h"
+#include "lua_yue/binding_values.h"
+#include "lua_yue/builtin_loader.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if defined(OS_LINUX)
+#include <gtk/gtk.h>
+#endif
+
+namespace {
+
+// How many times the code is run in each iteration of the benchmark.
+const int kLoopCount = 10000;
+
+}  // namespace
+
+class LuaBindingPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+    yue::InsertBuiltinModuleLoader(state_);
+    ASSERT_FALSE(luaL_dostring(state_,
+        "gui = require('yue.gui')\n"
+        "canvas = gui.Canvas.createformainscreen{width=100, height=100}\n"
+        "painter = canvas:getpainter()\n"
+        "slider = gui.Slider.create()\n"
+        "label = gui.Label.create('label')\n"
+        "item = gui.MenuItem.create('label')\n"
+        "font = gui.Font.default()\n"));
+  }
+
+  // Run |code| inside a loop of |kLoopCount| times in a precompiled function.
+  void RunLoop(const std::string& name, const std::string& code) {
+    std::string script = base::StringPrintf(
+        "function bench()\n"
+        "  for i = 1, %d do\n"
+        "    %s\n"
+        "  end\n"
+        "end",
+        kLoopCount, code.c_str());
+    ASSERT_FALSE(luaL_dostring(state_, script.c_str()))
+        << lua_tostring(state_, -1);
+    nu::RunPerfTest(name, kLoopCount, [&]() {
+      lua_getglobal(state_, "bench");
+      ASSERT_FALSE(lua_pcall(state_, 0, 0, 0)) << lua_tostring(state_, -1);
+    });
+  }
+
+  lua::ManagedState state_;
+};
+
+// The cost of the loop itself, which is included in all other results.
+TEST_F(LuaBindingPerfTest, EmptyLoop) {
+  RunLoop("Lua.EmptyLoop", "local a = i");
+}
+
+TEST_F(LuaBindingPerfTest, MethodCall) {
+  RunLoop("Lua.MethodCall.0Args", "painter:save() painter:restore()");
+  RunLoop("Lua.MethodCall.1Args", "painter:setlinewidth(1)");
+  RunLoop("Lua.MethodCall.2Args", "slider:setrange(0, 100)");
+  RunLoop("Lua.MethodCall.3Args", "gui.Color.rgb(1, 2, 3)");
+  RunLoop("Lua.MethodCall.4Args", "gui.Color.argb(1, 2, 3, 4)");
+  RunLoop("Lua.MethodCall.ReturnString", "label:gettext()");
+}
+
+TEST_F(LuaBindingPerfTest, PropertyAccess) {
+  RunLoop("Lua.PropertyAccess.Method", "local f = painter.save");
+  RunLoop("Lua.PropertyAccess.Signal", "local s = item.onclick");
+}
+
+TEST_F(LuaBindingPerfTest, StructConversion) {
+  RunLoop("Lua.RectF.FromTable",
+          "painter:rect({x=0, y=0, width=10, height=10})");
+  RunLoop("Lua.RectF.FromNumbers", "painter:rect(0, 0, 10, 10)");
+  RunLoop("Lua.RectF.ToTable", "label:getbounds()");
+  // Compare with the empty attributes to get the conversion cost.
+  RunLoop("Lua.TextAttributes.Empty",
+          "painter:measuretext('a', -1, {})");
+  RunLoop("Lua.TextAttributes.Full",
+          "painter:measuretext('a', -1, {font=font, color='#FFF', "
+          "align='center', valign='center'})");
+}
+
+TEST_F(LuaBindingPerfTest, SignalEmission) {
+  // Emitting without handlers is the baseline.
+  RunLoop("Lua.Signal.NoHandler", "item:click()");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "count = 0\n"
+      "item.onclick:connect(function(self) count = count + 1 end)"));
+  RunLoop("Lua.Signal.OneHandler", "item:click()");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "for i = 1, 9 do\n"
+      "  item.onclick:connect(function(self) count = count + 1 end)\n"
+      "end"));
+  RunLoop("Lua.Signal.TenHandlers", "item:click()");
+}
+
+// Compares the generic conversion of std::function, which was used for all
+// signals, with the trampolines that reuse wrappers and event tables.
+TEST_F(LuaBindingPerfTest, SignalArguments) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "count = 0\n"
+      "handler = function(self, event)\n"
+      "  count = count + 1\n"
+      "  if event then local x = event.positioninview.x end\n"
+      "end"));
+  nu::Label* view;
+  lua_getglobal(state_, "label");
+  ASSERT_TRUE(lua::Pop(state_, &view));
+  lua_getglobal(state_, "handler");
+  std::function<void(nu::View*)> view_slot;
+  ASSERT_TRUE(lua::ToWeakFunction(state_, -1, &view_slot));
+  lua::SetTop(state_, 0);
+
+  auto emit_size_changed = [view]() {
+    for (int i = 0; i < kLoopCount; ++i)
+      view->on_size_changed.Emit(view);
+  };
+  view->on_size_changed.Connect(view_slot);
+  nu::RunPerfTest("Lua.Signal.View.Generic", kLoopCount, emit_size_changed);
+  view->on_size_changed.DisconnectAll();
+  ASSERT_FALSE(luaL_dostring(state_,
+      "label.onsizechanged:connect(handler)"));
+  nu::RunPerfTest("Lua.Signal.View.Trampoline", kLoopCount,
+                  emit_size_changed);
+
+#if defined(OS_LINUX)
+  GdkEvent* native_event = gdk_event_new(GDK_MOTION_NOTIFY);
+  nu::MouseEvent event(native_event, view->GetNative());
+  lua_getglobal(state_, "handler");
+  std::function<void(nu::View*, const nu::MouseEvent&)> mouse_slot;
+  ASSERT_TRUE(lua::ToWeakFunction(state_, -1, &mouse_slot));
+  lua::SetTop(state_, 0);
+
+  auto emit_mouse_move = [view, &event]() {
+    for (int i = 0; i < kLoopCount; ++i)
+      view->on_mouse_move.Emit(view, event);
+  };
+  view->on_mouse_move.Connect(mouse_slot);
+  nu::RunPerfTest("Lua.Signal.MouseEvent.Generic", kLoopCount,
+                  emit_mouse_move);
+  view->on_mouse_move.DisconnectAll();
+  ASSERT_FALSE(luaL_dostring(state_,
+      "label.onmousemove:connect(handler)"));
+  nu::RunPerfTest("Lua.Signal.MouseEvent.Trampoline", kLoopCount,
+                  emit_mouse_move);
+  gdk_event_free(native_event);
+#endif
+}
+
+TEST_F(LuaBindingPerfTest, WrapperCreation) {
+  RunLoop("Lua.Wrapper.Create", "gui.Label.create('label')");
+  // Includes the time collecting the wrappers and destroying native views.
+  nu::RunPerfTest("Lua.Wrapper.CreateAndGC.1000", 1000, [&]() {
+    ASSERT_FALSE(luaL_dostring(state_,
+        "for i = 1, 1000 do gui.Label.create('label') end\n"
+        "collectgarbage()"));
+  });
+}
+
+TEST_F(LuaBindingPerfTest, ValueRoundTrip) {
+  for (int size : {1, 10, 100, 1000}) {
+    base::Value list(base::Value::Type::LIST);
+    for (int i = 0; i < size; ++i) {
+      base::Value dict(base::Value::Type::DICTIONARY);
+      dict.SetKey("id", base::Value(i));
+      dict.SetKey("name", base::Value("name"));
+      dict.SetKey("checked", base::Value(i % 2 == 0));
+      dict.SetKey("ratio", base::Value(i * 0.5));
+      list.GetList().push_back(std::move(dict));
+    }
+    nu::RunPerfTest(base::StringPrintf("Lua.Value.RoundTrip.%d", size), size,
+                    [&]() {
+      lua::Push(state_, list);
+      base::Value out;
+      ASSERT_TRUE(lua::Pop(state_, &out));
+    });
+  }
+}
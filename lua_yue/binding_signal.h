@@ -5,13 +5,180 @@
 #ifndef LUA_YUE_BINDING_SIGNAL_H_
 #define LUA_YUE_BINDING_SIGNAL_H_
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <type_traits>
 
+#include "base/logging.h"
 #include "lua/lua.h"
+#include "nativeui/events/event.h"
 #include "nativeui/signal.h"
 
+namespace lua {
+
+// Update the table at |key| of the table at |index| in place, or create it if
+// it does not exist.
+template<typename T>
+inline void RefreshField(State* state, int index, const char* key,
+                         const T& value) {
+  index = AbsIndex(state, index);
+  RawGet(state, index, key);
+  if (GetType(state, -1) == LuaType::Table) {
+    Type<T>::Refresh(state, -1, value);
+    PopAndIgnore(state, 1);
+  } else {
+    PopAndIgnore(state, 1);
+    RawSet(state, index, key, value);
+  }
+}
+
+}  // namespace lua
+
 namespace yue {
 
+namespace internal {
+
+// Only the tables of input events are reused, other values like the dirty
+// rect of on_draw are often kept by handlers and must be fresh tables.
+template<typename T>
+struct IsReusableEvent
+    : std::integral_constant<bool, std::is_same<T, nu::MouseEvent>::value ||
+                                   std::is_same<T, nu::KeyEvent>::value> {};
+
+// Pushes the argument at |slot| of signal, the |cache| is a weak table that
+// stores the objects pushed by previous emissions.
+template<typename T, typename Enable = void>
+struct SignalArg {
+  static inline void Push(lua::State* state, int cache, int slot,
+                          const T& arg) {
+    lua::Push(state, arg);
+  }
+};
+
+// The wrapper of RefCounted object is reused when the same object is passed,
+// which is usually the owner of signal, so the wrapper table is not searched.
+template<typename T>
+struct SignalArg<T*, typename std::enable_if<std::is_base_of<
+                         base::subtle::RefCountedBase, T>::value>::type> {
+  static inline void Push(lua::State* state, int cache, int slot, T* arg) {
+    lua_rawgeti(state, cache, slot);
+    if (lua::GetType(state, -1) == lua::LuaType::UserData &&
+        lua::UserData<T>::From(state, lua_touserdata(state, -1)) == arg)
+      return;
+    lua::PopAndIgnore(state, 1);
+    lua::Push(state, arg);
+    lua::RawSet(state, cache, slot, lua::ValueOnStack(state, -1));
+  }
+};
+
+// Event tables are created once and then refreshed for each emission.
+template<typename T>
+struct SignalArg<T,
+                 typename std::enable_if<IsReusableEvent<T>::value>::type> {
+  static inline void Push(lua::State* state, int cache, int slot,
+                          const T& arg) {
+    lua_rawgeti(state, cache, slot);
+    if (lua::GetType(state, -1) == lua::LuaType::Table) {
+      lua::Type<T>::Refresh(state, lua::GetTop(state), arg);
+      return;
+    }
+    lua::PopAndIgnore(state, 1);
+    lua::Push(state, arg);
+    lua::RawSet(state, cache, slot, lua::ValueOnStack(state, -1));
+  }
+};
+
+// Calls the handler with |nargs| arguments on stack.
+template<typename ReturnType>
+struct SignalCall {
+  static ReturnType Call(lua::State* state, int nargs) {
+    ReturnType result = ReturnType();
+    if (lua_pcall(state, nargs, 1, 0) != LUA_OK) {
+      std::string error;
+      lua::Pop(state, &error);
+      LOG(ERROR) << "Error when calling lua function: " << error;
+    } else if (!lua::To(state, -1, &result) &&
+               lua::GetType(state, -1) != lua::LuaType::Nil) {
+      LOG(ERROR) << "Error converting return value from "
+                 << lua::GetTypeName(state, -1) << " to "
+                 << lua::Type<ReturnType>::name;
+    }
+    return result;
+  }
+};
+
+// Handlers without return values run in coroutines so they can yield.
+template<>
+struct SignalCall<void> {
+  static void Call(lua::State* state, int nargs) {
+    int top = lua::GetTop(state) - nargs - 1;
+    lua::State* thread = lua::PushIdleThread(state);
+    lua_insert(state, top + 1);
+    lua_xmove(state, thread, nargs + 1);
+    if (lua::Resume(thread, state, nargs) == LUA_OK)
+      lua::ReleaseIdleThread(state, top + 1);
+  }
+};
+
+}  // namespace internal
+
+// Creates the slot that calls a Lua handler when signal is emitted.
+//
+// Unlike the generic conversion of std::function, the arguments are pushed
+// with the specialized SignalArg, which caches the wrappers of objects and
+// reuses the event tables between emissions. So handlers should copy the
+// event if they want to keep it after returning.
+template<typename Sig>
+class SignalTrampoline;
+
+template<typename ReturnType, typename... ArgTypes>
+class SignalTrampoline<ReturnType(ArgTypes...)> {
+ public:
+  // Push a record of the |handler| and return the slot, the record must be
+  // referenced by the owner of signal, since the slot only keeps a weak
+  // reference to it.
+  static std::function<ReturnType(ArgTypes...)> Create(lua::State* state,
+                                                       int handler) {
+    handler = lua::AbsIndex(state, handler);
+    // record = {handler, setmetatable({}, {__mode = 'v'})}
+    lua::NewTable(state, 2, 0);
+    lua::RawSet(state, -1, 1, lua::ValueOnStack(state, handler));
+    lua::NewTable(state, sizeof...(ArgTypes), 0);
+    lua::NewTable(state, 0, 1);
+    lua::RawSet(state, -1, "__mode", "v");
+    lua::SetMetaTable(state, -2);
+    lua_rawseti(state, -2, 2);
+    std::shared_ptr<lua::Weak> record = lua::Weak::New(state, -1);
+    return [record](ArgTypes... args) -> ReturnType {
+      return Run(record.get(), args...);
+    };
+  }
+
+ private:
+  static ReturnType Run(lua::Weak* record, const ArgTypes&... args) {
+    lua::State* state = record->state();
+    lua::StackAutoReset reset(state);
+    record->Push();
+    if (lua::GetType(state, -1) != lua::LuaType::Table)
+      return ReturnType();
+    int cache = lua::GetTop(state) + 1;
+    lua_rawgeti(state, -1, 2);
+    lua_rawgeti(state, -2, 1);
+    PushArgs(state, cache, 1, args...);
+    return internal::SignalCall<ReturnType>::Call(state, sizeof...(ArgTypes));
+  }
+
+  static inline void PushArgs(lua::State* state, int cache, int slot) {}
+
+  template<typename T, typename... RestTypes>
+  static inline void PushArgs(lua::State* state, int cache, int slot,
+                              const T& arg, const RestTypes&... rest) {
+    internal::SignalArg<T>::Push(state, cache, slot, arg);
+    PushArgs(state, cache, slot + 1, rest...);
+  }
+};
+
 // A simple structure that records the signal pointer and owner reference.
 template<typename Sig>
 class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
@@ -23,20 +190,23 @@ class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
   int Connect(lua::CallContext* context) {
     if (!PushOwner(context))
       return -1;
-    // Must not reference signal handler in C++.
-    std::function<Sig> slot;
-    if (!lua::ToWeakFunction(context->state, 2, &slot)) {
+    if (lua::GetType(context->state, 2) != lua::LuaType::Function) {
       context->has_error = true;
       lua::PushFormatedString(
           context->state, "error converting arg at index %d from %s to %s",
           2, lua::GetTypeName(context->state, 2), "function");
       return -1;
     }
-    int id = signal_->Connect(slot);
-    // self.__yuesignals[signal][id] = slot
-    lua::PushRefsTable(context->state, "__yuesignals", -1);
+    // Must not reference signal handler in C++.
+    int owner = lua::GetTop(context->state);
+    int id = signal_->Connect(
+        SignalTrampoline<Sig>::Create(context->state, 2));
+    // self.__yuesignals[signal][id] = record
+    int record = lua::GetTop(context->state);
+    lua::PushRefsTable(context->state, "__yuesignals", owner);
     lua::RawGetOrCreateTable(context->state, -1, static_cast<void*>(signal_));
-    lua::RawSet(context->state, -1, id, lua::ValueOnStack(context->state, 2));
+    lua::RawSet(context->state, -1, id,
+                lua::ValueOnStack(context->state, record));
     return id;
   }
 
@@ -114,14 +284,12 @@ struct MemberTraits<nu::Signal<Sig>> {
     if (lua::GetType(state, value) != lua::LuaType::Function)
       return false;
     // Must not reference signal handler in C++.
-    std::function<Sig> slot;
-    if (!lua::ToWeakFunction(state, value, &slot))
-      return false;
-    int id = out->Connect(slot);
-    // self.__yuesignals[signal][id] = slot
+    int id = out->Connect(yue::SignalTrampoline<Sig>::Create(state, value));
+    // self.__yuesignals[signal][id] = record
+    int record = GetTop(state);
     lua::PushRefsTable(state, "__yuesignals", owner);
     lua::RawGetOrCreateTable(state, -1, static_cast<void*>(out));
-    lua::RawSet(state, -1, id, lua::ValueOnStack(state, value));
+    lua::RawSet(state, -1, id, lua::ValueOnStack(state, record));
     return true;
   }
 };
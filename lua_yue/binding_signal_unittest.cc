@@ -160,3 +160,88 @@ TEST_F(YueSignalTest, SignalCyclicReference) {
       "collectgarbage()\n"
       "assert(t.w == nil)\n"));
 }
+
+TEST_F(YueSignalTest, HandlerArguments) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "count = 0\n"
+      "item = require('yue.gui').MenuItem.create('label')\n"
+      "item.onclick:connect(function(self)\n"
+      "  assert(self == item)\n"
+      "  count = count + 1\n"
+      "end)\n"
+      "item:click()\n"
+      "collectgarbage()\n"
+      "item:click()"));
+  int count = 0;
+  lua_getglobal(state_, "count");
+  ASSERT_TRUE(lua::Pop(state_, &count));
+  EXPECT_EQ(count, 2);
+}
+
+TEST_F(YueSignalTest, DirtyRectIsNotReused) {
+  scoped_refptr<nu::Container> container(new nu::Container);
+  lua::Push(state_, container.get());
+  lua_setglobal(state_, "container");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "rects = {}\n"
+      "container.ondraw = function(self, painter, dirty)\n"
+      "  table.insert(rects, dirty)\n"
+      "end"));
+  nu::Canvas canvas(nu::SizeF(10, 10));
+  container->on_draw.Emit(container.get(), canvas.GetPainter(),
+                          nu::RectF(1, 2, 3, 4));
+  container->on_draw.Emit(container.get(), canvas.GetPainter(),
+                          nu::RectF(5, 6, 7, 8));
+  ASSERT_FALSE(luaL_dostring(state_,
+      "assert(rects[1] ~= rects[2])\n"
+      "assert(rects[1].x == 1 and rects[1].height == 4)\n"
+      "assert(rects[2].x == 5 and rects[2].height == 8)"));
+}
+
+TEST_F(YueSignalTest, HandlerCanYield) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "win.onclose:connect(function(self)\n"
+      "  co = coroutine.running()\n"
+      "  result = coroutine.yield()\n"
+      "end)\n"
+      "win:close()\n"
+      "coroutine.resume(co, 'resumed')"));
+  std::string result;
+  lua_getglobal(state_, "result");
+  ASSERT_TRUE(lua::Pop(state_, &result));
+  EXPECT_EQ(result, "resumed");
+  EXPECT_EQ(lua::GetTop(state_), 0);
+}
+
+TEST_F(YueSignalTest, HandlerRunsInCoroutine) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "win.onclose:connect(function(self)\n"
+      "  local co, main = coroutine.running()\n"
+      "  inmain = main\n"
+      "  yieldable = coroutine.isyieldable()\n"
+      "end)\n"
+      "win:close()"));
+  bool in_main = true;
+  bool yieldable = false;
+  lua_getglobal(state_, "inmain");
+  ASSERT_TRUE(lua::Pop(state_, &in_main));
+  lua_getglobal(state_, "yieldable");
+  ASSERT_TRUE(lua::Pop(state_, &yieldable));
+  EXPECT_FALSE(in_main);
+  EXPECT_TRUE(yieldable);
+}
+
+TEST_F(YueSignalTest, HandlerErrorIsPassedToErrorHandler) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "require('yue.util').seterrorhandler(function(message)\n"
+      "  caught = message\n"
+      "end)\n"
+      "win.onclose:connect(function(self)\n"
+      "  error('handler error')\n"
+      "end)\n"
+      "win:close()"));
+  std::string error;
+  lua_getglobal(state_, "caught");
+  ASSERT_TRUE(lua::Pop(state_, &error));
+  EXPECT_NE(error.find("handler error"), std::string::npos);
+}
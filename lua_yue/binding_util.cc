@@ -6,12 +6,14 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <numeric>
 #include <string>
 #include <vector>
 
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "nativeui/memory_dump.h"
 
 namespace {
 
@@ -144,11 +146,43 @@ int Print(lua::State* state) {
   return 0;
 }
 
+int SetErrorHandler(lua::State* state) {
+  if (!lua_isnoneornil(state, 1))
+    luaL_checktype(state, 1, LUA_TFUNCTION);
+  lua::SetTop(state, 1);
+  lua::SetErrorHandler(state, 1);
+  return 0;
+}
+
+int EnableMemoryTracking(lua::State* state) {
+  nu::EnableMemoryTracking();
+  return 0;
+}
+
+int GetMemoryUsage(lua::State* state) {
+  std::map<std::string, nu::MemoryUsage> usage = nu::GetMemoryUsage();
+  lua::NewTable(state, 0, static_cast<int>(usage.size()));
+  for (const auto& it : usage) {
+    lua::Push(state, it.first);
+    lua::NewTable(state, 0, 2);
+    lua::RawSet(state, -1,
+                "count", it.second.count,
+                "bytes", static_cast<double>(it.second.bytes));
+    lua_rawset(state, -3);
+  }
+  return 1;
+}
+
 }  // namespace
 
 extern "C" int luaopen_yue_util(lua::State* state) {
   lua::NewTable(state);
   lua::RawSet(state, -1, "inspect", lua::CFunction(&Inspect));
   lua::RawSet(state, -1, "print", lua::CFunction(&Print));
+  lua::RawSet(state, -1,
+              "seterrorhandler", lua::CFunction(&SetErrorHandler));
+  lua::RawSet(state, -1,
+              "enablememorytracking", lua::CFunction(&EnableMemoryTracking),
+              "getmemoryusage", lua::CFunction(&GetMemoryUsage));
   return 1;
 }
@@ -0,0 +1,61 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/binding_worker.h"
+
+#include <string>
+
+#include "lua_yue/binding_signal.h"
+#include "lua_yue/worker.h"
+
+namespace lua {
+
+template<>
+struct Type<yue::Worker::Message> {
+  static constexpr const char* name = "yue.Worker.Message";
+  static inline void Push(State* state, const yue::Worker::Message& message) {
+    yue::PushMessage(state, message);
+  }
+  static inline bool To(State* state, int index,
+                        yue::Worker::Message* out) {
+    return yue::ToMessage(state, index, out);
+  }
+};
+
+template<>
+struct Type<yue::Worker> {
+  static constexpr const char* name = "yue.Worker";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "postmessage", &yue::Worker::PostMessage,
+           "terminate", &yue::Worker::Terminate,
+           "isrunning", &yue::Worker::IsRunning);
+    RawSetProperty(state, metatable,
+                   "onmessage", &yue::Worker::on_message,
+                   "onerror", &yue::Worker::on_error);
+  }
+  // Messages of a worker are delivered on the GUI thread, so workers can not
+  // be created inside workers.
+  static yue::Worker* Create(CallContext* context, const std::string& path) {
+    if (yue::IsInWorker(context->state)) {
+      context->has_error = true;
+      Push(context->state, "Workers can not be created inside workers");
+      return nullptr;
+    }
+    return new yue::Worker(path);
+  }
+};
+
+}  // namespace lua
+
+extern "C" int luaopen_yue_worker(lua::State* state) {
+  lua::NewTable(state);
+  lua::RawSet(state, -1, "Worker", lua::MetaTable<yue::Worker>());
+  // Scripts running in worker can talk to the parent.
+  lua::Push(state, "parent");
+  yue::PushWorkerParent(state);
+  lua_rawset(state, -3);
+  return 1;
+}
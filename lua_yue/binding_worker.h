@@ -0,0 +1,12 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef LUA_YUE_BINDING_WORKER_H_
+#define LUA_YUE_BINDING_WORKER_H_
+
+#include "lua/lua.h"
+
+extern "C" int luaopen_yue_worker(lua::State* state);
+
+#endif  // LUA_YUE_BINDING_WORKER_H_
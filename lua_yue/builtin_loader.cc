@@ -11,6 +11,7 @@
 #include "lua_yue/binding_gui.h"
 #include "lua_yue/binding_sys.h"
 #include "lua_yue/binding_util.h"
+#include "lua_yue/binding_worker.h"
 
 namespace yue {
 
@@ -21,6 +22,7 @@ std::pair<const char*, lua_CFunction> kLoadersMap[] = {
   std::make_pair("yue.gui", luaopen_yue_gui),
   std::make_pair("yue.sys", luaopen_yue_sys),
   std::make_pair("yue.util", luaopen_yue_util),
+  std::make_pair("yue.worker", luaopen_yue_worker),
 };
 
 // Compare function to compare elements.
@@ -41,6 +43,14 @@ int SearchBuiltin(lua::State* state) {
       << "The builtin loaders map must be in sorted order";
   std::string name;
   lua::To(state, 1, &name);
+  // The upvalue indicates whether we are in a worker.
+  bool in_worker = false;
+  lua::To(state, lua_upvalueindex(1), &in_worker);
+  if (in_worker && name == "yue.gui") {
+    lua::PushFormatedString(state, "\n\tbuiltin '%s' is not available in "
+                                   "workers", name.c_str());
+    return 1;
+  }
   auto* iter = std::lower_bound(std::begin(kLoadersMap), std::end(kLoadersMap),
                                 name, TupleCompare);
   if (iter == std::end(kLoadersMap) || name != iter->first) {
@@ -54,7 +64,7 @@ int SearchBuiltin(lua::State* state) {
 
 }  // namespace
 
-void InsertBuiltinModuleLoader(lua::State* state) {
+void InsertBuiltinModuleLoader(lua::State* state, bool in_worker) {
   lua::StackAutoReset reset(state);
   lua_getglobal(state, "package");
   DCHECK_EQ(lua::GetType(state, -1), lua::LuaType::Table)
@@ -70,7 +80,9 @@ void InsertBuiltinModuleLoader(lua::State* state) {
     lua::RawGet(state, -1, i);
     lua_rawseti(state, -2, i + 1);
   }
-  lua::RawSet(state, -1, 2, lua::CFunction(&SearchBuiltin));
+  lua::Push(state, in_worker);
+  lua_pushcclosure(state, &SearchBuiltin, 1);
+  lua_rawseti(state, -2, 2);
 }
 
 }  // namespace yue
@@ -10,7 +10,10 @@
 namespace yue {
 
 // Add a function to package.searchers to load builtin modules of yue.
-void InsertBuiltinModuleLoader(lua::State* state);
+//
+// The GUI module can not be loaded when |in_worker| is true, since workers
+// run on background threads.
+void InsertBuiltinModuleLoader(lua::State* state, bool in_worker = false);
 
 }  // namespace yue
 
@@ -0,0 +1,233 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/worker.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "lua_yue/binding_values.h"
+#include "lua_yue/builtin_loader.h"
+#include "nativeui/message_loop.h"
+
+namespace yue {
+
+namespace {
+
+// Keys in the registry of worker state.
+const char kCoreKey[] = "yue.worker.core";
+const char kParentKey[] = "yue.worker.parent";
+
+// How many instructions are run between checks of termination.
+const int kTerminationCheckInterval = 1000;
+
+}  // namespace
+
+// The data shared between GUI thread and worker thread.
+class Worker::Core : public base::RefCountedThreadSafe<Core> {
+ public:
+  explicit Core(Worker* worker) : worker_(worker) {}
+
+  // Called on GUI thread when the worker is going away.
+  void Detach() {
+    worker_ = nullptr;
+    terminated_ = true;
+  }
+
+  // Called on worker thread.
+  void Start(const std::string& path) {
+    state_.reset(new lua::ManagedState);
+    lua::State* state = *state_;
+    luaL_openlibs(state);
+    InsertBuiltinModuleLoader(state, true /* in_worker */);
+    // registry[kCoreKey] = this
+    lua_pushlightuserdata(state, this);
+    lua_setfield(state, LUA_REGISTRYINDEX, kCoreKey);
+    // registry[kParentKey] = {postmessage = PostMessageToParent}
+    lua::NewTable(state, 0, 2);
+    lua::RawSet(state, -1, "postmessage", lua::CFunction(&PostMessageToParent));
+    lua_setfield(state, LUA_REGISTRYINDEX, kParentKey);
+    // Allow interrupting long running scripts.
+    lua_sethook(state, &CheckTermination, LUA_MASKCOUNT,
+                kTerminationCheckInterval);
+    if (luaL_loadfile(state, path.c_str()) != LUA_OK ||
+        !lua::PCall(state, nullptr))
+      ReportError(state);
+  }
+
+  void Stop() {
+    state_.reset();
+  }
+
+  void DeliverToWorker(Message message) {
+    if (!state_ || terminated_)
+      return;
+    lua::State* state = *state_;
+    lua::StackAutoReset reset(state);
+    lua_getfield(state, LUA_REGISTRYINDEX, kParentKey);
+    lua::RawGet(state, -1, "onmessage");
+    if (lua::GetType(state, -1) != lua::LuaType::Function)
+      return;
+    PushMessage(state, message);
+    if (lua_pcall(state, 1, 0, 0) != LUA_OK)
+      ReportError(state);
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Core>;
+
+  ~Core() {}
+
+  static Core* FromState(lua::State* state) {
+    lua_getfield(state, LUA_REGISTRYINDEX, kCoreKey);
+    auto* core = static_cast<Core*>(lua_touserdata(state, -1));
+    lua::PopAndIgnore(state, 1);
+    return core;
+  }
+
+  // parent.postmessage(message)
+  static int PostMessageToParent(lua::State* state) {
+    {
+      Message message;
+      if (ToMessage(state, 1, &message)) {
+        FromState(state)->PostToParent(std::move(message));
+        return 0;
+      }
+    }
+    lua::PushFormatedString(
+        state, "error converting arg at index 1 from %s to message",
+        lua::GetTypeName(state, 1));
+    return lua_error(state);
+  }
+
+  static void CheckTermination(lua::State* state, lua_Debug* ar) {
+    if (FromState(state)->terminated_)
+      luaL_error(state, "worker has been terminated");
+  }
+
+  // Called on worker thread.
+  void PostToParent(Message message) {
+    scoped_refptr<Core> self(this);
+    // The task must be copyable.
+    auto shared = std::make_shared<Message>(std::move(message));
+    nu::MessageLoop::PostTask([self, shared]() {
+      scoped_refptr<Worker> worker(self->worker_);
+      if (worker)
+        worker->on_message.Emit(worker.get(), *shared);
+    });
+  }
+
+  void ReportError(lua::State* state) {
+    std::string error;
+    if (!lua::Pop(state, &error))
+      error = "unknown error";
+    scoped_refptr<Core> self(this);
+    nu::MessageLoop::PostTask([self, error]() {
+      scoped_refptr<Worker> worker(self->worker_);
+      if (worker)
+        worker->on_error.Emit(worker.get(), error);
+    });
+  }
+
+  // Only accessed on GUI thread.
+  Worker* worker_;
+  // Read on worker thread to interrupt scripts.
+  std::atomic<bool> terminated_{false};
+  // Only accessed on worker thread.
+  std::unique_ptr<lua::ManagedState> state_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+Worker::Message::Message() = default;
+
+Worker::Message::Message(base::Value value) : value(std::move(value)) {}
+
+Worker::Message::Message(nu::Buffer buffer)
+    : is_buffer(true), buffer(std::move(buffer)) {}
+
+Worker::Message::Message(Message&& other) = default;
+
+Worker::Message::~Message() = default;
+
+Worker::Message& Worker::Message::operator=(Message&& other) = default;
+
+Worker::Worker(const std::string& path)
+    : core_(new Core(this)), thread_("LuaWorker") {
+  thread_.Start();
+  thread_.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&Core::Start, core_, path));
+}
+
+Worker::~Worker() {
+  Terminate();
+}
+
+void Worker::PostMessage(Message message) {
+  if (!thread_.IsRunning())
+    return;
+  thread_.task_runner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Core::DeliverToWorker, core_, std::move(message)));
+}
+
+void Worker::Terminate() {
+  if (!thread_.IsRunning())
+    return;
+  core_->Detach();
+  thread_.task_runner()->PostTask(FROM_HERE,
+                                  base::BindOnce(&Core::Stop, core_));
+  // Wait until the lua state is closed.
+  thread_.Stop();
+}
+
+bool Worker::IsRunning() const {
+  return thread_.IsRunning();
+}
+
+void PushMessage(lua::State* state, const Worker::Message& message) {
+  if (message.is_buffer) {
+    lua_pushlstring(state, static_cast<const char*>(message.buffer.content()),
+                    message.buffer.size());
+  } else {
+    lua::Push(state, message.value);
+  }
+}
+
+bool ToMessage(lua::State* state, int index, Worker::Message* out) {
+  if (lua::GetType(state, index) == lua::LuaType::String) {
+    // Strings are owned by the lua state, so copy once and then move the
+    // buffer to the other thread without converting to base::Value.
+    size_t size = 0;
+    const char* str = lua_tolstring(state, index, &size);
+    void* content = malloc(size);
+    memcpy(content, str, size);
+    *out = Worker::Message(nu::Buffer::TakeOver(content, size, free));
+    return true;
+  }
+  base::Value value;
+  if (!lua::To(state, index, &value))
+    return false;
+  *out = Worker::Message(std::move(value));
+  return true;
+}
+
+void PushWorkerParent(lua::State* state) {
+  lua_getfield(state, LUA_REGISTRYINDEX, kParentKey);
+}
+
+bool IsInWorker(lua::State* state) {
+  lua_getfield(state, LUA_REGISTRYINDEX, kCoreKey);
+  bool in_worker = lua::GetType(state, -1) != lua::LuaType::Nil;
+  lua::PopAndIgnore(state, 1);
+  return in_worker;
+}
+
+}  // namespace yue
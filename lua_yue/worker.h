@@ -0,0 +1,87 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef LUA_YUE_WORKER_H_
+#define LUA_YUE_WORKER_H_
+
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/threading/thread.h"
+#include "base/values.h"
+#include "lua/lua.h"
+#include "nativeui/buffer.h"
+#include "nativeui/signal.h"
+
+namespace yue {
+
+// Runs a script in an isolated lua state on a background thread.
+//
+// The worker state can only load non-GUI builtin modules and can not create
+// other workers, and it talks with the GUI thread by passing messages.
+// Messages from the worker are delivered on the GUI thread with
+// nu::MessageLoop::PostTask.
+class Worker : public base::RefCounted<Worker> {
+ public:
+  // A message is either a base::Value, or a buffer that is moved to the
+  // other thread without being converted to base::Value.
+  struct Message {
+    Message();
+    explicit Message(base::Value value);
+    explicit Message(nu::Buffer buffer);
+    Message(Message&& other);
+    ~Message();
+
+    Message& operator=(Message&& other);
+
+    bool is_buffer = false;
+    base::Value value;
+    nu::Buffer buffer;
+
+    DISALLOW_COPY_AND_ASSIGN(Message);
+  };
+
+  // Start running the script at |path|.
+  explicit Worker(const std::string& path);
+
+  // Send |message| to the worker, it is dropped if the worker has terminated.
+  void PostMessage(Message message);
+
+  // Stop the worker and wait for the worker thread to exit. The running script
+  // is interrupted between Lua instructions, so a script blocked inside a C
+  // function blocks the caller until the function returns.
+  void Terminate();
+  bool IsRunning() const;
+
+  // Events.
+  nu::Signal<void(Worker*, const Message&)> on_message;
+  nu::Signal<void(Worker*, const std::string&)> on_error;
+
+ private:
+  friend class base::RefCounted<Worker>;
+
+  class Core;
+
+  ~Worker();
+
+  scoped_refptr<Core> core_;
+  base::Thread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+// Push |message| to lua, strings are stored as buffers.
+void PushMessage(lua::State* state, const Worker::Message& message);
+bool ToMessage(lua::State* state, int index, Worker::Message* out);
+
+// Return the table of the parent for scripts running in worker, or push nil
+// when not in a worker.
+void PushWorkerParent(lua::State* state);
+
+// Return whether |state| is the state of a worker.
+bool IsInWorker(lua::State* state);
+
+}  // namespace yue
+
+#endif  // LUA_YUE_WORKER_H_
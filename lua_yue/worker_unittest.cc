@@ -0,0 +1,117 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "lua_yue/builtin_loader.h"
+#include "lua_yue/worker.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Start a worker running |code|, post |message| to it and return the first
+// message or error received from it.
+std::string RunWorker(const std::string& code, const std::string& message) {
+  base::ScopedTempDir dir;
+  if (!dir.CreateUniqueTempDir())
+    return "failed to create temp dir";
+  base::FilePath path = dir.GetPath().Append(FILE_PATH_LITERAL("worker.lua"));
+  if (base::WriteFile(path, code.data(), code.size()) !=
+      static_cast<int>(code.size()))
+    return "failed to write script";
+
+  std::string reply = "timeout";
+  scoped_refptr<yue::Worker> worker(new yue::Worker(path.AsUTF8Unsafe()));
+  worker->on_message.Connect([&reply](yue::Worker*,
+                                      const yue::Worker::Message& message) {
+    if (message.is_buffer)
+      reply.assign(static_cast<const char*>(message.buffer.content()),
+                   message.buffer.size());
+    nu::MessageLoop::Quit();
+  });
+  worker->on_error.Connect([&reply](yue::Worker*, const std::string& error) {
+    reply = "error: " + error;
+    nu::MessageLoop::Quit();
+  });
+  worker->PostMessage(yue::Worker::Message(base::Value(message)));
+  bool timed_out = false;
+  auto timeout = nu::MessageLoop::SetTimeout(10 * 1000, [&timed_out]() {
+    timed_out = true;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  if (!timed_out)
+    nu::MessageLoop::ClearTimeout(timeout);
+  worker->Terminate();
+  return reply;
+}
+
+}  // namespace
+
+class YueWorkerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+  }
+
+  lua::ManagedState state_;
+};
+
+TEST_F(YueWorkerTest, StringMessageIsBuffer) {
+  lua::Push(state_, std::string("con\0tent", 8));
+  yue::Worker::Message message;
+  ASSERT_TRUE(yue::ToMessage(state_, 1, &message));
+  ASSERT_TRUE(message.is_buffer);
+  ASSERT_EQ(message.buffer.size(), 8u);
+  yue::PushMessage(state_, message);
+  std::string out;
+  ASSERT_TRUE(lua::Pop(state_, &out));
+  EXPECT_EQ(out, std::string("con\0tent", 8));
+}
+
+TEST_F(YueWorkerTest, ValueMessage) {
+  ASSERT_FALSE(luaL_dostring(state_, "return {a = 1, b = {true, 'c'}}"));
+  yue::Worker::Message message;
+  ASSERT_TRUE(yue::ToMessage(state_, -1, &message));
+  ASSERT_FALSE(message.is_buffer);
+  EXPECT_TRUE(message.value.is_dict());
+  yue::Worker::Message moved(std::move(message));
+  EXPECT_TRUE(moved.value.FindKey("b")->is_list());
+}
+
+TEST_F(YueWorkerTest, NoGuiInWorker) {
+  yue::InsertBuiltinModuleLoader(state_, true /* in_worker */);
+  EXPECT_TRUE(luaL_dostring(state_, "require('yue.gui')"));
+  lua::SetTop(state_, 0);
+  EXPECT_FALSE(luaL_dostring(state_, "require('yue.util')"));
+  EXPECT_FALSE(luaL_dostring(state_,
+                             "assert(require('yue.worker').parent == nil)"));
+}
+
+TEST_F(YueWorkerTest, PostMessageAndReply) {
+  nu::Lifetime lifetime;
+  nu::State state;
+  EXPECT_EQ(RunWorker("local parent = require('yue.worker').parent\n"
+                      "function parent.onmessage(message)\n"
+                      "  parent.postmessage(message .. ' pong')\n"
+                      "end\n",
+                      "ping"),
+            "ping pong");
+}
+
+TEST_F(YueWorkerTest, NoNestedWorker) {
+  nu::Lifetime lifetime;
+  nu::State state;
+  EXPECT_EQ(RunWorker("local worker = require('yue.worker')\n"
+                      "function worker.parent.onmessage(message)\n"
+                      "  local ok = pcall(worker.Worker.create, message)\n"
+                      "  worker.parent.postmessage(tostring(ok))\n"
+                      "end\n",
+                      "nested.lua"),
+            "false");
+}
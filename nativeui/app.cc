@@ -8,6 +8,10 @@
 #include "nativeui/menu_bar.h"
 #include "nativeui/state.h"
 
+#if defined(OS_LINUX)
+#include "base/threading/thread.h"
+#endif
+
 namespace nu {
 
 // static
@@ -19,6 +23,9 @@ App::App() : weak_factory_(this) {
 }
 
 App::~App() {
+#if defined(OS_LINUX)
+  WaitForFontWarmup();
+#endif
   // The GUI members must be destroyed before we shutdown GUI engine.
   default_font_ = nullptr;
 }
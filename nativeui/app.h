@@ -5,12 +5,17 @@
 #ifndef NATIVEUI_APP_H_
 #define NATIVEUI_APP_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 #include "base/memory/weak_ptr.h"
 #include "nativeui/gfx/color.h"
 
+namespace base {
+class Thread;
+}
+
 namespace nu {
 
 class Font;
@@ -33,6 +38,15 @@ class NATIVEUI_EXPORT App {
   // Return the default GUI font.
   Font* GetDefaultFont();
 
+#if defined(OS_LINUX)
+  // Initialize fontconfig and load the default font on a background thread,
+  // should be called at startup before creating any window.
+  void WarmupFonts();
+
+  // Internal: Block until the fonts warmup finishes.
+  void WaitForFontWarmup();
+#endif
+
 #if defined(OS_MACOSX)
   // Set the application menu.
   void SetApplicationMenu(MenuBar* menu);
@@ -63,6 +77,10 @@ class NATIVEUI_EXPORT App {
   scoped_refptr<MenuBar> application_menu_;
 #endif
 
+#if defined(OS_LINUX)
+  std::unique_ptr<base::Thread> font_warmup_thread_;
+#endif
+
   base::WeakPtrFactory<App> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(App);
@@ -103,6 +103,22 @@ bool AsarArchive::GetFileInfo(const std::string& path, FileInfo* info) {
   return true;
 }
 
+const uint8_t* AsarArchive::GetMappedContent(const FileInfo& info) {
+  if (!IsValid())
+    return nullptr;
+  if (!mapped_file_) {
+    std::unique_ptr<base::MemoryMappedFile> mapped_file(
+        new base::MemoryMappedFile);
+    if (!mapped_file->Initialize(file_.Duplicate()))
+      return nullptr;
+    mapped_file_ = std::move(mapped_file);
+  }
+  if (info.offset > mapped_file_->length() ||
+      info.size > mapped_file_->length() - info.offset)
+    return nullptr;
+  return mapped_file_->data() + info.offset;
+}
+
 bool AsarArchive::ReadExtendedMeta() {
   // Read last 13 bytes, which are | size(8) | version(1) | magic(4) |.
   char magic[5] = { 0 };
@@ -5,9 +5,11 @@
 #ifndef NATIVEUI_ASAR_ARCHIVE_H_
 #define NATIVEUI_ASAR_ARCHIVE_H_
 
+#include <memory>
 #include <string>
 
 #include "base/files/file.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/values.h"
 #include "nativeui/nativeui_export.h"
 
@@ -26,12 +28,17 @@ class NATIVEUI_EXPORT AsarArchive {
   bool IsValid() const;
   bool GetFileInfo(const std::string& path, FileInfo* info);
 
+  // Return the content of the file described by |info| without copying, the
+  // archive is memory mapped on first call. Return null on failure.
+  const uint8_t* GetMappedContent(const FileInfo& info);
+
  private:
   bool ReadExtendedMeta();
 
   base::File file_;
   base::Value header_;
   uint64_t content_offset_ = 0;
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
 };
 
 }  // namespace nu
@@ -0,0 +1,118 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kDirCount = 20;
+const int kFilesPerDir = 50;
+const int kFileSize = 1024;
+const int kLargeFileSize = 8 * 1024 * 1024;
+
+// Write an asar archive with |kDirCount| * |kFilesPerDir| small files and one
+// large file.
+bool WriteArchive(const base::FilePath& path, std::vector<std::string>* files) {
+  base::Value root(base::Value::Type::DICTIONARY);
+  base::Value root_files(base::Value::Type::DICTIONARY);
+  uint64_t offset = 0;
+  for (int i = 0; i < kDirCount; ++i) {
+    base::Value dir_files(base::Value::Type::DICTIONARY);
+    for (int j = 0; j < kFilesPerDir; ++j) {
+      base::Value file(base::Value::Type::DICTIONARY);
+      file.SetKey("size", base::Value(kFileSize));
+      file.SetKey("offset", base::Value(base::NumberToString(offset)));
+      offset += kFileSize;
+      std::string name = "file" + base::IntToString(j) + ".txt";
+      dir_files.SetKey(name, std::move(file));
+      files->push_back("dir" + base::IntToString(i) + "/" + name);
+    }
+    base::Value dir(base::Value::Type::DICTIONARY);
+    dir.SetKey("files", std::move(dir_files));
+    root_files.SetKey("dir" + base::IntToString(i), std::move(dir));
+  }
+  base::Value large(base::Value::Type::DICTIONARY);
+  large.SetKey("size", base::Value(kLargeFileSize));
+  large.SetKey("offset", base::Value(base::NumberToString(offset)));
+  root_files.SetKey("large.bin", std::move(large));
+  root.SetKey("files", std::move(root_files));
+
+  std::string json;
+  if (!base::JSONWriter::Write(root, &json))
+    return false;
+  base::Pickle header;
+  header.WriteString(json);
+  base::Pickle size;
+  size.WriteUInt32(static_cast<uint32_t>(header.size()));
+
+  std::string content(static_cast<const char*>(size.data()), size.size());
+  content.append(static_cast<const char*>(header.data()), header.size());
+  content.append(offset + kLargeFileSize, 'a');
+  return base::WriteFile(path, content.data(), content.size()) ==
+         static_cast<int>(content.size());
+}
+
+}  // namespace
+
+class AsarArchivePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().Append(FILE_PATH_LITERAL("perf.asar"));
+    ASSERT_TRUE(WriteArchive(path_, &files_));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  std::vector<std::string> files_;
+};
+
+TEST_F(AsarArchivePerfTest, GetFileInfo) {
+  nu::AsarArchive archive(
+      base::File(path_, base::File::FLAG_OPEN | base::File::FLAG_READ), false);
+  ASSERT_TRUE(archive.IsValid());
+  nu::RunPerfTest("AsarArchive.GetFileInfo.1000",
+                  static_cast<int>(files_.size()), [&]() {
+    nu::AsarArchive::FileInfo info;
+    for (const std::string& file : files_)
+      ASSERT_TRUE(archive.GetFileInfo(file, &info));
+  });
+}
+
+TEST_F(AsarArchivePerfTest, Open) {
+  nu::RunPerfTest("AsarArchive.Open", 1, [&]() {
+    nu::AsarArchive archive(
+        base::File(path_, base::File::FLAG_OPEN | base::File::FLAG_READ),
+        false);
+    ASSERT_TRUE(archive.IsValid());
+  });
+}
+
+// The items are measured in KB.
+TEST_F(AsarArchivePerfTest, ProtocolAsarJobRead) {
+  std::vector<char> buffer(64 * 1024);
+  nu::RunPerfTest("ProtocolAsarJob.Read.8MB", kLargeFileSize / 1024, [&]() {
+    scoped_refptr<nu::ProtocolJob> job(
+        new nu::ProtocolAsarJob(path_, "large.bin"));
+    job->Plug([](int) {});
+    ASSERT_TRUE(job->Start());
+    size_t total = 0;
+    size_t nread;
+    while ((nread = job->Read(buffer.data(), buffer.size())) > 0)
+      total += nread;
+    EXPECT_EQ(total, static_cast<size_t>(kLargeFileSize));
+  });
+}
@@ -8,6 +8,8 @@
 #include <limits>
 
 #include "base/logging.h"
+#include "nativeui/events/event.h"
+#include "nativeui/gfx/painter.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
@@ -38,6 +40,8 @@ Container::Container(const char* an_empty_constructor) {
 }
 
 Container::~Container() {
+  for (const auto& item : items_)
+    item->container_ = nullptr;
   PlatformDestroy();
 }
 
@@ -78,6 +82,11 @@ void Container::OnSizeChanged() {
     SetChildBoundsFromCSS();
 }
 
+size_t Container::EstimateMemoryUsage() const {
+  return sizeof(Container) + children_.capacity() * sizeof(children_[0]) +
+         items_.size() * sizeof(SceneItem);
+}
+
 SizeF Container::GetPreferredSize() const {
   float nan = std::numeric_limits<float>::quiet_NaN();
   YGNodeCalculateLayout(node(), nan, nan, YGDirectionLTR);
@@ -140,6 +149,182 @@ void Container::RemoveChildView(View* view) {
   Layout();
 }
 
+void Container::AddItem(SceneItem* item) {
+  DCHECK(item);
+  if (item->container_) {
+    LOG(ERROR) << "The item already belongs to a container.";
+    return;
+  }
+  item->container_ = this;
+  item->order_ = items_.size();
+  items_.push_back(item);
+  // Adding many items before using the index results in a better packed tree
+  // when building it at once.
+  if (items_index_.empty())
+    items_index_dirty_ = true;
+  else if (!items_index_dirty_)
+    items_index_.Insert(item->order_, item->GetBounds());
+  item->SchedulePaint();
+}
+
+void Container::RemoveItem(SceneItem* item) {
+  if (!item || item->container_ != this)
+    return;
+  item->SchedulePaint();
+  item->container_ = nullptr;
+  if (hovered_item_ == item)
+    hovered_item_ = nullptr;
+  if (pressed_item_ == item)
+    pressed_item_ = nullptr;
+  items_.erase(items_.begin() + item->order_);
+  for (size_t i = item->order_; i < items_.size(); ++i)
+    items_[i]->order_ = i;
+  items_index_dirty_ = true;
+}
+
+void Container::RemoveAllItems() {
+  for (const auto& item : items_) {
+    item->SchedulePaint();
+    item->container_ = nullptr;
+  }
+  items_.clear();
+  items_index_.Clear();
+  items_index_dirty_ = false;
+  hovered_item_ = nullptr;
+  pressed_item_ = nullptr;
+}
+
+void Container::OnItemBoundsChanged(SceneItem* item,
+                                    const RectF& old_bounds) {
+  if (items_index_dirty_)
+    return;
+  items_index_.Remove(item->order_, old_bounds);
+  items_index_.Insert(item->order_, item->GetBounds());
+}
+
+SceneItem* Container::GetItemAt(const PointF& point) {
+  if (items_.empty())
+    return nullptr;
+  if (items_index_dirty_)
+    UpdateItemsIndex();
+  std::vector<size_t> found;
+  items_index_.SearchPoint(point, &found);
+  SceneItem* result = nullptr;
+  for (size_t i : found) {
+    SceneItem* item = items_[i].get();
+    if (!item->IsVisible() || !item->GetBounds().Contains(point))
+      continue;
+    if (!result || IsItemAbove(item, result))
+      result = item;
+  }
+  return result;
+}
+
+std::vector<SceneItem*> Container::GetItemsInRect(const RectF& rect) {
+  std::vector<SceneItem*> result;
+  if (items_.empty())
+    return result;
+  if (items_index_dirty_)
+    UpdateItemsIndex();
+  std::vector<size_t> found;
+  items_index_.Search(rect, &found);
+  result.reserve(found.size());
+  for (size_t i : found) {
+    if (items_[i]->IsVisible())
+      result.push_back(items_[i].get());
+  }
+  std::sort(result.begin(), result.end(),
+            [](SceneItem* a, SceneItem* b) { return IsItemAbove(b, a); });
+  return result;
+}
+
+void Container::DrawItems(Painter* painter, const RectF& dirty) {
+  for (SceneItem* item : GetItemsInRect(dirty)) {
+    if (item->on_draw.IsEmpty())
+      continue;
+    RectF bounds = item->GetBounds();
+    RectF item_dirty(dirty);
+    item_dirty.Intersect(bounds);
+    item_dirty.Offset(-bounds.OffsetFromOrigin());
+    painter->Save();
+    painter->ClipRect(bounds);
+    painter->Translate(bounds.OffsetFromOrigin());
+    item->on_draw.Emit(item, painter, item_dirty);
+    painter->Restore();
+  }
+}
+
+bool Container::DispatchMouseEventToItems(const MouseEvent& event) {
+  if (items_.empty() && !hovered_item_)
+    return false;
+
+  if (event.type == EventType::MouseLeave) {
+    UpdateHoveredItem(nullptr, event);
+    return false;
+  }
+  SceneItem* hit = GetItemAt(event.position_in_view);
+  if (event.type == EventType::MouseEnter ||
+      event.type == EventType::MouseMove)
+    UpdateHoveredItem(hit, event);
+
+  // The item that received mouse down receives following events until mouse
+  // up, like an implicit capture.
+  scoped_refptr<SceneItem> target(pressed_item_ ? pressed_item_.get() : hit);
+  if (!target)
+    return false;
+  MouseEvent item_event(event);
+  item_event.position_in_view -= target->GetBounds().OffsetFromOrigin();
+  switch (event.type) {
+    case EventType::MouseDown:
+      pressed_item_ = target;
+      return target->on_mouse_down.Emit(target.get(), item_event);
+    case EventType::MouseUp:
+      pressed_item_ = nullptr;
+      return target->on_mouse_up.Emit(target.get(), item_event);
+    case EventType::MouseMove:
+      target->on_mouse_move.Emit(target.get(), item_event);
+      return false;
+    default:
+      return false;
+  }
+}
+
+// static
+bool Container::IsItemAbove(SceneItem* a, SceneItem* b) {
+  if (a->GetZIndex() != b->GetZIndex())
+    return a->GetZIndex() > b->GetZIndex();
+  return a->order_ > b->order_;
+}
+
+void Container::UpdateItemsIndex() {
+  std::vector<RectF> bounds;
+  bounds.reserve(items_.size());
+  for (const auto& item : items_)
+    bounds.push_back(item->GetBounds());
+  items_index_.Build(bounds);
+  items_index_dirty_ = false;
+}
+
+void Container::UpdateHoveredItem(SceneItem* item, const MouseEvent& event) {
+  if (hovered_item_ == item)
+    return;
+  MouseEvent crossing(event);
+  if (hovered_item_) {
+    crossing.type = EventType::MouseLeave;
+    crossing.position_in_view =
+        event.position_in_view - hovered_item_->GetBounds().OffsetFromOrigin();
+    scoped_refptr<SceneItem> old_item(hovered_item_);
+    old_item->on_mouse_leave.Emit(old_item.get(), crossing);
+  }
+  hovered_item_ = item;
+  if (item) {
+    crossing.type = EventType::MouseEnter;
+    crossing.position_in_view =
+        event.position_in_view - item->GetBounds().OffsetFromOrigin();
+    item->on_mouse_enter.Emit(item, crossing);
+  }
+}
+
 void Container::SetChildBoundsFromCSS() {
   dirty_ = false;
   if (!IsVisible())
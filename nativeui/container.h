@@ -7,6 +7,8 @@
 
 #include <vector>
 
+#include "nativeui/scene_item.h"
+#include "nativeui/util/r_tree.h"
 #include "nativeui/view.h"
 
 namespace nu {
@@ -25,6 +27,7 @@ class NATIVEUI_EXPORT Container : public View {
   void Layout() override;
   bool IsContainer() const override;
   void OnSizeChanged() override;
+  size_t EstimateMemoryUsage() const override;
 
   // Gets preferred size of view.
   SizeF GetPreferredSize() const;
@@ -46,9 +49,39 @@ class NATIVEUI_EXPORT Container : public View {
     return children_[index].get();
   }
 
+  // Add/Remove lightweight items, which are drawn above the content of
+  // on_draw and below the child views.
+  void AddItem(SceneItem* item);
+  void RemoveItem(SceneItem* item);
+  void RemoveAllItems();
+
+  // Get items.
+  int ItemCount() const { return static_cast<int>(items_.size()); }
+  SceneItem* ItemAt(int index) const {
+    if (index < 0 || index >= ItemCount())
+      return nullptr;
+    return items_[index].get();
+  }
+
+  // Return the topmost visible item at |point|.
+  SceneItem* GetItemAt(const PointF& point);
+
+  // Return the visible items intersecting |rect|, in painting order.
+  std::vector<SceneItem*> GetItemsInRect(const RectF& rect);
+
   // Internal: Used by certain implementations to refresh layout.
   void SetChildBoundsFromCSS();
 
+  // Internal: Paint the items intersecting |dirty|.
+  void DrawItems(Painter* painter, const RectF& dirty);
+
+  // Internal: Dispatch mouse event to items, return true if the event is
+  // handled.
+  bool DispatchMouseEventToItems(const MouseEvent& event);
+
+  // Internal: Called by items when their bounds change.
+  void OnItemBoundsChanged(SceneItem* item, const RectF& old_bounds);
+
   // Events.
   Signal<void(Container*, Painter*, const RectF&)> on_draw;
 
@@ -64,9 +97,25 @@ class NATIVEUI_EXPORT Container : public View {
   void PlatformRemoveChildView(View* view);
 
  private:
+  // Whether |a| is painted above |b|.
+  static bool IsItemAbove(SceneItem* a, SceneItem* b);
+
+  void UpdateItemsIndex();
+  void UpdateHoveredItem(SceneItem* item, const MouseEvent& event);
+
   // Relationships.
   std::vector<scoped_refptr<View>> children_;
 
+  // Items and their spatial index. The index is built lazily after items are
+  // added or removed, and updated in place when an item moves.
+  std::vector<scoped_refptr<SceneItem>> items_;
+  RTree items_index_;
+  bool items_index_dirty_ = false;
+
+  // The item under mouse, and the item that received mouse down.
+  scoped_refptr<SceneItem> hovered_item_;
+  scoped_refptr<SceneItem> pressed_item_;
+
   // Whether the container should update children's layout.
   bool dirty_ = false;
 };
@@ -0,0 +1,127 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/attributed_text.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace nu {
+
+AttributedText::Style::Style(int start, int end, Font* font)
+    : start(start), end(end), font(font), has_color(false) {}
+
+AttributedText::Style::Style(int start, int end, Color color)
+    : start(start), end(end), has_color(true), color(color) {}
+
+AttributedText::Style::Style(const Style& other) = default;
+
+AttributedText::Style::~Style() {}
+
+AttributedText::AttributedText(const std::string& text,
+                               const TextAttributes& attributes)
+    : text_(text), attributes_(attributes) {}
+
+AttributedText::~AttributedText() {
+  PlatformDestroy();
+}
+
+void AttributedText::SetText(const std::string& text) {
+  text_ = text;
+  styles_.clear();
+  dirty_ = true;
+}
+
+void AttributedText::SetFont(Font* font) {
+  attributes_.font = font;
+  dirty_ = true;
+}
+
+void AttributedText::SetColor(Color color) {
+  attributes_.color = color;
+  dirty_ = true;
+}
+
+void AttributedText::SetAlign(TextAlign align) {
+  attributes_.align = align;
+  dirty_ = true;
+}
+
+void AttributedText::SetValign(TextAlign align) {
+  // Vertical alignment is applied when drawing, the layout is not changed.
+  attributes_.valign = align;
+}
+
+void AttributedText::SetFontFor(Font* font, int start, int end) {
+  AddStyle(Style(start, end, font));
+}
+
+void AttributedText::SetColorFor(Color color, int start, int end) {
+  AddStyle(Style(start, end, color));
+}
+
+void AttributedText::ClearStyles() {
+  styles_.clear();
+  dirty_ = true;
+}
+
+void AttributedText::SetWrapWidth(float width) {
+  wrap_width_ = width < 0 ? -1.f : width;
+  dirty_ = true;
+}
+
+TextMetrics AttributedText::GetMetrics() {
+  GetNative();
+  if (!has_metrics_) {
+    metrics_ = PlatformGetMetrics();
+    has_metrics_ = true;
+  }
+  return metrics_;
+}
+
+NativeAttributedText AttributedText::GetNative() {
+  if (dirty_) {
+    PlatformUpdate();
+    dirty_ = false;
+    has_metrics_ = false;
+  }
+  return native_;
+}
+
+void AttributedText::AddStyle(Style style) {
+  int length = static_cast<int>(text_.size());
+  style.start = std::max(0, std::min(style.start, length));
+  style.end = std::max(style.start, std::min(style.end, length));
+  if (style.start == style.end)
+    return;
+  styles_.push_back(std::move(style));
+  dirty_ = true;
+}
+
+TextRun::TextRun() {}
+
+TextRun::TextRun(AttributedText* text, const RectF& rect)
+    : text(text), rect(rect) {}
+
+TextRun::TextRun(const TextRun& other) = default;
+
+TextRun::~TextRun() {}
+
+RectF GetTextBounds(const RectF& rect, const SizeF& size,
+                    const TextAttributes& attributes) {
+  RectF bounds(rect);
+  // Horizontal alignment.
+  if (attributes.align == TextAlign::Center)
+    bounds.Inset((rect.width() - size.width()) / 2.f, 0.f);
+  else if (attributes.align == TextAlign::End)
+    bounds.Inset(rect.width() - size.width(), 0.f, 0.f, 0.f);
+  // Vertical alignment.
+  if (attributes.valign == TextAlign::Center)
+    bounds.Inset(0.f, (rect.height() - size.height()) / 2.f);
+  else if (attributes.valign == TextAlign::End)
+    bounds.Inset(0.f, rect.height() - size.height(), 0.f, 0.f);
+  return bounds;
+}
+
+}  // namespace nu
@@ -0,0 +1,114 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_ATTRIBUTED_TEXT_H_
+#define NATIVEUI_GFX_ATTRIBUTED_TEXT_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/gfx/text.h"
+#include "nativeui/types.h"
+
+namespace nu {
+
+// Text with attributes that keeps its native layout between draws, so text
+// drawn repeatedly with the same content is only shaped once.
+class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
+ public:
+  // A styled range of text.
+  struct Style {
+    Style(int start, int end, Font* font);
+    Style(int start, int end, Color color);
+    Style(const Style& other);
+    ~Style();
+
+    int start;
+    int end;
+    scoped_refptr<Font> font;  // null if font is not changed
+    bool has_color;
+    Color color;
+  };
+
+  AttributedText(const std::string& text, const TextAttributes& attributes);
+
+  // Change the text, which also clears styled ranges.
+  void SetText(const std::string& text);
+  const std::string& GetText() const { return text_; }
+
+  // Change the attributes of the whole text.
+  void SetFont(Font* font);
+  void SetColor(Color color);
+  void SetAlign(TextAlign align);
+  void SetValign(TextAlign align);
+  const TextAttributes& GetAttributes() const { return attributes_; }
+
+  // Style the bytes of text in [start, end), the range is clamped to the
+  // text's length.
+  void SetFontFor(Font* font, int start, int end);
+  void SetColorFor(Color color, int start, int end);
+  void ClearStyles();
+  const std::vector<Style>& GetStyles() const { return styles_; }
+
+  // Wrap lines at |width|, -1 means no wrapping.
+  void SetWrapWidth(float width);
+  float GetWrapWidth() const { return wrap_width_; }
+
+  // Return the size of laid out text, which is cached until the text changes.
+  TextMetrics GetMetrics();
+
+  // Return the native layout, which is updated lazily after changes.
+  NativeAttributedText GetNative();
+
+  // Internal: Called when the native layout is re-shaped for a different
+  // drawing context, which may change the metrics.
+  void InvalidateMetrics() { has_metrics_ = false; }
+
+ protected:
+  virtual ~AttributedText();
+
+ private:
+  friend class base::RefCounted<AttributedText>;
+
+  void AddStyle(Style style);
+
+  // Create or update the native layout from current state.
+  void PlatformUpdate();
+  void PlatformDestroy();
+  TextMetrics PlatformGetMetrics();
+
+  std::string text_;
+  TextAttributes attributes_;
+  std::vector<Style> styles_;
+  float wrap_width_ = -1.f;
+
+  // Whether the native layout is out of date.
+  bool dirty_ = true;
+  NativeAttributedText native_ = nullptr;
+
+  // Metrics of the native layout, reset when the layout is updated.
+  bool has_metrics_ = false;
+  TextMetrics metrics_;
+};
+
+// A piece of text drawn by Painter::DrawTextBatch.
+struct NATIVEUI_EXPORT TextRun {
+  TextRun();
+  TextRun(AttributedText* text, const RectF& rect);
+  TextRun(const TextRun& other);
+  ~TextRun();
+
+  scoped_refptr<AttributedText> text;
+  RectF rect;
+};
+
+// Compute where laid out text of |size| should be drawn inside |rect|.
+RectF GetTextBounds(const RectF& rect, const SizeF& size,
+                    const TextAttributes& attributes);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_ATTRIBUTED_TEXT_H_
@@ -0,0 +1,67 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AttributedTextTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    text_ = new nu::AttributedText("text", nu::TextAttributes());
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::AttributedText> text_;
+};
+
+TEST_F(AttributedTextTest, SetText) {
+  text_->SetColorFor(nu::Color(255, 0, 0), 0, 2);
+  EXPECT_EQ(text_->GetStyles().size(), 1u);
+  text_->SetText("longlongtext");
+  EXPECT_EQ(text_->GetText(), "longlongtext");
+  EXPECT_TRUE(text_->GetStyles().empty());
+}
+
+TEST_F(AttributedTextTest, StyleRange) {
+  text_->SetColorFor(nu::Color(255, 0, 0), -1, 100);
+  ASSERT_EQ(text_->GetStyles().size(), 1u);
+  EXPECT_EQ(text_->GetStyles()[0].start, 0);
+  EXPECT_EQ(text_->GetStyles()[0].end, 4);
+  // Empty ranges are ignored.
+  text_->SetFontFor(text_->GetAttributes().font.get(), 2, 2);
+  text_->SetFontFor(text_->GetAttributes().font.get(), 3, 1);
+  EXPECT_EQ(text_->GetStyles().size(), 1u);
+  text_->ClearStyles();
+  EXPECT_TRUE(text_->GetStyles().empty());
+}
+
+TEST_F(AttributedTextTest, GetMetrics) {
+  nu::SizeF size = text_->GetMetrics().size;
+  EXPECT_GT(size.width(), 0);
+  EXPECT_GT(size.height(), 0);
+  text_->SetText("text text text text");
+  EXPECT_GT(text_->GetMetrics().size.width(), size.width());
+  // Wrapping makes the text taller.
+  text_->SetWrapWidth(size.width() * 2);
+  EXPECT_GT(text_->GetMetrics().size.height(), size.height());
+}
+
+TEST_F(AttributedTextTest, LayoutIsReused) {
+  nu::NativeAttributedText native = text_->GetNative();
+  EXPECT_EQ(text_->GetNative(), native);
+}
+
+TEST_F(AttributedTextTest, MetricsAreUpdatedAfterChanges) {
+  nu::SizeF size = text_->GetMetrics().size;
+  EXPECT_EQ(text_->GetMetrics().size, size);
+  scoped_refptr<nu::Font> font = text_->GetAttributes().font->Derive(
+      10, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+  text_->SetFont(font.get());
+  EXPECT_GT(text_->GetMetrics().size.height(), size.height());
+  // Vertical alignment does not change the layout.
+  size = text_->GetMetrics().size;
+  text_->SetValign(nu::TextAlign::Center);
+  EXPECT_EQ(text_->GetMetrics().size, size);
+}
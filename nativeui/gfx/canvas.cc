@@ -24,4 +24,14 @@ Canvas::~Canvas() {
   PlatformDestroyBitmap(bitmap_);
 }
 
+const char* Canvas::GetMemoryClassName() const {
+  return "Canvas";
+}
+
+size_t Canvas::EstimateMemoryUsage() const {
+  // The bitmap is 32bit and has the size in pixels.
+  SizeF size = ScaleSize(size_, scale_factor_);
+  return sizeof(Canvas) + static_cast<size_t>(size.width() * size.height()) * 4;
+}
+
 }  // namespace nu
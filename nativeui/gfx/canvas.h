@@ -9,6 +9,7 @@
 
 #include "base/memory/ref_counted.h"
 #include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/memory_dump.h"
 #include "nativeui/nativeui_export.h"
 #include "nativeui/types.h"
 
@@ -16,7 +17,8 @@ namespace nu {
 
 class Painter;
 
-class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
+class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas>,
+                                public MemoryTracked {
  public:
   // Create a canvas with the default scale factor.
   // This is strongly discouraged for using, since it does not work well with
@@ -38,6 +40,10 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   // Internal: Return the native bitmap object.
   NativeBitmap GetBitmap() const { return bitmap_; }
 
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+  size_t EstimateMemoryUsage() const override;
+
  protected:
   virtual ~Canvas();
 
@@ -0,0 +1,84 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/attributed_text.h"
+
+#include <pango/pangocairo.h>
+
+#include "nativeui/gfx/font.h"
+#include "nativeui/gtk/widget_util.h"
+
+namespace nu {
+
+namespace {
+
+PangoAlignment ToPango(TextAlign align) {
+  switch (align) {
+    case TextAlign::Center:
+      return PANGO_ALIGN_CENTER;
+    case TextAlign::End:
+      return PANGO_ALIGN_RIGHT;
+    default:
+      return PANGO_ALIGN_LEFT;
+  }
+}
+
+void InsertAttribute(PangoAttrList* list, PangoAttribute* attr,
+                     const AttributedText::Style& style) {
+  attr->start_index = style.start;
+  attr->end_index = style.end;
+  pango_attr_list_insert(list, attr);
+}
+
+}  // namespace
+
+TextMetrics AttributedText::PlatformGetMetrics() {
+  int width, height;
+  pango_layout_get_pixel_size(GetNative(), &width, &height);
+  return { SizeF(width, height) };
+}
+
+void AttributedText::PlatformUpdate() {
+  if (!native_) {
+    WaitForFontWarmup();
+    // Each layout has its own context, so it can be updated for the cairo
+    // context it is drawn to without affecting others.
+    PangoContext* context = pango_font_map_create_context(
+        pango_cairo_font_map_get_default());
+    native_ = pango_layout_new(context);
+    g_object_unref(context);
+  }
+
+  pango_layout_set_text(native_, text_.data(), text_.length());
+  pango_layout_set_font_description(native_, attributes_.font->GetNative());
+  pango_layout_set_alignment(native_, ToPango(attributes_.align));
+  pango_layout_set_width(
+      native_, wrap_width_ < 0 ? -1 : wrap_width_ * PANGO_SCALE);
+
+  // The color of whole text is set as cairo source when drawing.
+  PangoAttrList* list = pango_attr_list_new();
+  for (const Style& style : styles_) {
+    if (style.font)
+      InsertAttribute(list, pango_attr_font_desc_new(style.font->GetNative()),
+                      style);
+    if (style.has_color) {
+      Color c = style.color;
+      InsertAttribute(list, pango_attr_foreground_new(c.r() * 257,
+                                                      c.g() * 257,
+                                                      c.b() * 257),
+                      style);
+      InsertAttribute(list, pango_attr_foreground_alpha_new(c.a() * 257),
+                      style);
+    }
+  }
+  pango_layout_set_attributes(native_, list);
+  pango_attr_list_unref(list);
+}
+
+void AttributedText::PlatformDestroy() {
+  if (native_)
+    g_object_unref(native_);
+}
+
+}  // namespace nu
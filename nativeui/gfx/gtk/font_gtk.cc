@@ -6,27 +6,27 @@
 
 #include <gtk/gtk.h>
 
-#include "nativeui/label.h"
+#include "nativeui/gtk/widget_util.h"
 
 namespace nu {
 
 namespace {
 
 PangoFontDescription* GetDefaultFontDescription() {
-  // Receive the default font from control.
-  scoped_refptr<nu::Label> label = new nu::Label;
-  gtk_widget_ensure_style(label->GetNative());
-  GtkStyle* style = gtk_widget_get_style(label->GetNative());
-  return pango_font_description_copy(style->font_desc);
+  // Reading from settings is much cheaper than creating a widget and
+  // resolving its style.
+  return pango_font_description_from_string(GetDefaultFontName().c_str());
 }
 
 }  // namespace
 
 Font::Font() : font_(GetDefaultFontDescription()) {
+  WaitForFontWarmup();
 }
 
 Font::Font(const std::string& name, float size, Weight weight, Style style)
     : font_(pango_font_description_new()) {
+  WaitForFontWarmup();
   pango_font_description_set_family(font_, name.data());
   pango_font_description_set_absolute_size(font_, size * PANGO_SCALE);
   pango_font_description_set_weight(font_, static_cast<PangoWeight>(weight));
@@ -14,6 +14,7 @@
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gtk/widget_util.h"
 
 namespace nu {
 
@@ -190,6 +191,7 @@ void PainterGtk::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
 
 TextMetrics PainterGtk::MeasureText(const std::string& text, float width,
                                     const TextAttributes& attributes) {
+  WaitForFontWarmup();
   PangoLayout* layout = pango_cairo_create_layout(context_);
   pango_layout_set_font_description(layout, attributes.font->GetNative());
   pango_layout_set_text(layout, text.data(), text.length());
@@ -203,6 +205,7 @@ TextMetrics PainterGtk::MeasureText(const std::string& text, float width,
 
 void PainterGtk::DrawText(const std::string& text, const RectF& rect,
                           const TextAttributes& attributes) {
+  WaitForFontWarmup();
   PangoLayout* layout = pango_cairo_create_layout(context_);
   pango_layout_set_font_description(layout, attributes.font->GetNative());
   cairo_save(context_);
@@ -213,18 +216,8 @@ void PainterGtk::DrawText(const std::string& text, const RectF& rect,
   pango_layout_set_text(layout, text.data(), text.length());
   pango_layout_get_pixel_size(layout, &width, &height);
 
-  // Horizontal alignment.
-  RectF bounds(rect);
-  if (attributes.align == TextAlign::Center)
-    bounds.Inset((rect.width() - width) / 2.f, 0.f);
-  else if (attributes.align == TextAlign::End)
-    bounds.Inset(rect.width() - width, 0.f, 0.f, 0.f);
-
-  // Vertical alignment
-  if (attributes.valign == TextAlign::Center)
-    bounds.Inset(0.f, (rect.height() - height) / 2);
-  else if (attributes.valign == TextAlign::End)
-    bounds.Inset(0.f, rect.height() - height, 0.f, 0.f);
+  // Alignment.
+  RectF bounds = GetTextBounds(rect, SizeF(width, height), attributes);
 
   // Apply the color.
   Color color = attributes.color;
@@ -244,6 +237,53 @@ void PainterGtk::DrawText(const std::string& text, const RectF& rect,
   g_object_unref(layout);
 }
 
+void PainterGtk::DrawAttributedText(AttributedText* text, const RectF& rect) {
+  cairo_save(context_);
+  // Don't draw outside boundry.
+  ClipRect(rect);
+  ShowAttributedText(text, rect);
+  cairo_restore(context_);
+}
+
+void PainterGtk::DrawTextBatch(const std::vector<TextRun>& runs) {
+  cairo_save(context_);
+  for (const TextRun& run : runs)
+    ShowAttributedText(run.text.get(), run.rect);
+  cairo_restore(context_);
+}
+
+float PainterGtk::GetScaleFactor() const {
+  // GDK sets the device scale of window surfaces on HiDPI displays.
+  double x_scale, y_scale;
+  cairo_surface_get_device_scale(cairo_get_target(context_),
+                                 &x_scale, &y_scale);
+  return x_scale;
+}
+
+void PainterGtk::ShowAttributedText(AttributedText* text, const RectF& rect) {
+  PangoLayout* layout = text->GetNative();
+  // Only re-shapes when the context has different font options or transform,
+  // in which case the cached metrics are out of date.
+  guint serial = pango_layout_get_serial(layout);
+  pango_cairo_update_layout(context_, layout);
+  if (pango_layout_get_serial(layout) != serial)
+    text->InvalidateMetrics();
+
+  // Text size, the lines are aligned by pango inside wrap width.
+  int width, height;
+  pango_layout_get_pixel_size(layout, &width, &height);
+  if (text->GetWrapWidth() >= 0)
+    width = text->GetWrapWidth();
+  RectF bounds = GetTextBounds(rect, SizeF(width, height),
+                               text->GetAttributes());
+
+  Color color = text->GetAttributes().color;
+  cairo_set_source_rgba(context_, color.r() / 255., color.g() / 255.,
+                                  color.b() / 255., color.a() / 255.);
+  cairo_move_to(context_, bounds.x(), bounds.y());
+  pango_cairo_show_layout(context_, layout);
+}
+
 void PainterGtk::Initialize() {
   // Initial state.
   states_.push({Color(), Color()});
@@ -7,6 +7,7 @@
 
 #include <stack>
 #include <string>
+#include <vector>
 
 #include "nativeui/gfx/painter.h"
 
@@ -56,8 +57,14 @@ class PainterGtk : public Painter {
                           const TextAttributes& attributes) override;
   void DrawText(const std::string& text, const RectF& rect,
                 const TextAttributes& attributes) override;
+  void DrawAttributedText(AttributedText* text, const RectF& rect) override;
+  void DrawTextBatch(const std::vector<TextRun>& runs) override;
+  float GetScaleFactor() const override;
 
  private:
+  // Draw the layout of |text| without saving state.
+  void ShowAttributedText(AttributedText* text, const RectF& rect);
+
   // Common initailization used by constructors.
   void Initialize();
 
@@ -6,18 +6,16 @@
 
 #include <gtk/gtk.h>
 
-#include "nativeui/label.h"
-
 namespace nu {
 
 float GetScaleFactor() {
   static float scale_factor = -1.f;
   if (scale_factor <= 0) {
-    // The gtk-xft-dpi GtkSetting does not return us correct value, the only
-    // reliable way to get scale factor on Linux seems to be calling the
-    // gtk_widget_get_scale_factor API.
-    scoped_refptr<nu::Label> label = new nu::Label;
-    scale_factor = gtk_widget_get_scale_factor(label->GetNative());
+    // The gtk-xft-dpi GtkSetting does not return us correct value. For a
+    // widget not added to window, gtk_widget_get_scale_factor returns the
+    // scale factor of the first monitor, which can be read directly.
+    scale_factor = gdk_screen_get_monitor_scale_factor(
+        gdk_screen_get_default(), 0);
   }
   return scale_factor;
 }
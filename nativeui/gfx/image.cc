@@ -4,9 +4,15 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "base/files/file_path.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/state.h"
+#include "nativeui/util/aes.h"
 
 namespace nu {
 
@@ -32,8 +38,59 @@ ScaleFactorPair kScaleFactorPairs[] = {
   { FILE_PATH_LITERAL("@2.5x")  , 2.5f },
 };
 
+// Decrypt the AES-CBC encrypted |data|, return an empty buffer on failure.
+Buffer Decrypt(const uint8_t* data, uint32_t size,
+               const std::string& key, const std::string& iv) {
+  AES aes;
+  if (!aes.Init(key, iv) || size == 0 || size % AES_BLOCKLEN != 0)
+    return Buffer();
+  uint8_t* content = static_cast<uint8_t*>(malloc(size));
+  memcpy(content, data, size);
+  aes.CBCDecryptBuffer(content, size);
+  // Remove the PKCS#7 paddings.
+  uint8_t paddings = content[size - 1];
+  if (paddings == 0 || paddings > AES_BLOCKLEN) {
+    free(content);
+    return Buffer();
+  }
+  return Buffer::TakeOver(content, size - paddings, free);
+}
+
 }  // namespace
 
+// static
+Image* Image::CreateFromAsar(const base::FilePath& asar,
+                             const std::string& path) {
+  return ReadFromAsar(asar, path,
+                      GetScaleFactorFromFilePath(
+                          base::FilePath::FromUTF8Unsafe(path)),
+                      std::string(), std::string());
+}
+
+// static
+Image* Image::CreateFromEncryptedAsar(const base::FilePath& asar,
+                                      const std::string& path,
+                                      const std::string& key,
+                                      const std::string& iv) {
+  // An empty key would read the file without decryption.
+  if (key.empty())
+    return nullptr;
+  return ReadFromAsar(asar, path,
+                      GetScaleFactorFromFilePath(
+                          base::FilePath::FromUTF8Unsafe(path)),
+                      key, iv);
+}
+
+const char* Image::GetMemoryClassName() const {
+  return "Image";
+}
+
+size_t Image::EstimateMemoryUsage() const {
+  // Decoded images are stored as 32bit bitmaps.
+  SizeF size = ScaleSize(GetSize(), scale_factor_);
+  return sizeof(Image) + static_cast<size_t>(size.width() * size.height()) * 4;
+}
+
 // static
 float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   base::FilePath::StringType name(path.BaseName().RemoveExtension().value());
@@ -50,4 +107,25 @@ float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   return 1.0f;
 }
 
+// static
+Image* Image::ReadFromAsar(const base::FilePath& asar,
+                           const std::string& path,
+                           float scale_factor,
+                           const std::string& key,
+                           const std::string& iv) {
+  AsarArchive* archive = State::GetCurrent()->GetAsarArchive(asar);
+  AsarArchive::FileInfo info;
+  if (!archive || !archive->GetFileInfo(path, &info))
+    return nullptr;
+  const uint8_t* data = archive->GetMappedContent(info);
+  if (!data)
+    return nullptr;
+  if (key.empty())
+    return new Image(Buffer::Wrap(data, info.size), scale_factor);
+  Buffer buffer = Decrypt(data, info.size, key, iv);
+  if (!buffer.content())
+    return nullptr;
+  return new Image(buffer, scale_factor);
+}
+
 }  // namespace nu
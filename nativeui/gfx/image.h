@@ -12,6 +12,7 @@
 #include "base/memory/ref_counted.h"
 #include "nativeui/buffer.h"
 #include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/memory_dump.h"
 #include "nativeui/types.h"
 
 #if defined(OS_MACOSX)
@@ -20,7 +21,8 @@
 
 namespace nu {
 
-class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
+class NATIVEUI_EXPORT Image : public base::RefCounted<Image>,
+                               public MemoryTracked {
  public:
   // Create an image by reading from |path|.
   // The @2x suffix in basename will make the image have scale factor.
@@ -29,6 +31,23 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   // Create an image from memory.
   Image(const Buffer& buffer, float scale_factor);
 
+  // Create an image from the file at |path| inside the |asar| archive, the
+  // data are decoded from the memory mapped archive without copying, and the
+  // archive is shared by later calls. The @2x suffix in basename will make
+  // the image have scale factor. Return null if the file can not be read.
+  //
+  // The mapped archive is owned by State, and the image may keep reading it,
+  // so the image must not be used after State is destroyed.
+  static Image* CreateFromAsar(const base::FilePath& asar,
+                               const std::string& path);
+
+  // Like CreateFromAsar, but the file is decrypted with |key| and |iv|. The
+  // decrypted data is owned by the image. Return null if |key| is empty.
+  static Image* CreateFromEncryptedAsar(const base::FilePath& asar,
+                                        const std::string& path,
+                                        const std::string& key,
+                                        const std::string& iv);
+
   // Get the size of image.
   SizeF GetSize() const;
 
@@ -44,6 +63,10 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   // Return the native instance of image object.
   NativeImage GetNative() const;
 
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+  size_t EstimateMemoryUsage() const override;
+
 #if defined(OS_MACOSX)
   // Internal: Return the image representaion that has animations.
   NSBitmapImageRep* GetAnimationRep() const;
@@ -57,9 +80,18 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
 
  private:
   friend class base::RefCounted<Image>;
+  friend class ImageSet;
 
   static float GetScaleFactorFromFilePath(const base::FilePath& path);
 
+  // Read the |path| inside |asar| with |scale_factor|, the data is decrypted
+  // when |key| is not empty.
+  static Image* ReadFromAsar(const base::FilePath& asar,
+                             const std::string& path,
+                             float scale_factor,
+                             const std::string& key,
+                             const std::string& iv);
+
   float scale_factor_;
   NativeImage image_;
 
@@ -0,0 +1,53 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/image_atlas.h"
+
+#include "nativeui/gfx/geometry/size_conversions.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/screen.h"
+
+namespace nu {
+
+namespace {
+
+// Pixels left between images, so scaled drawing does not sample neighbors.
+const int kPadding = 1;
+
+}  // namespace
+
+ImageAtlas::ImageAtlas(const SizeF& size)
+    : ImageAtlas(size, nu::GetScaleFactor()) {
+}
+
+ImageAtlas::ImageAtlas(const SizeF& size, float scale_factor)
+    : canvas_(new Canvas(size, scale_factor)),
+      packer_(ToFlooredSize(ScaleSize(size, scale_factor))) {
+}
+
+ImageAtlas::~ImageAtlas() {
+}
+
+AtlasImage* ImageAtlas::AddImage(Image* image) {
+  SizeF size = image->GetSize();
+  Size pixel_size = ToCeiledSize(ScaleSize(size, GetScaleFactor()));
+  Rect rect;
+  if (!packer_.Pack(Size(pixel_size.width() + kPadding,
+                         pixel_size.height() + kPadding),
+                    &rect))
+    return nullptr;
+  RectF dest(ScalePoint(PointF(rect.origin()), 1.f / GetScaleFactor()), size);
+  canvas_->GetPainter()->DrawImage(image, dest);
+  return new AtlasImage(this, dest);
+}
+
+AtlasImage::AtlasImage(ImageAtlas* atlas, const RectF& rect)
+    : atlas_(atlas), rect_(rect) {
+}
+
+AtlasImage::~AtlasImage() {
+}
+
+}  // namespace nu
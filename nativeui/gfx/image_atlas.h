@@ -0,0 +1,72 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_IMAGE_ATLAS_H_
+#define NATIVEUI_GFX_IMAGE_ATLAS_H_
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/util/skyline_packer.h"
+
+namespace nu {
+
+class AtlasImage;
+class Image;
+
+// Packs many small images into one canvas, so drawing them only uses the
+// already converted bitmap of the canvas instead of converting each image.
+class NATIVEUI_EXPORT ImageAtlas : public base::RefCounted<ImageAtlas> {
+ public:
+  // Create an atlas of |size| in DIP with the default scale factor.
+  explicit ImageAtlas(const SizeF& size);
+  ImageAtlas(const SizeF& size, float scale_factor);
+
+  // Copy |image| into the atlas, return null if there is no space left.
+  AtlasImage* AddImage(Image* image);
+
+  // Return the canvas that holds the images.
+  Canvas* GetCanvas() const { return canvas_.get(); }
+
+  SizeF GetSize() const { return canvas_->GetSize(); }
+  float GetScaleFactor() const { return canvas_->GetScaleFactor(); }
+
+ protected:
+  virtual ~ImageAtlas();
+
+ private:
+  friend class base::RefCounted<ImageAtlas>;
+
+  scoped_refptr<Canvas> canvas_;
+  // Works in pixels of the canvas.
+  SkylinePacker packer_;
+};
+
+// A lightweight handle of an image stored in ImageAtlas.
+class NATIVEUI_EXPORT AtlasImage : public base::RefCounted<AtlasImage> {
+ public:
+  AtlasImage(ImageAtlas* atlas, const RectF& rect);
+
+  // Return the atlas that stores the image.
+  ImageAtlas* GetAtlas() const { return atlas_.get(); }
+
+  // Return the area of image in the atlas in DIP.
+  RectF GetRect() const { return rect_; }
+
+  // Return the size of image in DIP.
+  SizeF GetSize() const { return rect_.size(); }
+
+ protected:
+  virtual ~AtlasImage();
+
+ private:
+  friend class base::RefCounted<AtlasImage>;
+
+  scoped_refptr<ImageAtlas> atlas_;
+  RectF rect_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_IMAGE_ATLAS_H_
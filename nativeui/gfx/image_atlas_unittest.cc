@@ -0,0 +1,67 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "nativeui/gfx/geometry/rect_conversions.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ImageAtlasTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    base::FilePath exe_path;
+    PathService::Get(base::FILE_EXE, &exe_path);
+    base::FilePath dir = exe_path.DirName().DirName().DirName()
+                                 .Append(FILE_PATH_LITERAL("nativeui"))
+                                 .Append(FILE_PATH_LITERAL("test"))
+                                 .Append(FILE_PATH_LITERAL("fixtures"));
+    // The image is 1x1.
+    image_ = new nu::Image(dir.Append(FILE_PATH_LITERAL("static.png")));
+    ASSERT_EQ(image_->GetSize(), nu::SizeF(1, 1));
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Image> image_;
+};
+
+TEST_F(ImageAtlasTest, Placement) {
+  scoped_refptr<nu::ImageAtlas> atlas(new nu::ImageAtlas(nu::SizeF(4, 2), 1));
+  // Each image takes 1 pixel of padding.
+  scoped_refptr<nu::AtlasImage> first = atlas->AddImage(image_.get());
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->GetAtlas(), atlas.get());
+  EXPECT_EQ(first->GetRect(), nu::RectF(0, 0, 1, 1));
+  scoped_refptr<nu::AtlasImage> second = atlas->AddImage(image_.get());
+  ASSERT_TRUE(second);
+  EXPECT_EQ(second->GetRect(), nu::RectF(2, 0, 1, 1));
+  EXPECT_EQ(second->GetSize(), image_->GetSize());
+}
+
+TEST_F(ImageAtlasTest, ReturnNullWhenFull) {
+  scoped_refptr<nu::ImageAtlas> atlas(new nu::ImageAtlas(nu::SizeF(4, 2), 1));
+  scoped_refptr<nu::AtlasImage> first = atlas->AddImage(image_.get());
+  scoped_refptr<nu::AtlasImage> second = atlas->AddImage(image_.get());
+  ASSERT_TRUE(first && second);
+  scoped_refptr<nu::AtlasImage> third = atlas->AddImage(image_.get());
+  EXPECT_FALSE(third);
+}
+
+TEST_F(ImageAtlasTest, RectMapsToPixels) {
+  const float scale_factor = 2;
+  scoped_refptr<nu::ImageAtlas> atlas(
+      new nu::ImageAtlas(nu::SizeF(4, 2), scale_factor));
+  EXPECT_EQ(atlas->GetScaleFactor(), scale_factor);
+  // The canvas is 8x4 pixels, and each image takes 3x3 pixels with padding.
+  scoped_refptr<nu::AtlasImage> first = atlas->AddImage(image_.get());
+  scoped_refptr<nu::AtlasImage> second = atlas->AddImage(image_.get());
+  ASSERT_TRUE(first && second);
+  EXPECT_EQ(nu::ToEnclosingRect(nu::ScaleRect(first->GetRect(), scale_factor)),
+            nu::Rect(0, 0, 2, 2));
+  EXPECT_EQ(nu::ToEnclosingRect(nu::ScaleRect(second->GetRect(),
+                                              scale_factor)),
+            nu::Rect(3, 0, 2, 2));
+  EXPECT_FALSE(atlas->AddImage(image_.get()));
+}
@@ -0,0 +1,132 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/image_set.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "nativeui/gfx/screen.h"
+
+namespace nu {
+
+namespace {
+
+// Two variants cover drawing to a normal and a HiDPI display at the same time.
+const size_t kMaxDecodedVariants = 2;
+
+}  // namespace
+
+ImageSet::ImageSet() {}
+
+ImageSet::~ImageSet() {}
+
+void ImageSet::AddFile(const base::FilePath& path, float scale_factor) {
+  if (scale_factor <= 0)
+    scale_factor = Image::GetScaleFactorFromFilePath(path);
+  AddVariant({scale_factor, path, std::string()});
+}
+
+void ImageSet::AddAsarEntry(const base::FilePath& asar,
+                            const std::string& entry,
+                            float scale_factor) {
+  if (scale_factor <= 0)
+    scale_factor = Image::GetScaleFactorFromFilePath(
+        base::FilePath::FromUTF8Unsafe(entry));
+  AddVariant({scale_factor, asar, entry});
+}
+
+Image* ImageSet::GetImageForScale(float scale_factor) {
+  if (variants_.empty())
+    return nullptr;
+  auto it = std::lower_bound(
+      variants_.begin(), variants_.end(), scale_factor,
+      [](const Variant& v, float scale) { return v.scale_factor < scale; });
+  if (it == variants_.end())
+    --it;
+  auto cached = std::find_if(
+      decoded_.begin(), decoded_.end(),
+      [&it](const std::pair<float, scoped_refptr<Image>>& decoded) {
+        return decoded.first == it->scale_factor;
+      });
+  if (cached != decoded_.end()) {
+    // Move to front.
+    std::rotate(decoded_.begin(), cached, cached + 1);
+  } else {
+    // Release the least recently used variant before decoding the new one to
+    // keep the peak memory usage low.
+    if (decoded_.size() >= kMaxDecodedVariants)
+      decoded_.pop_back();
+    decoded_.emplace(decoded_.begin(), it->scale_factor, Decode(*it));
+  }
+  return decoded_.front().second.get();
+}
+
+bool ImageSet::IsDecoded(float scale_factor) const {
+  for (const auto& decoded : decoded_) {
+    if (decoded.first == scale_factor)
+      return true;
+  }
+  return false;
+}
+
+Image* ImageSet::GetImage() {
+  return GetImageForScale(nu::GetScaleFactor());
+}
+
+SizeF ImageSet::GetSize() {
+  Image* image = GetImage();
+  return image ? image->GetSize() : SizeF();
+}
+
+std::vector<float> ImageSet::GetScaleFactors() const {
+  std::vector<float> scales;
+  for (const Variant& variant : variants_)
+    scales.push_back(variant.scale_factor);
+  return scales;
+}
+
+void ImageSet::AddVariant(Variant variant) {
+  auto it = std::lower_bound(
+      variants_.begin(), variants_.end(), variant.scale_factor,
+      [](const Variant& v, float scale) { return v.scale_factor < scale; });
+  if (it != variants_.end() && it->scale_factor == variant.scale_factor) {
+    // Replace the existing variant of same scale.
+    float scale_factor = variant.scale_factor;
+    decoded_.erase(
+        std::remove_if(
+            decoded_.begin(), decoded_.end(),
+            [scale_factor](const std::pair<float, scoped_refptr<Image>>& d) {
+              return d.first == scale_factor;
+            }),
+        decoded_.end());
+    *it = std::move(variant);
+  } else {
+    variants_.insert(it, std::move(variant));
+  }
+}
+
+// static
+scoped_refptr<Image> ImageSet::Decode(const Variant& variant) {
+  if (!variant.entry.empty()) {
+    // Decoded from the mapped archive without reading into memory.
+    scoped_refptr<Image> image = Image::ReadFromAsar(
+        variant.path, variant.entry, variant.scale_factor,
+        std::string(), std::string());
+    if (image)
+      return image;
+    return new Image(Buffer(), variant.scale_factor);
+  }
+  // The image may keep using the buffer after decoding, so the buffer must own
+  // the content.
+  std::string content;
+  base::ReadFileToString(variant.path, &content);
+  std::string* data = new std::string(std::move(content));
+  return new Image(Buffer::TakeOver(&(*data)[0], data->size(),
+                                    [data](void*) { delete data; }),
+                   variant.scale_factor);
+}
+
+}  // namespace nu
@@ -0,0 +1,82 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_IMAGE_SET_H_
+#define NATIVEUI_GFX_IMAGE_SET_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/image.h"
+
+namespace nu {
+
+// A set of variants of the same image in different scale factors, only the
+// variant that matches the drawing scale is decoded.
+class NATIVEUI_EXPORT ImageSet : public base::RefCounted<ImageSet> {
+ public:
+  ImageSet();
+
+  // Add the file at |path| as the variant of |scale_factor|. If
+  // |scale_factor| is not positive, it is read from the @2x suffix of path.
+  void AddFile(const base::FilePath& path, float scale_factor);
+
+  // Add the file |entry| inside |asar| archive as the variant of
+  // |scale_factor|.
+  void AddAsarEntry(const base::FilePath& asar, const std::string& entry,
+                    float scale_factor);
+
+  // Return the variant that best matches |scale_factor|, which is the smallest
+  // one not smaller than |scale_factor|, or the largest one if there is none.
+  // The variant is decoded on first use, and the most recently used variants
+  // are kept so drawing to displays of different scales does not re-decode.
+  Image* GetImageForScale(float scale_factor);
+
+  // Return the variant for the scale factor of primary screen.
+  Image* GetImage();
+
+  // Return the size of image in DIP, null images have empty size.
+  SizeF GetSize();
+
+  // Return the scale factors of added variants in ascending order.
+  std::vector<float> GetScaleFactors() const;
+
+  // Return the scale factor of the most recently used variant, 0 if none.
+  float GetDecodedScaleFactor() const {
+    return decoded_.empty() ? 0.f : decoded_.front().first;
+  }
+
+  // Return whether the variant of |scale_factor| is decoded.
+  bool IsDecoded(float scale_factor) const;
+
+ protected:
+  virtual ~ImageSet();
+
+ private:
+  friend class base::RefCounted<ImageSet>;
+
+  struct Variant {
+    float scale_factor;
+    base::FilePath path;
+    std::string entry;  // empty if |path| is not an asar archive
+  };
+
+  void AddVariant(Variant variant);
+
+  // Read and decode the |variant|, return an empty image on failure.
+  static scoped_refptr<Image> Decode(const Variant& variant);
+
+  // Sorted by scale factor.
+  std::vector<Variant> variants_;
+
+  // Decoded variants and their scale factors, most recently used first.
+  std::vector<std::pair<float, scoped_refptr<Image>>> decoded_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_IMAGE_SET_H_
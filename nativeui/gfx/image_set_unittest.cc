@@ -0,0 +1,90 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ImageSetTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    set_ = new nu::ImageSet();
+    base::FilePath exe_path;
+    PathService::Get(base::FILE_EXE, &exe_path);
+    path_ = exe_path.DirName().DirName().DirName()
+                    .Append(FILE_PATH_LITERAL("nativeui"))
+                    .Append(FILE_PATH_LITERAL("test"))
+                    .Append(FILE_PATH_LITERAL("fixtures"))
+                    .Append(FILE_PATH_LITERAL("static.png"));
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::ImageSet> set_;
+  base::FilePath path_;
+};
+
+TEST_F(ImageSetTest, Empty) {
+  EXPECT_EQ(set_->GetImageForScale(1.f), nullptr);
+  EXPECT_EQ(set_->GetSize(), nu::SizeF());
+  EXPECT_EQ(set_->GetDecodedScaleFactor(), 0.f);
+}
+
+TEST_F(ImageSetTest, ScaleFactorFromPath) {
+  set_->AddFile(base::FilePath(FILE_PATH_LITERAL("icon@2x.png")), 0);
+  set_->AddFile(base::FilePath(FILE_PATH_LITERAL("icon.png")), 0);
+  set_->AddFile(base::FilePath(FILE_PATH_LITERAL("icon.png")), 3.f);
+  std::vector<float> expected = {1.f, 2.f, 3.f};
+  EXPECT_EQ(set_->GetScaleFactors(), expected);
+}
+
+TEST_F(ImageSetTest, DecodeOnlyMatchedVariant) {
+  set_->AddFile(path_, 1.f);
+  set_->AddFile(path_, 2.f);
+  EXPECT_EQ(set_->GetDecodedScaleFactor(), 0.f);
+
+  nu::Image* image = set_->GetImageForScale(1.f);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetScaleFactor(), 1.f);
+  EXPECT_EQ(set_->GetDecodedScaleFactor(), 1.f);
+  // Same variant is reused.
+  EXPECT_EQ(set_->GetImageForScale(1.f), image);
+
+  // Smallest variant not smaller than the scale.
+  image = set_->GetImageForScale(1.5f);
+  EXPECT_EQ(image->GetScaleFactor(), 2.f);
+  EXPECT_EQ(set_->GetDecodedScaleFactor(), 2.f);
+  // Largest variant when all are smaller.
+  EXPECT_EQ(set_->GetImageForScale(3.f), image);
+
+  // The variant is decoded with its own scale factor.
+  nu::SizeF size = set_->GetImageForScale(1.f)->GetSize();
+  EXPECT_EQ(set_->GetImageForScale(2.f)->GetSize(),
+            nu::ScaleSize(size, 0.5f));
+}
+
+TEST_F(ImageSetTest, KeepRecentlyUsedVariants) {
+  set_->AddFile(path_, 1.f);
+  set_->AddFile(path_, 2.f);
+  set_->AddFile(path_, 3.f);
+  scoped_refptr<nu::Image> image1 = set_->GetImageForScale(1.f);
+  scoped_refptr<nu::Image> image2 = set_->GetImageForScale(2.f);
+  // Switching between scales does not decode again.
+  EXPECT_EQ(set_->GetImageForScale(1.f), image1.get());
+  EXPECT_EQ(set_->GetImageForScale(2.f), image2.get());
+  EXPECT_EQ(set_->GetDecodedScaleFactor(), 2.f);
+
+  // The least recently used variant is dropped.
+  EXPECT_EQ(set_->GetImageForScale(1.f), image1.get());
+  set_->GetImageForScale(3.f);
+  EXPECT_TRUE(set_->IsDecoded(1.f));
+  EXPECT_FALSE(set_->IsDecoded(2.f));
+  EXPECT_TRUE(set_->IsDecoded(3.f));
+  EXPECT_NE(set_->GetImageForScale(2.f), image2.get());
+
+  // Replacing a variant drops its decoded image.
+  set_->AddFile(path_, 2.f);
+  EXPECT_FALSE(set_->IsDecoded(2.f));
+}
@@ -0,0 +1,143 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
+#include "base/path_service.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/util/aes.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const char kKey[] = "0123456789abcdef";
+const char kIv[] = "fedcba9876543210";
+
+// Encrypt |content| with PKCS#7 paddings in the same way with asar tools.
+std::string Encrypt(const std::string& content) {
+  size_t paddings = AES_BLOCKLEN - content.size() % AES_BLOCKLEN;
+  std::string result =
+      content + std::string(paddings, static_cast<char>(paddings));
+  nu::AES aes;
+  aes.Init(kKey, kIv);
+  aes.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&result[0]),
+                       static_cast<uint32_t>(result.size()));
+  return result;
+}
+
+// Write an archive with the plain "image.png", the encrypted "encrypted.png",
+// and "broken.png" whose offset is beyond the end of archive.
+bool WriteArchive(const base::FilePath& path, const std::string& png) {
+  std::string encrypted = Encrypt(png);
+  base::Value files(base::Value::Type::DICTIONARY);
+  base::Value plain_file(base::Value::Type::DICTIONARY);
+  plain_file.SetKey("size", base::Value(static_cast<int>(png.size())));
+  plain_file.SetKey("offset", base::Value("0"));
+  files.SetKey("image.png", std::move(plain_file));
+  base::Value encrypted_file(base::Value::Type::DICTIONARY);
+  encrypted_file.SetKey("size",
+                        base::Value(static_cast<int>(encrypted.size())));
+  encrypted_file.SetKey("offset",
+                        base::Value(base::NumberToString(png.size())));
+  files.SetKey("encrypted.png", std::move(encrypted_file));
+  base::Value broken_file(base::Value::Type::DICTIONARY);
+  broken_file.SetKey("size", base::Value(static_cast<int>(png.size())));
+  broken_file.SetKey("offset", base::Value(base::NumberToString(
+      png.size() + encrypted.size())));
+  files.SetKey("broken.png", std::move(broken_file));
+  base::Value root(base::Value::Type::DICTIONARY);
+  root.SetKey("files", std::move(files));
+
+  std::string json;
+  if (!base::JSONWriter::Write(root, &json))
+    return false;
+  base::Pickle header;
+  header.WriteString(json);
+  base::Pickle size;
+  size.WriteUInt32(static_cast<uint32_t>(header.size()));
+
+  std::string content(static_cast<const char*>(size.data()), size.size());
+  content.append(static_cast<const char*>(header.data()), header.size());
+  content.append(png);
+  content.append(encrypted);
+  return base::WriteFile(path, content.data(), content.size()) ==
+         static_cast<int>(content.size());
+}
+
+}  // namespace
+
+class ImageTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    base::FilePath exe_path;
+    PathService::Get(base::FILE_EXE, &exe_path);
+    base::FilePath png_path = exe_path.DirName().DirName().DirName()
+                                      .Append(FILE_PATH_LITERAL("nativeui"))
+                                      .Append(FILE_PATH_LITERAL("test"))
+                                      .Append(FILE_PATH_LITERAL("fixtures"))
+                                      .Append(FILE_PATH_LITERAL("static.png"));
+    ASSERT_TRUE(base::ReadFileToString(png_path, &png_));
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    asar_ = temp_dir_.GetPath().Append(FILE_PATH_LITERAL("images.asar"));
+    ASSERT_TRUE(WriteArchive(asar_, png_));
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath asar_;
+  std::string png_;
+};
+
+TEST_F(ImageTest, CreateFromAsar) {
+  scoped_refptr<nu::Image> expected = new nu::Image(
+      nu::Buffer::Wrap(png_.data(), png_.size()), 1.f);
+  scoped_refptr<nu::Image> image = nu::Image::CreateFromAsar(asar_,
+                                                             "image.png");
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), expected->GetSize());
+}
+
+TEST_F(ImageTest, CreateFromEncryptedAsar) {
+  scoped_refptr<nu::Image> expected = new nu::Image(
+      nu::Buffer::Wrap(png_.data(), png_.size()), 1.f);
+  scoped_refptr<nu::Image> image = nu::Image::CreateFromEncryptedAsar(
+      asar_, "encrypted.png", kKey, kIv);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), expected->GetSize());
+  // Wrong or empty keys are rejected.
+  EXPECT_FALSE(nu::Image::CreateFromEncryptedAsar(
+      asar_, "encrypted.png", "short", kIv));
+  EXPECT_FALSE(nu::Image::CreateFromEncryptedAsar(
+      asar_, "image.png", std::string(), kIv));
+}
+
+TEST_F(ImageTest, CreateFromAsarFailures) {
+  EXPECT_FALSE(nu::Image::CreateFromAsar(asar_, "missing.png"));
+  EXPECT_FALSE(nu::Image::CreateFromAsar(asar_, "broken.png"));
+  EXPECT_FALSE(nu::Image::CreateFromAsar(
+      temp_dir_.GetPath().Append(FILE_PATH_LITERAL("missing.asar")),
+      "image.png"));
+}
+
+TEST_F(ImageTest, GetAsarArchive) {
+  nu::AsarArchive* archive = state_.GetAsarArchive(asar_);
+  ASSERT_TRUE(archive);
+  // The archive is shared.
+  EXPECT_EQ(state_.GetAsarArchive(asar_), archive);
+  nu::AsarArchive::FileInfo info;
+  ASSERT_TRUE(archive->GetFileInfo("broken.png", &info));
+  EXPECT_FALSE(archive->GetMappedContent(info));
+  ASSERT_TRUE(archive->GetFileInfo("image.png", &info));
+  const uint8_t* data = archive->GetMappedContent(info);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(data), info.size), png_);
+}
@@ -0,0 +1,77 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/attributed_text.h"
+
+#import <Cocoa/Cocoa.h>
+
+#include "base/mac/scoped_nsobject.h"
+#include "base/strings/sys_string_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "nativeui/gfx/font.h"
+
+namespace nu {
+
+namespace {
+
+NSTextAlignment ToNS(TextAlign align) {
+  switch (align) {
+    case TextAlign::Center:
+      return NSCenterTextAlignment;
+    case TextAlign::End:
+      return NSRightTextAlignment;
+    default:
+      return NSLeftTextAlignment;
+  }
+}
+
+// Convert the range of UTF-8 bytes to the range of UTF-16 characters.
+NSRange ToNSRange(const std::string& text, int start, int end) {
+  size_t location = base::UTF8ToUTF16(text.substr(0, start)).length();
+  size_t length = base::UTF8ToUTF16(text.substr(start, end - start)).length();
+  return NSMakeRange(location, length);
+}
+
+}  // namespace
+
+TextMetrics AttributedText::PlatformGetMetrics() {
+  CGFloat width = wrap_width_ < 0 ? CGFLOAT_MAX : wrap_width_;
+  CGRect bounds = [GetNative()
+      boundingRectWithSize:CGSizeMake(width, CGFLOAT_MAX)
+                   options:NSStringDrawingUsesLineFragmentOrigin];
+  return { SizeF(bounds.size) };
+}
+
+void AttributedText::PlatformUpdate() {
+  base::scoped_nsobject<NSMutableParagraphStyle> paragraph(
+      [[NSParagraphStyle defaultParagraphStyle] mutableCopy]);
+  [paragraph setAlignment:ToNS(attributes_.align)];
+  NSDictionary* attrs_dict = @{
+    NSFontAttributeName: attributes_.font->GetNative(),
+    NSParagraphStyleAttributeName: paragraph.get(),
+    NSForegroundColorAttributeName: attributes_.color.ToNSColor(),
+  };
+
+  [native_ release];
+  native_ = [[NSMutableAttributedString alloc]
+      initWithString:base::SysUTF8ToNSString(text_)
+          attributes:attrs_dict];
+  for (const Style& style : styles_) {
+    NSRange range = ToNSRange(text_, style.start, style.end);
+    if (style.font)
+      [native_ addAttribute:NSFontAttributeName
+                      value:style.font->GetNative()
+                      range:range];
+    if (style.has_color)
+      [native_ addAttribute:NSForegroundColorAttributeName
+                      value:style.color.ToNSColor()
+                      range:range];
+  }
+}
+
+void AttributedText::PlatformDestroy() {
+  [native_ release];
+}
+
+}  // namespace nu
@@ -6,6 +6,7 @@
 #define NATIVEUI_GFX_MAC_PAINTER_MAC_H_
 
 #include <string>
+#include <vector>
 
 #include "nativeui/gfx/painter.h"
 
@@ -57,14 +58,24 @@ class PainterMac : public Painter {
                           const TextAttributes& attributes) override;
   void DrawText(const std::string& text, const RectF& rect,
                 const TextAttributes& attributes) override;
+  void DrawAttributedText(AttributedText* text, const RectF& rect) override;
+  void DrawTextBatch(const std::vector<TextRun>& runs) override;
+  float GetScaleFactor() const override;
 
  private:
+  // Draw |text| in current graphics context.
+  void ShowAttributedText(AttributedText* text, const RectF& rect);
+
   // APIs of Core Graphics operate on current context, while we don't set
   // current context for memory bitmap. So in order to support Canvas we have
   // to save the context object and do manual context switching.
   NSGraphicsContext* target_context_;
 
   CGContextRef context_;
+
+  // The device scale, which is not changed by the transforms of painter, same
+  // with the device scale of cairo surface on Linux.
+  float scale_factor_;
 };
 
 }  // namespace nu
@@ -6,6 +6,8 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <cmath>
+
 #include "base/mac/scoped_cftyperef.h"
 #include "base/mac/scoped_nsobject.h"
 #include "base/strings/sys_string_conversions.h"
@@ -59,12 +61,17 @@ PainterMac::PainterMac()
     : target_context_(nil),  // no context switching
       context_(reinterpret_cast<CGContextRef>(
                    [[NSGraphicsContext currentContext] graphicsPort])) {
+  // Views are only translated and flipped before drawing, so the size of one
+  // point in the backing store is the backing scale factor.
+  CGSize size = CGContextConvertSizeToDeviceSpace(context_, CGSizeMake(1, 1));
+  scale_factor_ = std::fabs(size.width);
 }
 
 PainterMac::PainterMac(NativeBitmap bitmap, float scale_factor)
     : target_context_([[NSGraphicsContext
           graphicsContextWithGraphicsPort:bitmap flipped:YES] retain]),
-      context_(bitmap) {
+      context_(bitmap),
+      scale_factor_(scale_factor) {
   // There is no way to directly set scale factor for NSGraphicsContext, so just
   // do scaling. The quality of image does not seem to be affected by this.
   Scale(Vector2dF(scale_factor, scale_factor));
@@ -263,4 +270,32 @@ void PainterMac::DrawText(const std::string& text, const RectF& rect,
   [str drawInRect:bounds.ToCGRect() withAttributes:attrs_dict];
 }
 
+void PainterMac::DrawAttributedText(AttributedText* text, const RectF& rect) {
+  GraphicsContextScope scoped(target_context_);
+  CGContextSaveGState(context_);
+  // Don't draw outside boundry.
+  ClipRect(rect);
+  ShowAttributedText(text, rect);
+  CGContextRestoreGState(context_);
+}
+
+void PainterMac::DrawTextBatch(const std::vector<TextRun>& runs) {
+  GraphicsContextScope scoped(target_context_);
+  for (const TextRun& run : runs)
+    ShowAttributedText(run.text.get(), run.rect);
+}
+
+float PainterMac::GetScaleFactor() const {
+  return scale_factor_;
+}
+
+void PainterMac::ShowAttributedText(AttributedText* text, const RectF& rect) {
+  // Horizontal alignment is done by paragraph style inside wrap width. The
+  // metrics are cached by |text| until it is changed.
+  SizeF size(text->GetWrapWidth() >= 0 ? text->GetWrapWidth() : rect.width(),
+             text->GetMetrics().size.height());
+  RectF bounds = GetTextBounds(rect, size, text->GetAttributes());
+  [text->GetNative() drawInRect:bounds.ToCGRect()];
+}
+
 }  // namespace nu
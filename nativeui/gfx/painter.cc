@@ -4,10 +4,212 @@
 
 #include "nativeui/gfx/painter.h"
 
+#include <string.h>
+
+#include <cmath>
+
+#include "nativeui/buffer.h"
+#include "nativeui/gfx/image_atlas.h"
+#include "nativeui/gfx/image_set.h"
+
 namespace nu {
 
+namespace {
+
+// The largest number of arguments a command takes.
+const int kMaxArguments = 6;
+
+// Return how many arguments the |opcode| takes, or -1 for unknown opcodes.
+int GetArgumentsCount(float opcode) {
+  if (!(opcode >= static_cast<float>(PainterCommand::Save) &&
+        opcode <= static_cast<float>(PainterCommand::FillRect)) ||
+      opcode != std::floor(opcode))
+    return -1;
+  switch (static_cast<PainterCommand>(static_cast<int>(opcode))) {
+    case PainterCommand::Save:
+    case PainterCommand::Restore:
+    case PainterCommand::BeginPath:
+    case PainterCommand::ClosePath:
+    case PainterCommand::Clip:
+    case PainterCommand::Stroke:
+    case PainterCommand::Fill:
+      return 0;
+    case PainterCommand::Rotate:
+    case PainterCommand::SetLineWidth:
+      return 1;
+    case PainterCommand::MoveTo:
+    case PainterCommand::LineTo:
+    case PainterCommand::Translate:
+    case PainterCommand::Scale:
+      return 2;
+    case PainterCommand::Rect:
+    case PainterCommand::ClipRect:
+    case PainterCommand::StrokeRect:
+    case PainterCommand::FillRect:
+    case PainterCommand::SetColor:
+    case PainterCommand::SetStrokeColor:
+    case PainterCommand::SetFillColor:
+      return 4;
+    case PainterCommand::Arc:
+      return 5;
+    case PainterCommand::BezierCurveTo:
+      return 6;
+  }
+  return -1;
+}
+
+bool IsColorCommand(PainterCommand command) {
+  return command == PainterCommand::SetColor ||
+         command == PainterCommand::SetStrokeColor ||
+         command == PainterCommand::SetFillColor;
+}
+
+// The buffer passed from scripts is not necessarily aligned.
+inline float ReadFloat(const uint8_t* data, size_t index) {
+  float value;
+  memcpy(&value, data + index * sizeof(float), sizeof(float));
+  return value;
+}
+
+// Check the opcodes and arguments, and that Restore never goes beyond the
+// state saved in the stream.
+bool ValidateCommands(const uint8_t* data, size_t count) {
+  int depth = 0;
+  size_t i = 0;
+  while (i < count) {
+    float opcode = ReadFloat(data, i++);
+    int argc = GetArgumentsCount(opcode);
+    if (argc < 0 || count - i < static_cast<size_t>(argc))
+      return false;
+    auto command = static_cast<PainterCommand>(static_cast<int>(opcode));
+    for (int j = 0; j < argc; ++j) {
+      float value = ReadFloat(data, i + j);
+      if (!std::isfinite(value))
+        return false;
+      if (IsColorCommand(command) && (value < 0 || value > 255))
+        return false;
+    }
+    if (command == PainterCommand::Save)
+      ++depth;
+    else if (command == PainterCommand::Restore && --depth < 0)
+      return false;
+    i += argc;
+  }
+  return true;
+}
+
+inline Color ToColor(const float* args) {
+  return Color(static_cast<unsigned>(args[0]), static_cast<unsigned>(args[1]),
+               static_cast<unsigned>(args[2]), static_cast<unsigned>(args[3]));
+}
+
+}  // namespace
+
 Painter::Painter() : weak_factory_(this) {}
 
 Painter::~Painter() {}
 
+void Painter::DrawImageSet(ImageSet* set, const RectF& rect) {
+  Image* image = set->GetImageForScale(GetScaleFactor());
+  if (image)
+    DrawImage(image, rect);
+}
+
+void Painter::DrawAtlasImage(AtlasImage* image, const RectF& rect) {
+  DrawCanvasFromRect(image->GetAtlas()->GetCanvas(), image->GetRect(), rect);
+}
+
+void Painter::DrawTextBatch(const std::vector<TextRun>& runs) {
+  for (const TextRun& run : runs)
+    DrawAttributedText(run.text.get(), run.rect);
+}
+
+bool Painter::ExecuteCommands(const Buffer& buffer) {
+  if (buffer.size() % sizeof(float) != 0)
+    return false;
+  const uint8_t* data = static_cast<const uint8_t*>(buffer.content());
+  size_t count = buffer.size() / sizeof(float);
+  if (!ValidateCommands(data, count))
+    return false;
+
+  float a[kMaxArguments];
+  size_t i = 0;
+  while (i < count) {
+    float opcode = ReadFloat(data, i++);
+    int argc = GetArgumentsCount(opcode);
+    for (int j = 0; j < argc; ++j)
+      a[j] = ReadFloat(data, i++);
+    switch (static_cast<PainterCommand>(static_cast<int>(opcode))) {
+      case PainterCommand::Save:
+        Save();
+        break;
+      case PainterCommand::Restore:
+        Restore();
+        break;
+      case PainterCommand::BeginPath:
+        BeginPath();
+        break;
+      case PainterCommand::ClosePath:
+        ClosePath();
+        break;
+      case PainterCommand::MoveTo:
+        MoveTo(PointF(a[0], a[1]));
+        break;
+      case PainterCommand::LineTo:
+        LineTo(PointF(a[0], a[1]));
+        break;
+      case PainterCommand::BezierCurveTo:
+        BezierCurveTo(PointF(a[0], a[1]), PointF(a[2], a[3]),
+                      PointF(a[4], a[5]));
+        break;
+      case PainterCommand::Arc:
+        Arc(PointF(a[0], a[1]), a[2], a[3], a[4]);
+        break;
+      case PainterCommand::Rect:
+        Rect(RectF(a[0], a[1], a[2], a[3]));
+        break;
+      case PainterCommand::Clip:
+        Clip();
+        break;
+      case PainterCommand::ClipRect:
+        ClipRect(RectF(a[0], a[1], a[2], a[3]));
+        break;
+      case PainterCommand::Translate:
+        Translate(Vector2dF(a[0], a[1]));
+        break;
+      case PainterCommand::Rotate:
+        Rotate(a[0]);
+        break;
+      case PainterCommand::Scale:
+        Scale(Vector2dF(a[0], a[1]));
+        break;
+      case PainterCommand::SetColor:
+        SetColor(ToColor(a));
+        break;
+      case PainterCommand::SetStrokeColor:
+        SetStrokeColor(ToColor(a));
+        break;
+      case PainterCommand::SetFillColor:
+        SetFillColor(ToColor(a));
+        break;
+      case PainterCommand::SetLineWidth:
+        SetLineWidth(a[0]);
+        break;
+      case PainterCommand::Stroke:
+        Stroke();
+        break;
+      case PainterCommand::Fill:
+        Fill();
+        break;
+      case PainterCommand::StrokeRect:
+        StrokeRect(RectF(a[0], a[1], a[2], a[3]));
+        break;
+      case PainterCommand::FillRect:
+        FillRect(RectF(a[0], a[1], a[2], a[3]));
+        break;
+    }
+  }
+  return true;
+}
+
 }  // namespace nu
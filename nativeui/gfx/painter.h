@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "nativeui/gfx/attributed_text.h"
 #include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/text.h"
 #include "nativeui/types.h"
@@ -19,8 +21,41 @@
 
 namespace nu {
 
+class AtlasImage;
+class Buffer;
 class Canvas;
 class Image;
+class ImageSet;
+
+// Opcodes of the command stream executed by Painter::ExecuteCommands.
+//
+// The stream is an array of native-endian 32-bit floats, each command is an
+// opcode followed by its arguments. Colors are passed as 4 numbers of alpha,
+// red, green and blue channels in the range of [0, 255].
+enum class PainterCommand {
+  Save = 1,           // no arguments
+  Restore,            // no arguments
+  BeginPath,          // no arguments
+  ClosePath,          // no arguments
+  MoveTo,             // x, y
+  LineTo,             // x, y
+  BezierCurveTo,      // cp1x, cp1y, cp2x, cp2y, x, y
+  Arc,                // x, y, radius, sa, ea
+  Rect,               // x, y, width, height
+  Clip,               // no arguments
+  ClipRect,           // x, y, width, height
+  Translate,          // x, y
+  Rotate,             // angle
+  Scale,              // x, y
+  SetColor,           // a, r, g, b
+  SetStrokeColor,     // a, r, g, b
+  SetFillColor,       // a, r, g, b
+  SetLineWidth,       // width
+  Stroke,             // no arguments
+  Fill,               // no arguments
+  StrokeRect,         // x, y, width, height
+  FillRect,           // x, y, width, height
+};
 
 // The interface for painting on canvas or window.
 class NATIVEUI_EXPORT Painter {
@@ -78,6 +113,13 @@ class NATIVEUI_EXPORT Painter {
   virtual void DrawImageFromRect(Image* image, const RectF& src,
                                  const RectF& dest) = 0;
 
+  // Draw the variant of |set| that matches the scale factor of painter.
+  void DrawImageSet(ImageSet* set, const RectF& rect);
+
+  // Draw |image| stored in ImageAtlas to fit |rect|, which only copies from
+  // the atlas's canvas.
+  void DrawAtlasImage(AtlasImage* image, const RectF& rect);
+
   // Copy content from a canvas.
   virtual void DrawCanvas(Canvas* canvas, const RectF& rect) = 0;
   virtual void DrawCanvasFromRect(Canvas* canvas, const RectF& src,
@@ -91,6 +133,22 @@ class NATIVEUI_EXPORT Painter {
   virtual void DrawText(const std::string& text, const RectF& rect,
                         const TextAttributes& attributes) = 0;
 
+  // Draw |text| bounded by |rect|, the layout of text is reused between draws.
+  virtual void DrawAttributedText(AttributedText* text, const RectF& rect) = 0;
+
+  // Draw many texts with one setup of drawing state, unlike
+  // DrawAttributedText the texts are not clipped to their rects.
+  virtual void DrawTextBatch(const std::vector<TextRun>& runs);
+
+  // Return the scale factor of the device being painted on, which is not
+  // affected by Scale.
+  virtual float GetScaleFactor() const = 0;
+
+  // Run the commands encoded in |buffer| with one call, see PainterCommand
+  // for the format. The whole stream is validated before executing, false
+  // is returned and nothing is drawn if the stream is malformed.
+  bool ExecuteCommands(const Buffer& buffer);
+
   base::WeakPtr<Painter> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
 
  protected:
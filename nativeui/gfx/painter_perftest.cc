@@ -0,0 +1,97 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PainterPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    canvas_ = new nu::Canvas(nu::SizeF(512, 512), 1.f);
+    painter_ = canvas_->GetPainter();
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Canvas> canvas_;
+  nu::Painter* painter_;
+};
+
+TEST_F(PainterPerfTest, DrawText) {
+  nu::TextAttributes attributes;
+  nu::RunPerfTest("Painter.DrawText.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i)
+      painter_->DrawText("The quick brown fox jumps over the lazy dog",
+                         nu::RectF(0, i * 5, 512, 20), attributes);
+  });
+}
+
+TEST_F(PainterPerfTest, DrawAttributedText) {
+  scoped_refptr<nu::AttributedText> text(new nu::AttributedText(
+      "The quick brown fox jumps over the lazy dog", nu::TextAttributes()));
+  nu::RunPerfTest("Painter.DrawAttributedText.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i)
+      painter_->DrawAttributedText(text.get(), nu::RectF(0, i * 5, 512, 20));
+  });
+  std::vector<nu::TextRun> runs;
+  for (int i = 0; i < 100; ++i)
+    runs.emplace_back(text.get(), nu::RectF(0, i * 5, 512, 20));
+  nu::RunPerfTest("Painter.DrawTextBatch.100", 100, [&]() {
+    painter_->DrawTextBatch(runs);
+  });
+}
+
+TEST_F(PainterPerfTest, MeasureText) {
+  nu::TextAttributes attributes;
+  nu::RunPerfTest("Painter.MeasureText.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i)
+      painter_->MeasureText("The quick brown fox jumps over the lazy dog",
+                            512, attributes);
+  });
+}
+
+TEST_F(PainterPerfTest, Path) {
+  nu::RunPerfTest("Painter.StrokePath.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i) {
+      painter_->BeginPath();
+      painter_->MoveTo(nu::PointF(0, i));
+      painter_->BezierCurveTo(nu::PointF(100, 0), nu::PointF(400, 512),
+                              nu::PointF(512, 512 - i));
+      painter_->LineTo(nu::PointF(256, 256));
+      painter_->ClosePath();
+      painter_->Stroke();
+    }
+  });
+  nu::RunPerfTest("Painter.FillRect.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i) {
+      painter_->SetFillColor(nu::Color(i, 0, 0));
+      painter_->FillRect(nu::RectF(i, i, 256, 256));
+    }
+  });
+}
+
+TEST_F(PainterPerfTest, DrawImage) {
+  base::FilePath exe_path;
+  PathService::Get(base::FILE_EXE, &exe_path);
+  base::FilePath path = exe_path.DirName().DirName().DirName()
+                                .Append(FILE_PATH_LITERAL("nativeui"))
+                                .Append(FILE_PATH_LITERAL("test"))
+                                .Append(FILE_PATH_LITERAL("fixtures"))
+                                .Append(FILE_PATH_LITERAL("static.png"));
+  scoped_refptr<nu::Image> image(new nu::Image(path));
+  nu::RunPerfTest("Painter.DrawImage.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i)
+      painter_->DrawImage(image.get(), nu::RectF(i, i, 128, 128));
+  });
+  scoped_refptr<nu::Canvas> source(new nu::Canvas(nu::SizeF(128, 128), 1.f));
+  nu::RunPerfTest("Painter.DrawCanvas.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i)
+      painter_->DrawCanvas(source.get(), nu::RectF(i, i, 128, 128));
+  });
+}
@@ -0,0 +1,177 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "nativeui/buffer.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Records the calls instead of drawing.
+class RecordingPainter : public nu::Painter {
+ public:
+  RecordingPainter() {}
+
+  void Save() override { calls.push_back("Save"); }
+  void Restore() override { calls.push_back("Restore"); }
+  void BeginPath() override { calls.push_back("BeginPath"); }
+  void ClosePath() override { calls.push_back("ClosePath"); }
+  void MoveTo(const nu::PointF& p) override {
+    calls.push_back("MoveTo");
+    point = p;
+  }
+  void LineTo(const nu::PointF& p) override {
+    calls.push_back("LineTo");
+    point = p;
+  }
+  void BezierCurveTo(const nu::PointF& cp1,
+                     const nu::PointF& cp2,
+                     const nu::PointF& ep) override {
+    calls.push_back("BezierCurveTo");
+    point = ep;
+  }
+  void Arc(const nu::PointF& p, float radius, float sa, float ea) override {
+    calls.push_back("Arc");
+  }
+  void Rect(const nu::RectF& r) override {
+    calls.push_back("Rect");
+    rect = r;
+  }
+  void Clip() override { calls.push_back("Clip"); }
+  void ClipRect(const nu::RectF& r) override { calls.push_back("ClipRect"); }
+  void Translate(const nu::Vector2dF& offset) override {
+    calls.push_back("Translate");
+  }
+  void Rotate(float angle) override { calls.push_back("Rotate"); }
+  void Scale(const nu::Vector2dF& scale) override { calls.push_back("Scale"); }
+  void SetColor(nu::Color c) override {
+    calls.push_back("SetColor");
+    color = c;
+  }
+  void SetStrokeColor(nu::Color c) override {
+    calls.push_back("SetStrokeColor");
+  }
+  void SetFillColor(nu::Color c) override {
+    calls.push_back("SetFillColor");
+    color = c;
+  }
+  void SetLineWidth(float width) override { calls.push_back("SetLineWidth"); }
+  void Stroke() override { calls.push_back("Stroke"); }
+  void Fill() override { calls.push_back("Fill"); }
+  void StrokeRect(const nu::RectF& r) override {
+    calls.push_back("StrokeRect");
+  }
+  void FillRect(const nu::RectF& r) override {
+    calls.push_back("FillRect");
+    rect = r;
+  }
+  void DrawImage(nu::Image* image, const nu::RectF& r) override {}
+  void DrawImageFromRect(nu::Image* image, const nu::RectF& src,
+                         const nu::RectF& dest) override {}
+  void DrawCanvas(nu::Canvas* canvas, const nu::RectF& r) override {}
+  void DrawCanvasFromRect(nu::Canvas* canvas, const nu::RectF& src,
+                          const nu::RectF& dest) override {}
+  nu::TextMetrics MeasureText(const std::string& text, float width,
+                              const nu::TextAttributes& attributes) override {
+    return nu::TextMetrics();
+  }
+  void DrawText(const std::string& text, const nu::RectF& r,
+                const nu::TextAttributes& attributes) override {}
+  void DrawAttributedText(nu::AttributedText* text,
+                          const nu::RectF& r) override {
+    calls.push_back("DrawAttributedText");
+    rect = r;
+  }
+  float GetScaleFactor() const override { return 1.f; }
+
+  std::vector<std::string> calls;
+  nu::PointF point;
+  nu::RectF rect;
+  nu::Color color;
+};
+
+float Op(nu::PainterCommand command) {
+  return static_cast<float>(command);
+}
+
+bool Execute(nu::Painter* painter, const std::vector<float>& commands) {
+  return painter->ExecuteCommands(nu::Buffer::Wrap(
+      commands.data(), commands.size() * sizeof(float)));
+}
+
+}  // namespace
+
+TEST(PainterTest, ExecuteCommands) {
+  RecordingPainter painter;
+  EXPECT_TRUE(Execute(&painter, {
+      Op(nu::PainterCommand::Save),
+      Op(nu::PainterCommand::BeginPath),
+      Op(nu::PainterCommand::MoveTo), 1, 2,
+      Op(nu::PainterCommand::LineTo), 3, 4,
+      Op(nu::PainterCommand::Stroke),
+      Op(nu::PainterCommand::SetFillColor), 255, 1, 2, 3,
+      Op(nu::PainterCommand::FillRect), 1, 2, 3, 4,
+      Op(nu::PainterCommand::Restore),
+  }));
+  std::vector<std::string> expected = {
+      "Save", "BeginPath", "MoveTo", "LineTo", "Stroke", "SetFillColor",
+      "FillRect", "Restore",
+  };
+  EXPECT_EQ(painter.calls, expected);
+  EXPECT_EQ(painter.point, nu::PointF(3, 4));
+  EXPECT_EQ(painter.rect, nu::RectF(1, 2, 3, 4));
+  EXPECT_EQ(painter.color, nu::Color(255, 1, 2, 3));
+}
+
+TEST(PainterTest, ExecuteEmptyCommands) {
+  RecordingPainter painter;
+  EXPECT_TRUE(Execute(&painter, {}));
+  EXPECT_TRUE(painter.calls.empty());
+}
+
+TEST(PainterTest, MalformedCommands) {
+  RecordingPainter painter;
+  // Unknown opcodes.
+  EXPECT_FALSE(Execute(&painter, {0}));
+  EXPECT_FALSE(Execute(&painter, {1.5}));
+  EXPECT_FALSE(Execute(&painter, {1000}));
+  // Missing arguments.
+  EXPECT_FALSE(Execute(&painter, {Op(nu::PainterCommand::MoveTo), 1}));
+  // Invalid numbers.
+  EXPECT_FALSE(Execute(&painter, {Op(nu::PainterCommand::LineTo),
+                                  1, std::numeric_limits<float>::infinity()}));
+  EXPECT_FALSE(Execute(&painter, {Op(nu::PainterCommand::SetColor),
+                                  256, 0, 0, 0}));
+  // Unbalanced restore.
+  EXPECT_FALSE(Execute(&painter, {Op(nu::PainterCommand::Restore)}));
+  // Nothing is drawn when any command is malformed.
+  EXPECT_FALSE(Execute(&painter, {Op(nu::PainterCommand::BeginPath),
+                                  Op(nu::PainterCommand::Restore)}));
+  EXPECT_TRUE(painter.calls.empty());
+  // Size is not aligned to floats.
+  std::string bytes(5, '\0');
+  EXPECT_FALSE(painter.ExecuteCommands(
+      nu::Buffer::Wrap(bytes.data(), bytes.size())));
+}
+
+TEST(PainterTest, DrawTextBatch) {
+  nu::Lifetime lifetime;
+  nu::State state;
+  RecordingPainter painter;
+  scoped_refptr<nu::AttributedText> text(
+      new nu::AttributedText("text", nu::TextAttributes()));
+  painter.DrawTextBatch({
+      nu::TextRun(text.get(), nu::RectF(0, 0, 10, 10)),
+      nu::TextRun(text.get(), nu::RectF(0, 10, 10, 10)),
+  });
+  std::vector<std::string> expected = {
+      "DrawAttributedText", "DrawAttributedText",
+  };
+  EXPECT_EQ(painter.calls, expected);
+  EXPECT_EQ(painter.rect, nu::RectF(0, 10, 10, 10));
+}
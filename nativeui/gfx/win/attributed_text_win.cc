@@ -0,0 +1,42 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/attributed_text.h"
+
+#include <float.h>
+
+#include "base/strings/utf_string_conversions.h"
+#include "base/win/scoped_hdc.h"
+#include "nativeui/gfx/font.h"
+#include "nativeui/gfx/win/attributed_text_win.h"
+#include "nativeui/gfx/win/gdiplus.h"
+
+namespace nu {
+
+TextMetrics AttributedText::PlatformGetMetrics() {
+  AttributedTextImpl* impl = GetNative();
+  base::win::ScopedGetDC dc(NULL);
+  Gdiplus::Graphics graphics(dc);
+  Gdiplus::RectF rect;
+  Gdiplus::StringFormat format;
+  float width = wrap_width_ < 0 ? FLT_MAX : wrap_width_;
+  graphics.MeasureString(impl->text.c_str(),
+                         static_cast<int>(impl->text.length()),
+                         attributes_.font->GetNative(),
+                         Gdiplus::RectF(0.f, 0.f, width, FLT_MAX),
+                         &format, &rect, nullptr, nullptr);
+  return { SizeF(rect.Width, rect.Height) };
+}
+
+void AttributedText::PlatformUpdate() {
+  if (!native_)
+    native_ = new AttributedTextImpl;
+  native_->text = base::UTF8ToUTF16(text_);
+}
+
+void AttributedText::PlatformDestroy() {
+  delete native_;
+}
+
+}  // namespace nu
@@ -0,0 +1,20 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_WIN_ATTRIBUTED_TEXT_WIN_H_
+#define NATIVEUI_GFX_WIN_ATTRIBUTED_TEXT_WIN_H_
+
+#include "base/strings/string16.h"
+
+namespace nu {
+
+// GDI+ does not have reusable text layouts, only the converted text is kept.
+// Styled ranges are not supported.
+struct AttributedTextImpl {
+  base::string16 text;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_WIN_ATTRIBUTED_TEXT_WIN_H_
@@ -18,6 +18,7 @@
 #include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/gfx/geometry/vector2d_conversions.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/win/attributed_text_win.h"
 #include "nativeui/state.h"
 
 namespace nu {
@@ -230,6 +231,22 @@ void PainterWin::DrawText(const std::string& text, const RectF& rect,
                 ToEnclosingRect(ScaleRect(rect, scale_factor_)), attributes);
 }
 
+void PainterWin::DrawAttributedText(AttributedText* text, const RectF& rect) {
+  RectF bounds(rect);
+  // Lines are aligned inside wrap width.
+  if (text->GetWrapWidth() >= 0) {
+    bounds = GetTextBounds(rect, SizeF(text->GetWrapWidth(), rect.height()),
+                           text->GetAttributes());
+  }
+  DrawTextPixel(text->GetNative()->text,
+                ToEnclosingRect(ScaleRect(bounds, scale_factor_)),
+                text->GetAttributes());
+}
+
+float PainterWin::GetScaleFactor() const {
+  return scale_factor_;
+}
+
 void PainterWin::MoveToPixel(const PointF& point) {
   path_.StartFigure();
   use_gdi_current_point_ = false;
@@ -67,6 +67,8 @@ class PainterWin : public Painter {
                           const TextAttributes& attributes) override;
   void DrawText(const std::string& text, const RectF& rect,
                 const TextAttributes& attributes) override;
+  void DrawAttributedText(AttributedText* text, const RectF& rect) override;
+  float GetScaleFactor() const override;
 
   // The pixel versions.
   void MoveToPixel(const PointF& point);
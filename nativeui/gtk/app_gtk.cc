@@ -9,9 +9,11 @@
 #include <gdk/gdk.h>
 #include <gtk/gtk.h>
 
+#include "base/bind.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
+#include "base/threading/thread.h"
 #include "nativeui/gtk/widget_util.h"
 
 #if GTK_MAJOR_VERSION > 2
@@ -180,8 +182,42 @@ Color GetFgColor(const std::string& css_selector) {
   return color;
 }
 
+// Load the font into a private font map, which initializes fontconfig and
+// fills its caches that are shared with the font maps of main thread.
+void LoadFontInBackground(const std::string& font_name) {
+  PangoFontMap* font_map = pango_cairo_font_map_new();
+  PangoContext* context = pango_font_map_create_context(font_map);
+  PangoFontDescription* desc =
+      pango_font_description_from_string(font_name.c_str());
+  PangoFontset* fontset = pango_font_map_load_fontset(
+      font_map, context, desc, pango_language_get_default());
+  if (fontset)
+    g_object_unref(fontset);
+  pango_font_description_free(desc);
+  g_object_unref(context);
+  g_object_unref(font_map);
+}
+
 }  // namespace
 
+void App::WarmupFonts() {
+  if (font_warmup_thread_)
+    return;
+  // GTK settings can only be read on main thread.
+  std::string font_name = GetDefaultFontName();
+  font_warmup_thread_.reset(new base::Thread("FontWarmup"));
+  font_warmup_thread_->Start();
+  font_warmup_thread_->task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&LoadFontInBackground, font_name));
+}
+
+void App::WaitForFontWarmup() {
+  // Stopping the thread waits for the pending task, it returns immediately
+  // if the warmup has finished.
+  if (font_warmup_thread_ && font_warmup_thread_->IsRunning())
+    font_warmup_thread_->Stop();
+}
+
 Color App::PlatformGetColor(ThemeColor name) {
   if (name == ThemeColor::Text)
     return GetFgColor("GtkLabel");
@@ -0,0 +1,244 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/frame_stats_recorder.h"
+
+#include <algorithm>
+
+#include "base/strings/stringprintf.h"
+
+namespace nu {
+
+namespace {
+
+// How many frames to keep for finding the slowest on_draw handler.
+const size_t kRecentFrameCount = 120;
+
+// Number of buckets in the frame interval histogram, the last bucket collects
+// all the frames that are even slower.
+const int kHistogramBuckets = 8;
+
+// Frame intervals longer than this are treated as idle periods instead of slow
+// frames, since GTK only draws when something has changed.
+const gint64 kIdleInterval = 250 * G_TIME_SPAN_MILLISECOND;
+
+// Refresh interval used when the frame clock does not know it.
+const gint64 kDefaultRefreshInterval = 16667;
+
+inline float ToMilliseconds(gint64 us) {
+  return static_cast<float>(us) / G_TIME_SPAN_MILLISECOND;
+}
+
+}  // namespace
+
+FrameStatsRecorder::FrameStatsRecorder(GtkWidget* window)
+    : window_(window), histogram_(kHistogramBuckets, 0) {
+  window_handlers_.push_back(g_signal_connect(
+      window_, "realize", G_CALLBACK(OnRealize), this));
+  window_handlers_.push_back(g_signal_connect(
+      window_, "unrealize", G_CALLBACK(OnUnrealize), this));
+  window_handlers_.push_back(g_signal_connect(
+      window_, "draw", G_CALLBACK(OnDrawBegin), this));
+  window_handlers_.push_back(g_signal_connect_after(
+      window_, "draw", G_CALLBACK(OnDrawEnd), this));
+  if (gtk_widget_get_realized(window_))
+    ConnectFrameClock();
+}
+
+FrameStatsRecorder::~FrameStatsRecorder() {
+  DisconnectFrameClock();
+  // The recorder may be destroyed together with the window, in which case the
+  // signal handlers have already been removed.
+  for (gulong id : window_handlers_) {
+    if (g_signal_handler_is_connected(window_, id))
+      g_signal_handler_disconnect(window_, id);
+  }
+}
+
+void FrameStatsRecorder::RecordLayout(gint64 duration) {
+  layout_count_++;
+  total_layout_ += duration;
+  max_layout_ = std::max(max_layout_, duration);
+}
+
+void FrameStatsRecorder::RecordDrawHandler(View* view, gint64 duration) {
+  if (duration > current_slowest_.duration) {
+    // The allocation is relative to the parent GdkWindow, which is not always
+    // the toplevel's window.
+    GtkWidget* widget = view->GetNative();
+    int x = 0, y = 0;
+    gtk_widget_translate_coordinates(widget, window_, 0, 0, &x, &y);
+    current_slowest_.class_name = view->GetClassName();
+    current_slowest_.bounds = RectF(x, y,
+                                    gtk_widget_get_allocated_width(widget),
+                                    gtk_widget_get_allocated_height(widget));
+    current_slowest_.duration = duration;
+  }
+}
+
+void FrameStatsRecorder::Reset() {
+  frame_count_ = 0;
+  dropped_frames_ = 0;
+  std::fill(histogram_.begin(), histogram_.end(), 0);
+  first_frame_time_ = last_frame_time_ = 0;
+  total_paint_ = max_paint_ = 0;
+  paint_count_ = 0;
+  total_layout_ = max_layout_ = 0;
+  layout_count_ = 0;
+  current_slowest_ = SlowestDraw();
+  recent_slowest_.clear();
+}
+
+Window::FrameStats FrameStatsRecorder::GetStats() const {
+  Window::FrameStats stats;
+  stats.frame_count = frame_count_;
+  stats.dropped_frames = dropped_frames_;
+  stats.frame_interval_histogram = histogram_;
+  if (frame_count_ > 1 && last_frame_time_ > first_frame_time_)
+    stats.fps = (frame_count_ - 1) * static_cast<float>(G_TIME_SPAN_SECOND) /
+                (last_frame_time_ - first_frame_time_);
+  if (paint_count_ > 0)
+    stats.average_paint_duration = ToMilliseconds(total_paint_) / paint_count_;
+  stats.max_paint_duration = ToMilliseconds(max_paint_);
+  if (layout_count_ > 0)
+    stats.average_layout_duration =
+        ToMilliseconds(total_layout_) / layout_count_;
+  stats.max_layout_duration = ToMilliseconds(max_layout_);
+  for (const SlowestDraw& draw : recent_slowest_) {
+    if (ToMilliseconds(draw.duration) > stats.slowest_draw_duration) {
+      stats.slowest_draw_class_name = draw.class_name;
+      stats.slowest_draw_bounds = draw.bounds;
+      stats.slowest_draw_duration = ToMilliseconds(draw.duration);
+    }
+  }
+  return stats;
+}
+
+// static
+void FrameStatsRecorder::OnRealize(GtkWidget* widget,
+                                   FrameStatsRecorder* self) {
+  self->ConnectFrameClock();
+}
+
+// static
+void FrameStatsRecorder::OnUnrealize(GtkWidget* widget,
+                                     FrameStatsRecorder* self) {
+  self->DisconnectFrameClock();
+}
+
+// static
+void FrameStatsRecorder::OnAfterPaint(GdkFrameClock* clock,
+                                      FrameStatsRecorder* self) {
+  // Remember the slowest on_draw handler of this frame.
+  if (self->current_slowest_.class_name) {
+    self->recent_slowest_.push_back(self->current_slowest_);
+    self->current_slowest_ = SlowestDraw();
+  } else {
+    self->recent_slowest_.emplace_back();
+  }
+  if (self->recent_slowest_.size() > kRecentFrameCount)
+    self->recent_slowest_.pop_front();
+
+  gint64 frame_time = gdk_frame_clock_get_frame_time(clock);
+  gint64 interval = frame_time - self->last_frame_time_;
+  if (self->last_frame_time_ == 0 || interval > kIdleInterval) {
+    // Start of a new series of frames.
+    if (self->first_frame_time_ == 0)
+      self->first_frame_time_ = frame_time;
+    self->last_frame_time_ = frame_time;
+    self->frame_count_++;
+    return;
+  }
+
+  gint64 refresh_interval = 0;
+  gdk_frame_clock_get_refresh_info(clock, frame_time,
+                                   &refresh_interval, nullptr);
+  if (refresh_interval <= 0)
+    refresh_interval = kDefaultRefreshInterval;
+
+  // The N-th bucket counts frames that took N+1 refresh intervals, and all
+  // but the first interval were dropped.
+  int intervals = static_cast<int>(
+      (interval + refresh_interval / 2) / refresh_interval);
+  intervals = std::max(intervals, 1);
+  self->histogram_[std::min(intervals, kHistogramBuckets) - 1]++;
+  self->dropped_frames_ += intervals - 1;
+  self->frame_count_++;
+  self->last_frame_time_ = frame_time;
+}
+
+// static
+gboolean FrameStatsRecorder::OnDrawBegin(GtkWidget* widget, cairo_t* cr,
+                                         FrameStatsRecorder* self) {
+  self->paint_start_ = g_get_monotonic_time();
+  return FALSE;
+}
+
+// static
+gboolean FrameStatsRecorder::OnDrawEnd(GtkWidget* widget, cairo_t* cr,
+                                       FrameStatsRecorder* self) {
+  if (self->paint_start_ > 0) {
+    gint64 duration = g_get_monotonic_time() - self->paint_start_;
+    self->paint_start_ = 0;
+    self->paint_count_++;
+    self->total_paint_ += duration;
+    self->max_paint_ = std::max(self->max_paint_, duration);
+  }
+  if (self->overlay_visible_)
+    self->DrawOverlay(cr);
+  return FALSE;
+}
+
+void FrameStatsRecorder::ConnectFrameClock() {
+  GdkFrameClock* clock = gtk_widget_get_frame_clock(window_);
+  if (!clock || clock == frame_clock_)
+    return;
+  DisconnectFrameClock();
+  frame_clock_ = GDK_FRAME_CLOCK(g_object_ref(clock));
+  after_paint_handler_ = g_signal_connect(
+      frame_clock_, "after-paint", G_CALLBACK(OnAfterPaint), this);
+}
+
+void FrameStatsRecorder::DisconnectFrameClock() {
+  if (!frame_clock_)
+    return;
+  g_signal_handler_disconnect(frame_clock_, after_paint_handler_);
+  g_object_unref(frame_clock_);
+  frame_clock_ = nullptr;
+  after_paint_handler_ = 0;
+}
+
+void FrameStatsRecorder::DrawOverlay(cairo_t* cr) {
+  Window::FrameStats stats = GetStats();
+  std::string lines[] = {
+    base::StringPrintf("FPS: %.1f", stats.fps),
+    base::StringPrintf("Dropped: %d", stats.dropped_frames),
+    base::StringPrintf("Paint: %.2f ms", stats.average_paint_duration),
+    base::StringPrintf("Layout: %.2f ms", stats.average_layout_duration),
+  };
+
+  cairo_save(cr);
+  cairo_set_source_rgba(cr, 0, 0, 0, 0.6);
+  cairo_rectangle(cr, 4, 4, 130, 8 + 14 * arraysize(lines));
+  cairo_fill(cr);
+  cairo_set_source_rgb(cr, 1, 1, 1);
+  cairo_select_font_face(cr, "monospace", CAIRO_FONT_SLANT_NORMAL,
+                         CAIRO_FONT_WEIGHT_NORMAL);
+  cairo_set_font_size(cr, 11);
+  for (size_t i = 0; i < arraysize(lines); ++i) {
+    cairo_move_to(cr, 10, 20 + 14 * i);
+    cairo_show_text(cr, lines[i].c_str());
+  }
+  cairo_restore(cr);
+}
+
+FrameStatsRecorder* GetFrameStatsRecorder(GtkWidget* widget) {
+  GtkWidget* toplevel = gtk_widget_get_toplevel(widget);
+  if (!toplevel || !gtk_widget_is_toplevel(toplevel))
+    return nullptr;
+  return static_cast<FrameStatsRecorder*>(
+      g_object_get_data(G_OBJECT(toplevel), "frame-stats"));
+}
+
+}  // namespace nu
@@ -0,0 +1,91 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GTK_FRAME_STATS_RECORDER_H_
+#define NATIVEUI_GTK_FRAME_STATS_RECORDER_H_
+
+#include <gtk/gtk.h>
+
+#include <deque>
+#include <vector>
+
+#include "base/macros.h"
+#include "nativeui/window.h"
+
+namespace nu {
+
+// Collects frame timings of a GtkWindow through its GdkFrameClock.
+class FrameStatsRecorder {
+ public:
+  explicit FrameStatsRecorder(GtkWidget* window);
+  ~FrameStatsRecorder();
+
+  // Record durations measured in microseconds.
+  void RecordLayout(gint64 duration);
+  void RecordDrawHandler(View* view, gint64 duration);
+
+  void Reset();
+  Window::FrameStats GetStats() const;
+
+  void set_overlay_visible(bool visible) { overlay_visible_ = visible; }
+  bool overlay_visible() const { return overlay_visible_; }
+
+ private:
+  static void OnRealize(GtkWidget* widget, FrameStatsRecorder* self);
+  static void OnUnrealize(GtkWidget* widget, FrameStatsRecorder* self);
+  static void OnAfterPaint(GdkFrameClock* clock, FrameStatsRecorder* self);
+  static gboolean OnDrawBegin(GtkWidget* widget, cairo_t* cr,
+                              FrameStatsRecorder* self);
+  static gboolean OnDrawEnd(GtkWidget* widget, cairo_t* cr,
+                            FrameStatsRecorder* self);
+
+  void ConnectFrameClock();
+  void DisconnectFrameClock();
+  void DrawOverlay(cairo_t* cr);
+
+  // The slowest on_draw handler in a frame. Only the information needed for
+  // finding the view is kept, so closed views are not kept alive.
+  struct SlowestDraw {
+    const char* class_name = nullptr;
+    RectF bounds;
+    gint64 duration = 0;
+  };
+
+  GtkWidget* window_;
+  GdkFrameClock* frame_clock_ = nullptr;
+  std::vector<gulong> window_handlers_;
+  gulong after_paint_handler_ = 0;
+
+  bool overlay_visible_ = false;
+
+  // Accumulated stats.
+  int frame_count_ = 0;
+  int dropped_frames_ = 0;
+  std::vector<int> histogram_;
+  gint64 first_frame_time_ = 0;
+  gint64 last_frame_time_ = 0;
+  gint64 total_paint_ = 0;
+  gint64 max_paint_ = 0;
+  int paint_count_ = 0;
+  gint64 total_layout_ = 0;
+  gint64 max_layout_ = 0;
+  int layout_count_ = 0;
+
+  // State of current frame.
+  gint64 paint_start_ = 0;
+  SlowestDraw current_slowest_;
+
+  // Slowest on_draw handlers of recent frames.
+  std::deque<SlowestDraw> recent_slowest_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameStatsRecorder);
+};
+
+// Return the recorder of the toplevel window of |widget|, or nullptr if frame
+// stats are not enabled for the window.
+FrameStatsRecorder* GetFrameStatsRecorder(GtkWidget* widget);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GTK_FRAME_STATS_RECORDER_H_
@@ -0,0 +1,109 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/frame_stats_recorder.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class FrameStatsRecorderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetFrameStatsEnabled(true);
+    gtk_widget_realize(GTK_WIDGET(window_->GetNative()));
+  }
+
+  nu::Container* content() const {
+    return static_cast<nu::Container*>(window_->GetContentView());
+  }
+
+  nu::FrameStatsRecorder* recorder() const {
+    return nu::GetFrameStatsRecorder(GTK_WIDGET(window_->GetNative()));
+  }
+
+  // Finish current frame.
+  void EmitAfterPaint() {
+    GdkFrameClock* clock =
+        gtk_widget_get_frame_clock(GTK_WIDGET(window_->GetNative()));
+    ASSERT_TRUE(clock);
+    g_signal_emit_by_name(clock, "after-paint");
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+};
+
+TEST_F(FrameStatsRecorderTest, Layout) {
+  ASSERT_TRUE(recorder());
+  recorder()->RecordLayout(1000);
+  recorder()->RecordLayout(3000);
+  nu::Window::FrameStats stats = window_->GetFrameStats();
+  EXPECT_FLOAT_EQ(stats.average_layout_duration, 2);
+  EXPECT_FLOAT_EQ(stats.max_layout_duration, 3);
+  window_->ResetFrameStats();
+  stats = window_->GetFrameStats();
+  EXPECT_EQ(stats.average_layout_duration, 0);
+  EXPECT_EQ(stats.max_layout_duration, 0);
+}
+
+TEST_F(FrameStatsRecorderTest, SlowestDraw) {
+  scoped_refptr<nu::Container> view(new nu::Container);
+  content()->AddChildView(view.get());
+  recorder()->RecordDrawHandler(content(), 2000);
+  recorder()->RecordDrawHandler(view.get(), 5000);
+  EmitAfterPaint();
+  // Only the slowest handler of each frame is remembered.
+  recorder()->RecordDrawHandler(content(), 3000);
+  EmitAfterPaint();
+  nu::Window::FrameStats stats = window_->GetFrameStats();
+  EXPECT_EQ(stats.slowest_draw_class_name, nu::Container::kClassName);
+  EXPECT_FLOAT_EQ(stats.slowest_draw_duration, 5);
+  window_->ResetFrameStats();
+  EXPECT_TRUE(window_->GetFrameStats().slowest_draw_class_name.empty());
+}
+
+TEST_F(FrameStatsRecorderTest, VirtualScroll) {
+  scoped_refptr<nu::Scroll> scroll(new nu::Scroll);
+  content()->AddChildView(scroll.get());
+  recorder()->RecordDrawHandler(scroll.get(), 4000);
+  EmitAfterPaint();
+  nu::Window::FrameStats stats = window_->GetFrameStats();
+  EXPECT_EQ(stats.slowest_draw_class_name, nu::Scroll::kClassName);
+  EXPECT_FLOAT_EQ(stats.slowest_draw_duration, 4);
+}
+
+TEST_F(FrameStatsRecorderTest, SlowestDrawBoundsInWindow) {
+  // Views inside a Scroll are allocated relative to the window of viewport.
+  scoped_refptr<nu::Container> spacer(new nu::Container);
+  spacer->SetStyle("height", 50);
+  content()->AddChildView(spacer.get());
+  scoped_refptr<nu::Scroll> scroll(new nu::Scroll);
+  scroll->SetStyle("height", 100);
+  content()->AddChildView(scroll.get());
+  scoped_refptr<nu::Container> view(new nu::Container);
+  scroll->SetContentView(view.get());
+  scroll->SetContentSize(nu::SizeF(100, 20));
+  window_->SetContentSize(nu::SizeF(100, 200));
+  window_->SetVisible(true);
+  GtkWidget* toplevel = GTK_WIDGET(window_->GetNative());
+  int x = 0, y = 0;
+  ASSERT_TRUE(gtk_widget_translate_coordinates(
+      scroll->GetNative(), toplevel, 0, 0, &x, &y));
+  recorder()->RecordDrawHandler(view.get(), 2000);
+  EmitAfterPaint();
+  nu::RectF bounds = window_->GetFrameStats().slowest_draw_bounds;
+  EXPECT_GE(bounds.y(), y);
+  EXPECT_EQ(bounds.height(), 20);
+}
+
+TEST_F(FrameStatsRecorderTest, DoesNotKeepViews) {
+  scoped_refptr<nu::Container> view(new nu::Container);
+  content()->AddChildView(view.get());
+  recorder()->RecordDrawHandler(view.get(), 5000);
+  EmitAfterPaint();
+  content()->RemoveChildView(view.get());
+  EXPECT_TRUE(view->HasOneRef());
+  EXPECT_FLOAT_EQ(window_->GetFrameStats().slowest_draw_duration, 5);
+}
@@ -10,11 +10,26 @@
 
 namespace nu {
 
+namespace {
+
+// Labels inside containers are windowless, their events are hit-tested and
+// dispatched by the container that owns the event window. Other labels need
+// their own GdkWindow to receive input events.
+void OnParentSet(GtkWidget* widget, GtkWidget* old_parent, Label* label) {
+  if (gtk_widget_get_realized(widget))
+    return;
+  View* parent = label->GetParent();
+  gtk_widget_set_has_window(widget, !parent || !parent->IsContainer());
+}
+
+}  // namespace
+
 Label::Label(const std::string& text) {
   TakeOverView(gtk_label_new(text.c_str()));
   UpdateDefaultStyle();
   // Create GdkWindow for label, otherwise it can not receive input events.
   gtk_widget_set_has_window(GetNative(), true);
+  g_signal_connect(GetNative(), "parent-set", G_CALLBACK(OnParentSet), this);
 }
 
 Label::~Label() {
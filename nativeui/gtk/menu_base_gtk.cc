@@ -36,10 +36,21 @@ GtkRadioMenuItem* SearchRadioInSameGroup(MenuBase* menu, MenuItem* radio,
   return nullptr;
 }
 
+// The GtkMenu is shown right before it pops up.
+void OnMenuShow(GtkWidget* widget, MenuBase* menu) {
+  menu->on_will_open.Emit(menu);
+}
+
 }  // namespace
 
 void MenuBase::PlatformInit() {
-  gtk_widget_show(GTK_WIDGET(menu_));
+  if (GTK_IS_MENU(menu_)) {
+    // GTK shows and hides the popup menu when it pops up and down, so do not
+    // show it here otherwise the "show" signal would be missed the first time.
+    g_signal_connect(menu_, "show", G_CALLBACK(OnMenuShow), this);
+  } else {
+    gtk_widget_show(GTK_WIDGET(menu_));
+  }
   g_object_ref_sink(menu_);
 }
 
@@ -47,6 +47,13 @@ MessageLoop::TimerId MessageLoop::SetTimeout(int ms, const Task& task) {
                             new Task(task), Delete<Task>);
 }
 
+// static
+MessageLoop::TimerId MessageLoop::SetIdleTimeout(const Task& task) {
+  return g_idle_add_full(G_PRIORITY_DEFAULT_IDLE,
+                         reinterpret_cast<GSourceFunc>(OnSource),
+                         new Task(task), Delete<Task>);
+}
+
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
   g_source_remove(id);
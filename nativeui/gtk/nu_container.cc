@@ -6,6 +6,7 @@
 
 #include "nativeui/container.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/gtk/frame_stats_recorder.h"
 
 namespace nu {
 
@@ -69,13 +70,20 @@ static void nu_container_realize(GtkWidget* widget) {
 
   GTK_WIDGET_CLASS(nu_container_parent_class)->realize(widget);
 
+  // Containers inside containers do not need their own input window, their
+  // events are dispatched by the outermost container.
+  NUContainerPrivate* priv = NU_CONTAINER(widget)->priv;
+  View* parent = priv->delegate->GetParent();
+  if (parent && parent->IsContainer())
+    return;
+
   // Create invisible input window.
   GtkAllocation allocation;
   gtk_widget_get_allocation(widget, &allocation);
   GdkWindowAttr attributes;
   attributes.window_type = GDK_WINDOW_CHILD;
   attributes.x = allocation.x;
-  attributes.y = allocation.x;
+  attributes.y = allocation.y;
   attributes.width = allocation.width;
   attributes.height = allocation.height;
   attributes.wclass = GDK_INPUT_ONLY;
@@ -88,7 +96,6 @@ static void nu_container_realize(GtkWidget* widget) {
                           | GDK_LEAVE_NOTIFY_MASK
                           | GDK_KEY_PRESS_MASK
                           | GDK_KEY_RELEASE_MASK;
-  NUContainerPrivate* priv = NU_CONTAINER(widget)->priv;
   priv->event_window = gdk_window_new(window, &attributes, GDK_WA_X | GDK_WA_Y);
   gtk_widget_register_window(widget, priv->event_window);
   gdk_window_move_resize(priv->event_window,
@@ -167,8 +174,19 @@ static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
                         0, 0, width, height);
 
   Container* delegate = NU_CONTAINER(widget)->priv->delegate;
-  PainterGtk painter(cr);
-  delegate->on_draw.Emit(delegate, &painter, nu::RectF(0, 0, width, height));
+  if (!delegate->on_draw.IsEmpty() || delegate->ItemCount() > 0) {
+    PainterGtk painter(cr);
+    FrameStatsRecorder* recorder = GetFrameStatsRecorder(widget);
+    gint64 start = recorder ? g_get_monotonic_time() : 0;
+    delegate->on_draw.Emit(delegate, &painter, nu::RectF(0, 0, width, height));
+    // Only paint the items intersecting the damaged area.
+    GdkRectangle clip;
+    if (delegate->ItemCount() > 0 && gdk_cairo_get_clip_rectangle(cr, &clip))
+      delegate->DrawItems(&painter, RectF(clip.x, clip.y,
+                                          clip.width, clip.height));
+    if (recorder)
+      recorder->RecordDrawHandler(delegate, g_get_monotonic_time() - start);
+  }
 
   for (int i = 0; i < delegate->ChildCount(); ++i)
     gtk_container_propagate_draw(GTK_CONTAINER(widget),
@@ -4,16 +4,25 @@
 
 #include "nativeui/gtk/nu_custom_cell_renderer.h"
 
-#include "base/values.h"
+#include <string>
+
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/image_atlas.h"
+#include "nativeui/table_model.h"
 
 namespace nu {
 
-enum { PROP_VALUE = 1 };
+enum { PROP_CELL = 1 };
 
 struct _NUCustomCellRendererPrivate {
   Table::ColumnOptions options;
-  base::Value value;
+  // The cell is set before rendering, when the storage of model may have been
+  // reused for other cells, so strings and images are copied.
+  TableCell cell;
+  std::string text;
+  scoped_refptr<Image> image;
+  scoped_refptr<AtlasImage> atlas_image;
 };
 
 static void nu_custom_cell_renderer_class_init(
@@ -51,10 +60,10 @@ static void nu_custom_cell_renderer_class_init(NUCustomCellRendererClass* cl) {
   cell_class->render = nu_custom_cell_renderer_render;
 
   g_object_class_install_property(object_class,
-                                  PROP_VALUE,
-                                  g_param_spec_pointer("value",
-                                                       "Value",
-                                                       "The value to display",
+                                  PROP_CELL,
+                                  g_param_spec_pointer("cell",
+                                                       "Cell",
+                                                       "The cell to display",
                                                        G_PARAM_WRITABLE));
 }
 
@@ -62,7 +71,9 @@ static void nu_custom_cell_renderer_finalize(GObject* object) {
   // Call in-place destructor since we don't manage its memory.
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   priv->options.Table::ColumnOptions::~ColumnOptions();
-  priv->value.base::Value::~Value();
+  priv->text.std::string::~string();
+  priv->image.scoped_refptr<Image>::~scoped_refptr();
+  priv->atlas_image.scoped_refptr<AtlasImage>::~scoped_refptr();
 
   G_OBJECT_CLASS(nu_custom_cell_renderer_parent_class)->finalize(object);
 }
@@ -71,16 +82,27 @@ static void nu_custom_cell_renderer_set_property(GObject* object,
                                                  guint param_id,
                                                  const GValue* gval,
                                                  GParamSpec* pspec) {
-  if (param_id != PROP_VALUE) {
+  if (param_id != PROP_CELL) {
     G_OBJECT_WARN_INVALID_PROPERTY_ID(object, param_id, pspec);
     return;
   }
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
-  auto* value = static_cast<const base::Value*>(g_value_get_pointer(gval));
-  if (value)
-    priv->value = base::Value(value->Clone());
-  else
-    priv->value = base::Value();
+  auto* cell = static_cast<const TableCell*>(g_value_get_pointer(gval));
+  priv->image = nullptr;
+  priv->atlas_image = nullptr;
+  if (!cell) {
+    priv->cell = TableCell();
+  } else if (cell->is_string()) {
+    // Reuse the buffer to avoid allocating for every cell.
+    cell->GetString().CopyToString(&priv->text);
+    priv->cell = TableCell(base::StringPiece(priv->text));
+  } else {
+    if (cell->is_image())
+      priv->image = cell->GetImage();
+    else if (cell->is_atlas_image())
+      priv->atlas_image = cell->GetAtlasImage();
+    priv->cell = *cell;
+  }
 }
 
 static void nu_custom_cell_renderer_get_size(GtkCellRenderer* renderer,
@@ -107,7 +129,7 @@ static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
                                            const GdkRectangle* cell_area,
                                            GtkCellRendererState flags) {
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(cell)->priv;
-  if (!priv->options.on_draw)
+  if (!priv->options.HasDrawHandler())
     return;
 
   cairo_translate(cr, cell_area->x, cell_area->y);
@@ -115,16 +137,19 @@ static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
   cairo_clip(cr);
 
   PainterGtk painter(cr);
-  priv->options.on_draw(&painter,
-                        nu::RectF(0, 0, cell_area->width, cell_area->height),
-                        priv->value);
+  priv->options.Draw(&painter,
+                     nu::RectF(0, 0, cell_area->width, cell_area->height),
+                     priv->cell);
 }
 
 static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
   g_object_set(G_OBJECT(cell), "mode", GTK_CELL_RENDERER_MODE_INERT, nullptr);
   cell->priv = static_cast<NUCustomCellRendererPrivate*>(
       nu_custom_cell_renderer_get_instance_private(cell));
-  new(&cell->priv->value) base::Value();
+  new(&cell->priv->cell) TableCell();
+  new(&cell->priv->text) std::string();
+  new(&cell->priv->image) scoped_refptr<Image>();
+  new(&cell->priv->atlas_image) scoped_refptr<AtlasImage>();
 }
 
 GtkCellRenderer* nu_custom_cell_renderer_new(
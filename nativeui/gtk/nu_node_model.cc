@@ -0,0 +1,474 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/nu_node_model.h"
+
+#include <memory>
+#include <new>
+#include <unordered_set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nu {
+
+namespace {
+
+// A materialized node, the GtkTreeIter stores a pointer to it.
+struct NUNode {
+  TreeModel::NodeId id = TreeModel::kRootNode;
+  NUNode* parent = nullptr;
+  // The index in parent's children.
+  gint index = 0;
+  // Whether the children have been loaded by model.
+  bool loaded = false;
+  bool loading = false;
+  // Whether the |children| have been built from model.
+  bool children_built = false;
+  std::vector<std::unique_ptr<NUNode>> children;
+  // Callbacks waiting for the children to load.
+  std::vector<std::function<void()>> pending;
+};
+
+}  // namespace
+
+struct _NUNodeModelPrivate {
+  TreeModel* model;
+  NUNode root;
+  // Maps node IDs to materialized nodes.
+  std::unordered_map<TreeModel::NodeId, NUNode*> nodes;
+  // Changed when nodes are destroyed, so old iters become invalid.
+  gint stamp;
+};
+
+static void nu_node_model_tree_model_init(GtkTreeModelIface* iface);
+static void nu_node_model_finalize(GObject* obj);
+static GtkTreeModelFlags nu_node_model_get_flags(GtkTreeModel* tree_model);
+static gint nu_node_model_get_n_columns(GtkTreeModel* tree_model);
+static GType nu_node_model_get_column_type(GtkTreeModel* tree_model,
+                                           gint index);
+static gboolean nu_node_model_get_iter(GtkTreeModel* tree_model,
+                                       GtkTreeIter* iter,
+                                       GtkTreePath* path);
+static GtkTreePath* nu_node_model_get_path(GtkTreeModel* tree_model,
+                                           GtkTreeIter* iter);
+static void nu_node_model_get_value(GtkTreeModel* tree_model,
+                                    GtkTreeIter* iter,
+                                    gint column,
+                                    GValue* value);
+static gboolean nu_node_model_iter_next(GtkTreeModel* tree_model,
+                                        GtkTreeIter* iter);
+static gboolean nu_node_model_iter_previous(GtkTreeModel* tree_model,
+                                            GtkTreeIter* iter);
+static gboolean nu_node_model_iter_children(GtkTreeModel* tree_model,
+                                            GtkTreeIter* iter,
+                                            GtkTreeIter* parent);
+static gboolean nu_node_model_iter_has_child(GtkTreeModel* tree_model,
+                                             GtkTreeIter* iter);
+static gint nu_node_model_iter_n_children(GtkTreeModel* tree_model,
+                                          GtkTreeIter* iter);
+static gboolean nu_node_model_iter_nth_child(GtkTreeModel* tree_model,
+                                             GtkTreeIter* iter,
+                                             GtkTreeIter* parent,
+                                             gint n);
+static gboolean nu_node_model_iter_parent(GtkTreeModel* tree_model,
+                                          GtkTreeIter* iter,
+                                          GtkTreeIter* child);
+
+G_DEFINE_TYPE_WITH_CODE(NUNodeModel, nu_node_model, G_TYPE_OBJECT,
+                        G_ADD_PRIVATE(NUNodeModel)
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL,
+                                              nu_node_model_tree_model_init))
+
+// Helpers to convert between iters and nodes.
+static NUNode* GetNode(NUNodeModelPrivate* priv, GtkTreeIter* iter) {
+  if (!iter)
+    return &priv->root;
+  if (iter->stamp != priv->stamp)
+    return nullptr;
+  return static_cast<NUNode*>(iter->user_data);
+}
+
+static gboolean SetIter(NUNodeModelPrivate* priv,
+                        GtkTreeIter* iter,
+                        NUNode* node) {
+  if (!node) {
+    iter->stamp = 0;
+    return false;
+  }
+  iter->stamp = priv->stamp;
+  iter->user_data = node;
+  return true;
+}
+
+// Build the children of |node| from model, return false if the children are
+// not loaded yet.
+static bool EnsureChildren(NUNodeModelPrivate* priv, NUNode* node) {
+  if (!node->loaded)
+    return false;
+  if (node->children_built)
+    return true;
+  node->children_built = true;
+  uint32_t count = priv->model->GetChildCount(node->id);
+  node->children.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    std::unique_ptr<NUNode> child(new NUNode);
+    child->id = priv->model->GetChildAt(node->id, i);
+    child->parent = node;
+    child->index = i;
+    priv->nodes[child->id] = child.get();
+    node->children.push_back(std::move(child));
+  }
+  return true;
+}
+
+static NUNode* GetChildAt(NUNodeModelPrivate* priv, NUNode* node, gint n) {
+  if (!node || !EnsureChildren(priv, node))
+    return nullptr;
+  if (n < 0 || static_cast<size_t>(n) >= node->children.size())
+    return nullptr;
+  return node->children[n].get();
+}
+
+// Remove |node|'s descendants from the map.
+static void ForgetChildren(NUNodeModelPrivate* priv, NUNode* node) {
+  for (const auto& child : node->children) {
+    ForgetChildren(priv, child.get());
+    priv->nodes.erase(child->id);
+  }
+}
+
+// Called when model has loaded the children of |id|.
+static void OnChildrenLoaded(NUNodeModel* model, TreeModel::NodeId id) {
+  NUNodeModelPrivate* priv = model->priv;
+  auto it = priv->nodes.find(id);
+  if (it == priv->nodes.end() || it->second->loaded)
+    return;
+  NUNode* node = it->second;
+  // The expander may have been shown for a node without children.
+  bool is_root = node == &priv->root;
+  bool had_child = !is_root && priv->model->HasChildren(id);
+  node->loading = false;
+  node->loaded = true;
+  if (!is_root && had_child != (priv->model->GetChildCount(id) > 0)) {
+    GtkTreeIter iter;
+    SetIter(priv, &iter, node);
+    GtkTreePath* path = gtk_tree_model_get_path(GTK_TREE_MODEL(model), &iter);
+    gtk_tree_model_row_has_child_toggled(GTK_TREE_MODEL(model), path, &iter);
+    gtk_tree_path_free(path);
+  }
+  // The callbacks may change the node.
+  std::vector<std::function<void()>> pending;
+  pending.swap(node->pending);
+  for (const auto& callback : pending) {
+    if (callback)
+      callback();
+  }
+}
+
+static void nu_node_model_class_init(NUNodeModelClass* cl) {
+  G_OBJECT_CLASS(cl)->finalize = nu_node_model_finalize;
+}
+
+static void nu_node_model_tree_model_init(GtkTreeModelIface* iface) {
+  iface->get_flags = nu_node_model_get_flags;
+  iface->get_n_columns = nu_node_model_get_n_columns;
+  iface->get_column_type = nu_node_model_get_column_type;
+  iface->get_iter = nu_node_model_get_iter;
+  iface->get_path = nu_node_model_get_path;
+  iface->get_value = nu_node_model_get_value;
+  iface->iter_next = nu_node_model_iter_next;
+  iface->iter_previous = nu_node_model_iter_previous;
+  iface->iter_children = nu_node_model_iter_children;
+  iface->iter_has_child = nu_node_model_iter_has_child;
+  iface->iter_n_children = nu_node_model_iter_n_children;
+  iface->iter_nth_child = nu_node_model_iter_nth_child;
+  iface->iter_parent = nu_node_model_iter_parent;
+}
+
+static void nu_node_model_finalize(GObject* obj) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(obj)->priv;
+  priv->model->Release();
+  priv->~NUNodeModelPrivate();
+  G_OBJECT_CLASS(nu_node_model_parent_class)->finalize(obj);
+}
+
+static GtkTreeModelFlags nu_node_model_get_flags(GtkTreeModel* tree_model) {
+  return static_cast<GtkTreeModelFlags>(0);
+}
+
+static gint nu_node_model_get_n_columns(GtkTreeModel* tree_model) {
+  return 1;
+}
+
+static GType nu_node_model_get_column_type(GtkTreeModel* tree_model,
+                                           gint index) {
+  return G_TYPE_UINT64;
+}
+
+static gboolean nu_node_model_get_iter(GtkTreeModel* tree_model,
+                                       GtkTreeIter* iter,
+                                       GtkTreePath* path) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  gint depth = 0;
+  gint* indices = gtk_tree_path_get_indices_with_depth(path, &depth);
+  NUNode* node = &priv->root;
+  for (gint i = 0; i < depth && node; ++i)
+    node = GetChildAt(priv, node, indices[i]);
+  return SetIter(priv, iter, depth > 0 ? node : nullptr);
+}
+
+static GtkTreePath* nu_node_model_get_path(GtkTreeModel* tree_model,
+                                           GtkTreeIter* iter) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, iter);
+  if (!node)
+    return nullptr;
+  GtkTreePath* path = gtk_tree_path_new();
+  for (; node != &priv->root; node = node->parent)
+    gtk_tree_path_prepend_index(path, node->index);
+  return path;
+}
+
+static void nu_node_model_get_value(GtkTreeModel* tree_model,
+                                    GtkTreeIter* iter,
+                                    gint column,
+                                    GValue* value) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, iter);
+  if (!node)
+    return;
+  g_value_init(value, G_TYPE_UINT64);
+  g_value_set_uint64(value, node->id);
+}
+
+static gboolean nu_node_model_iter_next(GtkTreeModel* tree_model,
+                                        GtkTreeIter* iter) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, iter);
+  if (!node || node == &priv->root)
+    return SetIter(priv, iter, nullptr);
+  return SetIter(priv, iter, GetChildAt(priv, node->parent, node->index + 1));
+}
+
+static gboolean nu_node_model_iter_previous(GtkTreeModel* tree_model,
+                                            GtkTreeIter* iter) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, iter);
+  if (!node || node == &priv->root)
+    return SetIter(priv, iter, nullptr);
+  return SetIter(priv, iter, GetChildAt(priv, node->parent, node->index - 1));
+}
+
+static gboolean nu_node_model_iter_children(GtkTreeModel* tree_model,
+                                            GtkTreeIter* iter,
+                                            GtkTreeIter* parent) {
+  return nu_node_model_iter_nth_child(tree_model, iter, parent, 0);
+}
+
+static gboolean nu_node_model_iter_has_child(GtkTreeModel* tree_model,
+                                             GtkTreeIter* iter) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, iter);
+  if (!node)
+    return false;
+  if (node->children_built)
+    return !node->children.empty();
+  // Unloaded nodes show expanders when they may have children.
+  if (!node->loaded)
+    return priv->model->HasChildren(node->id);
+  return priv->model->GetChildCount(node->id) > 0;
+}
+
+static gint nu_node_model_iter_n_children(GtkTreeModel* tree_model,
+                                          GtkTreeIter* iter) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, iter);
+  if (!node || !EnsureChildren(priv, node))
+    return 0;
+  return static_cast<gint>(node->children.size());
+}
+
+static gboolean nu_node_model_iter_nth_child(GtkTreeModel* tree_model,
+                                             GtkTreeIter* iter,
+                                             GtkTreeIter* parent,
+                                             gint n) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  return SetIter(priv, iter, GetChildAt(priv, GetNode(priv, parent), n));
+}
+
+static gboolean nu_node_model_iter_parent(GtkTreeModel* tree_model,
+                                          GtkTreeIter* iter,
+                                          GtkTreeIter* child) {
+  NUNodeModelPrivate* priv = NU_NODE_MODEL(tree_model)->priv;
+  NUNode* node = GetNode(priv, child);
+  if (!node || !node->parent || node->parent == &priv->root)
+    return SetIter(priv, iter, nullptr);
+  return SetIter(priv, iter, node->parent);
+}
+
+static void nu_node_model_init(NUNodeModel* node_model) {
+  NUNodeModelPrivate* priv = static_cast<NUNodeModelPrivate*>(
+      nu_node_model_get_instance_private(node_model));
+  new(priv) NUNodeModelPrivate;
+  priv->model = nullptr;
+  priv->stamp = 1;
+  priv->nodes[TreeModel::kRootNode] = &priv->root;
+  node_model->priv = priv;
+}
+
+NUNodeModel* nu_node_model_new(TreeModel* model) {
+  void* obj = g_object_new(NU_TYPE_NODE_MODEL, nullptr);
+  model->AddRef();
+  NU_NODE_MODEL(obj)->priv->model = model;
+  return NU_NODE_MODEL(obj);
+}
+
+TreeModel::NodeId nu_node_model_get_node_id(NUNodeModel* model,
+                                            GtkTreeIter* iter) {
+  NUNode* node = GetNode(model->priv, iter);
+  return node ? node->id : TreeModel::kRootNode;
+}
+
+TableCell nu_node_model_get_cell(NUNodeModel* model,
+                                 GtkTreeIter* iter,
+                                 gint column) {
+  NUNode* node = GetNode(model->priv, iter);
+  if (!node)
+    return TableCell();
+  return model->priv->model->GetCell(column, node->id);
+}
+
+bool nu_node_model_get_iter(NUNodeModel* model,
+                            TreeModel::NodeId node,
+                            GtkTreeIter* iter) {
+  NUNodeModelPrivate* priv = model->priv;
+  auto it = priv->nodes.find(node);
+  if (it == priv->nodes.end() || it->second == &priv->root)
+    return SetIter(priv, iter, nullptr);
+  return SetIter(priv, iter, it->second);
+}
+
+void nu_node_model_load_children(NUNodeModel* model,
+                                 TreeModel::NodeId node,
+                                 const std::function<void()>& callback) {
+  NUNodeModelPrivate* priv = model->priv;
+  auto it = priv->nodes.find(node);
+  if (it == priv->nodes.end())
+    return;
+  if (it->second->loaded) {
+    if (callback)
+      callback();
+    return;
+  }
+  it->second->pending.push_back(callback);
+  if (it->second->loading)
+    return;
+  it->second->loading = true;
+  // The model may finish loading after the tree has gone, keep a reference
+  // until the callback is destroyed.
+  g_object_ref(model);
+  std::shared_ptr<NUNodeModel> ref(model, [](NUNodeModel* model) {
+    g_object_unref(model);
+  });
+  priv->model->LoadChildren(node, [ref, node]() {
+    OnChildrenLoaded(ref.get(), node);
+  });
+}
+
+bool nu_node_model_is_loaded(NUNodeModel* model, TreeModel::NodeId node) {
+  auto it = model->priv->nodes.find(node);
+  return it != model->priv->nodes.end() && it->second->loaded;
+}
+
+void nu_node_model_update_children(NUNodeModel* model,
+                                   TreeModel::NodeId node) {
+  NUNodeModelPrivate* priv = model->priv;
+  auto it = priv->nodes.find(node);
+  if (it == priv->nodes.end() || !it->second->loaded)
+    return;
+  NUNode* parent = it->second;
+  GtkTreeModel* tree_model = GTK_TREE_MODEL(model);
+  GtkTreeIter iter;
+  GtkTreePath* path = nullptr;
+  if (parent == &priv->root) {
+    path = gtk_tree_path_new();
+  } else {
+    SetIter(priv, &iter, parent);
+    path = gtk_tree_model_get_path(tree_model, &iter);
+  }
+  // Children that have not been built are only known by the expander.
+  bool had_child = parent->children_built && !parent->children.empty();
+  bool has_child_changed = !parent->children_built;
+
+  if (parent->children_built) {
+    std::vector<TreeModel::NodeId> ids;
+    std::unordered_map<TreeModel::NodeId, size_t> new_index;
+    uint32_t count = priv->model->GetChildCount(node);
+    ids.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      ids.push_back(priv->model->GetChildAt(node, i));
+      new_index.emplace(ids.back(), i);
+    }
+    // Keep the children that are still there and in the same order, other
+    // children are removed, from the last one so the earlier paths are not
+    // affected.
+    std::vector<bool> keep(parent->children.size(), false);
+    size_t last = 0;
+    bool first = true;
+    for (size_t i = 0; i < parent->children.size(); ++i) {
+      auto found = new_index.find(parent->children[i]->id);
+      if (found == new_index.end() || (!first && found->second <= last))
+        continue;
+      keep[i] = true;
+      last = found->second;
+      first = false;
+    }
+    for (size_t i = parent->children.size(); i-- > 0;) {
+      if (keep[i])
+        continue;
+      NUNode* child = parent->children[i].get();
+      ForgetChildren(priv, child);
+      auto mapped = priv->nodes.find(child->id);
+      if (mapped != priv->nodes.end() && mapped->second == child)
+        priv->nodes.erase(mapped);
+      parent->children.erase(parent->children.begin() + i);
+      for (size_t j = i; j < parent->children.size(); ++j)
+        parent->children[j]->index = j;
+      // Iters pointing to the removed node are invalid now.
+      priv->stamp++;
+      gtk_tree_path_append_index(path, i);
+      gtk_tree_model_row_deleted(tree_model, path);
+      gtk_tree_path_up(path);
+    }
+    // Insert the new children.
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (i < parent->children.size() && parent->children[i]->id == ids[i])
+        continue;
+      std::unique_ptr<NUNode> child(new NUNode);
+      child->id = ids[i];
+      child->parent = parent;
+      priv->nodes[child->id] = child.get();
+      parent->children.insert(parent->children.begin() + i, std::move(child));
+      for (size_t j = i; j < parent->children.size(); ++j)
+        parent->children[j]->index = j;
+      GtkTreeIter child_iter;
+      SetIter(priv, &child_iter, parent->children[i].get());
+      gtk_tree_path_append_index(path, i);
+      gtk_tree_model_row_inserted(tree_model, path, &child_iter);
+      if (priv->model->HasChildren(ids[i]))
+        gtk_tree_model_row_has_child_toggled(tree_model, path, &child_iter);
+      gtk_tree_path_up(path);
+    }
+    has_child_changed = had_child != !parent->children.empty();
+  }
+
+  if (parent != &priv->root && has_child_changed) {
+    SetIter(priv, &iter, parent);
+    gtk_tree_model_row_has_child_toggled(tree_model, path, &iter);
+  }
+  gtk_tree_path_free(path);
+}
+
+}  // namespace nu
@@ -0,0 +1,72 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GTK_NU_NODE_MODEL_H_
+#define NATIVEUI_GTK_NU_NODE_MODEL_H_
+
+#include <gtk/gtk.h>
+
+#include <functional>
+
+#include "nativeui/tree_model.h"
+
+// Custom tree model type for TreeModel.
+//
+// Only the children of loaded nodes are materialized, and they are built when
+// GTK asks for them for the first time, which usually happens when the node
+// is expanded.
+
+namespace nu {
+
+#define NU_TYPE_NODE_MODEL (nu_node_model_get_type())
+#define NU_NODE_MODEL(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
+                            NU_TYPE_NODE_MODEL, NUNodeModel))
+#define NU_IS_NODE_MODEL(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), \
+                               NU_TYPE_NODE_MODEL))
+
+typedef struct _NUNodeModel        NUNodeModel;
+typedef struct _NUNodeModelPrivate NUNodeModelPrivate;
+typedef struct _NUNodeModelClass   NUNodeModelClass;
+
+struct _NUNodeModel {
+  GObject parent;
+  NUNodeModelPrivate* priv;
+};
+
+struct _NUNodeModelClass {
+  GObjectClass parent_class;
+};
+
+GType nu_node_model_get_type();
+NUNodeModel* nu_node_model_new(TreeModel* model);
+
+// Return the ID of node at |iter|.
+TreeModel::NodeId nu_node_model_get_node_id(NUNodeModel* model,
+                                            GtkTreeIter* iter);
+
+// Read the cell at |column| of node at |iter|.
+TableCell nu_node_model_get_cell(NUNodeModel* model,
+                                 GtkTreeIter* iter,
+                                 gint column);
+
+// Get the |iter| of |node|, return false if the node is not materialized.
+bool nu_node_model_get_iter(NUNodeModel* model,
+                            TreeModel::NodeId node,
+                            GtkTreeIter* iter);
+
+// Load the children of |node| and call |callback| when they are ready, the
+// |callback| is called immediately if the children have been loaded.
+void nu_node_model_load_children(NUNodeModel* model,
+                                 TreeModel::NodeId node,
+                                 const std::function<void()>& callback);
+bool nu_node_model_is_loaded(NUNodeModel* model, TreeModel::NodeId node);
+
+// Sync the materialized children of |node| with model, and emit the signals
+// for the removed and inserted rows. Children that stay keep their subtrees,
+// so the tree view does not lose their expansion states.
+void nu_node_model_update_children(NUNodeModel* model, TreeModel::NodeId node);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GTK_NU_NODE_MODEL_H_
@@ -207,4 +207,13 @@ NUTreeModel* nu_tree_model_new(Table* table, TableModel* model) {
   return NU_TREE_MODEL(obj);
 }
 
+TableCell nu_tree_model_get_cell(NUTreeModel* tree_model,
+                                 GtkTreeIter* iter,
+                                 gint column) {
+  if (!iter->stamp)
+    return TableCell();
+  gint row = GPOINTER_TO_INT(iter->user_data);
+  return tree_model->priv->model->GetCell(column, row);
+}
+
 }  // namespace nu
@@ -7,12 +7,13 @@
 
 #include <gtk/gtk.h>
 
+#include "nativeui/table_model.h"
+
 // Custom tree model type for TableModel.
 
 namespace nu {
 
 class Table;
-class TableModel;
 
 #define NU_TYPE_TREE_MODEL (nu_tree_model_get_type())
 #define NU_TREE_MODEL(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
@@ -36,6 +37,12 @@ struct _NUTreeModelClass {
 GType nu_tree_model_get_type();
 NUTreeModel* nu_tree_model_new(Table* table, TableModel* model);
 
+// Read the cell directly from TableModel, which avoids converting the data to
+// base::Value.
+TableCell nu_tree_model_get_cell(NUTreeModel* tree_model,
+                                 GtkTreeIter* iter,
+                                 gint column);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_NU_TREE_MODEL_H_
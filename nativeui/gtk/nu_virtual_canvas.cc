@@ -0,0 +1,246 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/nu_virtual_canvas.h"
+
+#include <algorithm>
+
+#include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/gtk/frame_stats_recorder.h"
+#include "nativeui/scroll.h"
+
+namespace nu {
+
+enum {
+  PROP_0,
+  PROP_HADJUSTMENT,
+  PROP_VADJUSTMENT,
+  PROP_HSCROLL_POLICY,
+  PROP_VSCROLL_POLICY,
+};
+
+struct _NUVirtualCanvasPrivate {
+  Scroll* delegate;
+  double width;
+  double height;
+  GtkAdjustment* hadjustment;
+  GtkAdjustment* vadjustment;
+  guint hscroll_policy : 1;
+  guint vscroll_policy : 1;
+};
+
+static void nu_virtual_canvas_dispose(GObject* object);
+static void nu_virtual_canvas_set_property(GObject* object,
+                                           guint prop_id,
+                                           const GValue* value,
+                                           GParamSpec* pspec);
+static void nu_virtual_canvas_get_property(GObject* object,
+                                           guint prop_id,
+                                           GValue* value,
+                                           GParamSpec* pspec);
+static void nu_virtual_canvas_size_allocate(GtkWidget* widget,
+                                            GtkAllocation* allocation);
+static gboolean nu_virtual_canvas_draw(GtkWidget* widget, cairo_t* cr);
+static void nu_virtual_canvas_set_adjustment(NUVirtualCanvas* canvas,
+                                             GtkOrientation orientation,
+                                             GtkAdjustment* adjustment);
+static void nu_virtual_canvas_configure_adjustments(NUVirtualCanvas* canvas);
+
+G_DEFINE_TYPE_WITH_CODE(NUVirtualCanvas, nu_virtual_canvas,
+                        GTK_TYPE_DRAWING_AREA,
+                        G_ADD_PRIVATE(NUVirtualCanvas)
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_SCROLLABLE, nullptr))
+
+static void nu_virtual_canvas_class_init(NUVirtualCanvasClass* nu_class) {
+  GObjectClass* object_class = G_OBJECT_CLASS(nu_class);
+  GtkWidgetClass* widget_class = GTK_WIDGET_CLASS(nu_class);
+
+  object_class->dispose = nu_virtual_canvas_dispose;
+  object_class->set_property = nu_virtual_canvas_set_property;
+  object_class->get_property = nu_virtual_canvas_get_property;
+
+  widget_class->size_allocate = nu_virtual_canvas_size_allocate;
+  widget_class->draw = nu_virtual_canvas_draw;
+
+  g_object_class_override_property(object_class, PROP_HADJUSTMENT,
+                                   "hadjustment");
+  g_object_class_override_property(object_class, PROP_VADJUSTMENT,
+                                   "vadjustment");
+  g_object_class_override_property(object_class, PROP_HSCROLL_POLICY,
+                                   "hscroll-policy");
+  g_object_class_override_property(object_class, PROP_VSCROLL_POLICY,
+                                   "vscroll-policy");
+}
+
+static void OnAdjustmentValueChanged(GtkAdjustment* adjustment,
+                                     GtkWidget* widget) {
+  gtk_widget_queue_draw(widget);
+}
+
+static void ReleaseAdjustment(NUVirtualCanvas* canvas, GtkAdjustment** slot) {
+  if (!*slot)
+    return;
+  g_signal_handlers_disconnect_by_func(
+      *slot, reinterpret_cast<gpointer>(OnAdjustmentValueChanged), canvas);
+  g_object_unref(*slot);
+  *slot = nullptr;
+}
+
+static void nu_virtual_canvas_dispose(GObject* object) {
+  NUVirtualCanvas* canvas = NU_VIRTUAL_CANVAS(object);
+  ReleaseAdjustment(canvas, &canvas->priv->hadjustment);
+  ReleaseAdjustment(canvas, &canvas->priv->vadjustment);
+  G_OBJECT_CLASS(nu_virtual_canvas_parent_class)->dispose(object);
+}
+
+static void nu_virtual_canvas_set_property(GObject* object,
+                                           guint prop_id,
+                                           const GValue* value,
+                                           GParamSpec* pspec) {
+  NUVirtualCanvas* canvas = NU_VIRTUAL_CANVAS(object);
+  switch (prop_id) {
+    case PROP_HADJUSTMENT:
+      nu_virtual_canvas_set_adjustment(
+          canvas, GTK_ORIENTATION_HORIZONTAL,
+          GTK_ADJUSTMENT(g_value_get_object(value)));
+      nu_virtual_canvas_configure_adjustments(canvas);
+      break;
+    case PROP_VADJUSTMENT:
+      nu_virtual_canvas_set_adjustment(
+          canvas, GTK_ORIENTATION_VERTICAL,
+          GTK_ADJUSTMENT(g_value_get_object(value)));
+      nu_virtual_canvas_configure_adjustments(canvas);
+      break;
+    case PROP_HSCROLL_POLICY:
+      canvas->priv->hscroll_policy = g_value_get_enum(value);
+      break;
+    case PROP_VSCROLL_POLICY:
+      canvas->priv->vscroll_policy = g_value_get_enum(value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+      break;
+  }
+}
+
+static void nu_virtual_canvas_get_property(GObject* object,
+                                           guint prop_id,
+                                           GValue* value,
+                                           GParamSpec* pspec) {
+  NUVirtualCanvasPrivate* priv = NU_VIRTUAL_CANVAS(object)->priv;
+  switch (prop_id) {
+    case PROP_HADJUSTMENT:
+      g_value_set_object(value, priv->hadjustment);
+      break;
+    case PROP_VADJUSTMENT:
+      g_value_set_object(value, priv->vadjustment);
+      break;
+    case PROP_HSCROLL_POLICY:
+      g_value_set_enum(value, priv->hscroll_policy);
+      break;
+    case PROP_VSCROLL_POLICY:
+      g_value_set_enum(value, priv->vscroll_policy);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+      break;
+  }
+}
+
+static void nu_virtual_canvas_size_allocate(GtkWidget* widget,
+                                            GtkAllocation* allocation) {
+  GTK_WIDGET_CLASS(nu_virtual_canvas_parent_class)->size_allocate(
+      widget, allocation);
+  nu_virtual_canvas_configure_adjustments(NU_VIRTUAL_CANVAS(widget));
+}
+
+static gboolean nu_virtual_canvas_draw(GtkWidget* widget, cairo_t* cr) {
+  int width = gtk_widget_get_allocated_width(widget);
+  int height = gtk_widget_get_allocated_height(widget);
+  gtk_render_background(gtk_widget_get_style_context(widget), cr,
+                        0, 0, width, height);
+
+  NUVirtualCanvasPrivate* priv = NU_VIRTUAL_CANVAS(widget)->priv;
+  Scroll* delegate = priv->delegate;
+  if (delegate->on_draw_content.IsEmpty())
+    return FALSE;
+
+  // Only the visible area is painted, the painter's origin is at the logical
+  // position of scroll offsets.
+  GdkRectangle clip;
+  if (!gdk_cairo_get_clip_rectangle(cr, &clip))
+    return FALSE;
+  PainterGtk painter(cr);
+  FrameStatsRecorder* recorder = GetFrameStatsRecorder(widget);
+  gint64 start = recorder ? g_get_monotonic_time() : 0;
+  delegate->on_draw_content.Emit(
+      delegate, &painter,
+      gtk_adjustment_get_value(priv->hadjustment),
+      gtk_adjustment_get_value(priv->vadjustment),
+      RectF(clip.x, clip.y, clip.width, clip.height));
+  if (recorder)
+    recorder->RecordDrawHandler(delegate, g_get_monotonic_time() - start);
+  return FALSE;
+}
+
+static void nu_virtual_canvas_set_adjustment(NUVirtualCanvas* canvas,
+                                             GtkOrientation orientation,
+                                             GtkAdjustment* adjustment) {
+  GtkAdjustment** slot = orientation == GTK_ORIENTATION_HORIZONTAL ?
+      &canvas->priv->hadjustment : &canvas->priv->vadjustment;
+  if (*slot && *slot == adjustment)
+    return;
+  ReleaseAdjustment(canvas, slot);
+  if (!adjustment)
+    adjustment = gtk_adjustment_new(0, 0, 0, 0, 0, 0);
+  *slot = GTK_ADJUSTMENT(g_object_ref_sink(adjustment));
+  g_signal_connect(adjustment, "value-changed",
+                   G_CALLBACK(OnAdjustmentValueChanged), canvas);
+}
+
+static void ConfigureAdjustment(GtkAdjustment* adjustment,
+                                double content, int page) {
+  if (!adjustment)
+    return;
+  double upper = std::max<double>(content, page);
+  double value = std::min(gtk_adjustment_get_value(adjustment), upper - page);
+  gtk_adjustment_configure(adjustment, std::max(0.0, value), 0, upper,
+                           page * 0.1, page * 0.9, page);
+}
+
+static void nu_virtual_canvas_configure_adjustments(NUVirtualCanvas* canvas) {
+  GtkWidget* widget = GTK_WIDGET(canvas);
+  NUVirtualCanvasPrivate* priv = canvas->priv;
+  ConfigureAdjustment(priv->hadjustment, priv->width,
+                      gtk_widget_get_allocated_width(widget));
+  ConfigureAdjustment(priv->vadjustment, priv->height,
+                      gtk_widget_get_allocated_height(widget));
+}
+
+static void nu_virtual_canvas_init(NUVirtualCanvas* widget) {
+  widget->priv = static_cast<NUVirtualCanvasPrivate*>(
+      nu_virtual_canvas_get_instance_private(widget));
+}
+
+GtkWidget* nu_virtual_canvas_new(Scroll* delegate) {
+  void* widget = g_object_new(NU_TYPE_VIRTUAL_CANVAS, nullptr);
+  NU_VIRTUAL_CANVAS(widget)->priv->delegate = delegate;
+  return GTK_WIDGET(widget);
+}
+
+void nu_virtual_canvas_set_content_size(NUVirtualCanvas* canvas,
+                                        double width, double height) {
+  canvas->priv->width = width;
+  canvas->priv->height = height;
+  nu_virtual_canvas_configure_adjustments(canvas);
+  gtk_widget_queue_draw(GTK_WIDGET(canvas));
+}
+
+void nu_virtual_canvas_get_content_size(NUVirtualCanvas* canvas,
+                                        double* width, double* height) {
+  *width = canvas->priv->width;
+  *height = canvas->priv->height;
+}
+
+}  // namespace nu
@@ -0,0 +1,49 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GTK_NU_VIRTUAL_CANVAS_H_
+#define NATIVEUI_GTK_NU_VIRTUAL_CANVAS_H_
+
+#include <gtk/gtk.h>
+
+// Scrollable GTK widget used by the virtual content mode of nu::Scroll, it
+// only keeps the scroll offsets and the logical size of content, and draws the
+// visible area on demand.
+
+namespace nu {
+
+class Scroll;
+
+#define NU_TYPE_VIRTUAL_CANVAS (nu_virtual_canvas_get_type())
+#define NU_VIRTUAL_CANVAS(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
+                                NU_TYPE_VIRTUAL_CANVAS, NUVirtualCanvas))
+#define NU_IS_VIRTUAL_CANVAS(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), \
+                                   NU_TYPE_VIRTUAL_CANVAS))
+
+typedef struct _NUVirtualCanvas        NUVirtualCanvas;
+typedef struct _NUVirtualCanvasPrivate NUVirtualCanvasPrivate;
+typedef struct _NUVirtualCanvasClass   NUVirtualCanvasClass;
+
+struct _NUVirtualCanvas {
+  GtkDrawingArea drawing_area;
+  NUVirtualCanvasPrivate* priv;
+};
+
+struct _NUVirtualCanvasClass {
+  GtkDrawingAreaClass parent_class;
+};
+
+GType nu_virtual_canvas_get_type();
+GtkWidget* nu_virtual_canvas_new(Scroll* delegate);
+
+// The logical size is stored in doubles, which represent integers exactly up
+// to 2^53 pixels.
+void nu_virtual_canvas_set_content_size(NUVirtualCanvas* canvas,
+                                        double width, double height);
+void nu_virtual_canvas_get_content_size(NUVirtualCanvas* canvas,
+                                        double* width, double* height);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GTK_NU_VIRTUAL_CANVAS_H_
@@ -6,6 +6,7 @@
 
 #include <gtk/gtk.h>
 
+#include "nativeui/gtk/nu_virtual_canvas.h"
 #include "nativeui/gtk/widget_util.h"
 
 namespace nu {
@@ -30,6 +31,20 @@ Scroll::Policy PolicyFromGTK(GtkPolicyType policy) {
     return Scroll::Policy::Automatic;
 }
 
+NUVirtualCanvas* GetVirtualCanvas(const Scroll* scroll) {
+  GtkWidget* child = gtk_bin_get_child(GTK_BIN(scroll->GetNative()));
+  return NU_IS_VIRTUAL_CANVAS(child) ? NU_VIRTUAL_CANVAS(child) : nullptr;
+}
+
+// The viewport is detached in virtual content mode.
+GtkWidget* GetViewport(Scroll* scroll) {
+  GtkWidget* child = gtk_bin_get_child(GTK_BIN(scroll->GetNative()));
+  if (NU_IS_VIRTUAL_CANVAS(child))
+    return static_cast<GtkWidget*>(
+        g_object_get_data(G_OBJECT(scroll->GetNative()), "detached-child"));
+  return child;
+}
+
 }  // namespace
 
 void Scroll::PlatformInit() {
@@ -50,7 +65,7 @@ void Scroll::PlatformSetContentView(View* view) {
     csize = Size(w, h);
   }
 
-  GtkWidget* viewport = gtk_bin_get_child(GTK_BIN(GetNative()));
+  GtkWidget* viewport = GetViewport(this);
   GtkWidget* child = gtk_bin_get_child(GTK_BIN(viewport));
   if (child) {
     gtk_container_remove(GTK_CONTAINER(viewport), child);
@@ -102,4 +117,60 @@ std::tuple<Scroll::Policy, Scroll::Policy> Scroll::GetScrollbarPolicy() const {
   return std::make_tuple(PolicyFromGTK(hp), PolicyFromGTK(vp));
 }
 
+void Scroll::SetVirtualContentMode(bool enabled) {
+  if (enabled == IsVirtualContentMode())
+    return;
+  // Swap the viewport of content view with the virtual canvas, the detached
+  // one is kept for switching back.
+  GObject* scroll = G_OBJECT(GetNative());
+  GtkWidget* other = static_cast<GtkWidget*>(
+      g_object_steal_data(scroll, "detached-child"));
+  if (!other) {
+    other = nu_virtual_canvas_new(this);
+    g_object_ref_sink(other);
+    gtk_widget_show(other);
+  }
+  GtkWidget* current = gtk_bin_get_child(GTK_BIN(GetNative()));
+  g_object_ref(current);
+  gtk_container_remove(GTK_CONTAINER(GetNative()), current);
+  g_object_set_data_full(scroll, "detached-child", current, g_object_unref);
+  gtk_container_add(GTK_CONTAINER(GetNative()), other);
+  g_object_unref(other);
+}
+
+bool Scroll::IsVirtualContentMode() const {
+  return GetVirtualCanvas(this) != nullptr;
+}
+
+void Scroll::SetVirtualContentSize(double width, double height) {
+  NUVirtualCanvas* canvas = GetVirtualCanvas(this);
+  if (canvas)
+    nu_virtual_canvas_set_content_size(canvas, width, height);
+}
+
+std::tuple<double, double> Scroll::GetVirtualContentSize() const {
+  double width = 0, height = 0;
+  NUVirtualCanvas* canvas = GetVirtualCanvas(this);
+  if (canvas)
+    nu_virtual_canvas_get_content_size(canvas, &width, &height);
+  return std::make_tuple(width, height);
+}
+
+void Scroll::SetScrollPosition(double x, double y) {
+  gtk_adjustment_set_value(
+      gtk_scrolled_window_get_hadjustment(GTK_SCROLLED_WINDOW(GetNative())),
+      x);
+  gtk_adjustment_set_value(
+      gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(GetNative())),
+      y);
+}
+
+std::tuple<double, double> Scroll::GetScrollPosition() const {
+  return std::make_tuple(
+      gtk_adjustment_get_value(gtk_scrolled_window_get_hadjustment(
+          GTK_SCROLLED_WINDOW(GetNative()))),
+      gtk_adjustment_get_value(gtk_scrolled_window_get_vadjustment(
+          GTK_SCROLLED_WINDOW(GetNative()))));
+}
+
 }  // namespace nu
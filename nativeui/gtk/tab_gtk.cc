@@ -12,7 +12,8 @@ namespace nu {
 
 namespace {
 
-void OnSwitchPage(GtkNotebook*, GtkWidget*, guint, Tab* tab) {
+void OnSwitchPage(GtkNotebook*, GtkWidget*, guint index, Tab* tab) {
+  tab->OnPageSelected(index);
   tab->on_selected_page_change.Emit(tab);
 }
 
@@ -33,6 +34,13 @@ void Tab::PlatformRemovePage(int index, View* view) {
   gtk_notebook_remove_page(GTK_NOTEBOOK(GetNative()), index);
 }
 
+void Tab::PlatformUnloadPage(View* view) {
+  // Free the GdkWindows and other resources, they are created again when the
+  // page is mapped.
+  if (!gtk_widget_get_mapped(view->GetNative()))
+    gtk_widget_unrealize(view->GetNative());
+}
+
 void Tab::SelectPageAt(int index) {
   gtk_notebook_set_current_page(GTK_NOTEBOOK(GetNative()), index);
 }
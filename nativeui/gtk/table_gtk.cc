@@ -4,6 +4,10 @@
 
 #include "nativeui/table.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "base/values.h"
 #include "nativeui/gtk/nu_custom_cell_renderer.h"
 #include "nativeui/gtk/nu_tree_model.h"
@@ -14,6 +18,134 @@ namespace nu {
 
 namespace {
 
+// Table private data.
+struct NUTablePrivate {
+  // The selected rows, GTK's tree selection is not used since it stores every
+  // selected row and makes selecting large ranges slow.
+  RangeSet selection;
+  bool multiple = false;
+  // Where the range selection with Shift starts.
+  uint32_t anchor = 0;
+  // Colors of selected rows.
+  GdkRGBA selected_background = {0, 0, 0, 0};
+  GdkRGBA selected_foreground = {0, 0, 0, 1};
+};
+
+// Helper to receive private data.
+inline NUTablePrivate* GetPrivate(const Table* table) {
+  return static_cast<NUTablePrivate*>(g_object_get_data(
+      G_OBJECT(table->GetNative()), "private"));
+}
+
+inline GtkTreeView* GetTreeView(const Table* table) {
+  return GTK_TREE_VIEW(g_object_get_data(G_OBJECT(table->GetNative()),
+                                         "tree-view"));
+}
+
+uint32_t GetModelRowCount(Table* table) {
+  TableModel* model = table->GetModel();
+  return model ? model->GetRowCount() : 0;
+}
+
+// Redraw and emit the changes of selection.
+void NotifySelectionChange(Table* table,
+                           const std::vector<Range>& added,
+                           const std::vector<Range>& removed) {
+  if (added.empty() && removed.empty())
+    return;
+  gtk_widget_queue_draw(GTK_WIDGET(GetTreeView(table)));
+  table->on_selection_change.Emit(table, added, removed);
+}
+
+// Replace the selection with |range|.
+void SetSelection(Table* table, const Range& range) {
+  RangeSet& selection = GetPrivate(table)->selection;
+  std::vector<Range> added, removed;
+  selection.Remove(Range(0, range.start), &removed);
+  selection.Remove(Range(range.end, UINT32_MAX), &removed);
+  selection.Add(range, &added);
+  NotifySelectionChange(table, added, removed);
+}
+
+// Change selection like how GTK handles clicks and key presses.
+void SelectRowWithModifiers(Table* table, uint32_t row, guint state) {
+  NUTablePrivate* priv = GetPrivate(table);
+  if (priv->multiple && (state & GDK_SHIFT_MASK)) {
+    Range range(std::min(priv->anchor, row), std::max(priv->anchor, row) + 1);
+    if (state & GDK_CONTROL_MASK)
+      table->SelectRange(range.start, range.end);
+    else
+      SetSelection(table, range);
+  } else if (priv->multiple && (state & GDK_CONTROL_MASK)) {
+    table->ToggleRange(row, row + 1);
+    priv->anchor = row;
+  } else {
+    table->SelectRow(row);
+  }
+}
+
+// Read the colors of selected rows from theme.
+void OnStyleUpdated(GtkWidget* tree_view, NUTablePrivate* priv) {
+  GtkStyleContext* context = gtk_widget_get_style_context(tree_view);
+  GdkRGBA* background = nullptr;
+  gtk_style_context_get(context, GTK_STATE_FLAG_SELECTED,
+                        "background-color", &background, nullptr);
+  if (background) {
+    priv->selected_background = *background;
+    gdk_rgba_free(background);
+  }
+  gtk_style_context_get_color(context, GTK_STATE_FLAG_SELECTED,
+                              &priv->selected_foreground);
+}
+
+// Select the clicked row.
+gboolean OnButtonPress(GtkWidget* widget, GdkEventButton* event, Table* table) {
+  GtkTreeView* tree_view = GTK_TREE_VIEW(widget);
+  if (event->type != GDK_BUTTON_PRESS || event->button != 1 ||
+      event->window != gtk_tree_view_get_bin_window(tree_view))
+    return FALSE;
+  GtkTreePath* path = nullptr;
+  if (!gtk_tree_view_get_path_at_pos(tree_view, event->x, event->y, &path,
+                                     nullptr, nullptr, nullptr))
+    return FALSE;
+  gint row = gtk_tree_path_get_indices(path)[0];
+  gtk_tree_path_free(path);
+  SelectRowWithModifiers(table, row, event->state);
+  // Let GTK move cursor and start editing.
+  return FALSE;
+}
+
+// Select the row under cursor when moving cursor with keyboard.
+void OnCursorChanged(GtkTreeView* tree_view, Table* table) {
+  GdkEvent* event = gtk_get_current_event();
+  if (!event)
+    return;
+  if (event->type == GDK_KEY_PRESS) {
+    GtkTreePath* path = nullptr;
+    gtk_tree_view_get_cursor(tree_view, &path, nullptr);
+    if (path) {
+      gint row = gtk_tree_path_get_indices(path)[0];
+      gtk_tree_path_free(path);
+      // Ctrl only moves the cursor.
+      if (!(event->key.state & GDK_CONTROL_MASK) ||
+          (event->key.state & GDK_SHIFT_MASK))
+        SelectRowWithModifiers(table, row, event->key.state);
+    }
+  }
+  gdk_event_free(event);
+}
+
+// Keybindings of tree view.
+gboolean OnSelectAll(GtkTreeView* tree_view, Table* table) {
+  table->SelectAll();
+  return TRUE;
+}
+
+gboolean OnUnselectAll(GtkTreeView* tree_view, Table* table) {
+  table->DeselectAll();
+  return TRUE;
+}
+
 // Calculate the default row height of cell.
 int GetDefaultRowHeight() {
   // Cache calls.
@@ -59,24 +191,47 @@ void TreeCellData(GtkTreeViewColumn* tree_column,
                   void* user_data) {
   auto* options = static_cast<Table::ColumnOptions*>(user_data);
 
-  // Read value from model.
-  GValue gval = G_VALUE_INIT;
-  gtk_tree_model_get_value(tree_model, iter, options->column, &gval);
-  const auto* value =
-      static_cast<const base::Value*>(g_value_get_pointer(&gval));
-  g_value_unset(&gval);
+  // Paint selected rows.
+  GtkWidget* tree_view = gtk_tree_view_column_get_tree_view(tree_column);
+  auto* priv = static_cast<NUTablePrivate*>(g_object_get_data(
+      G_OBJECT(gtk_widget_get_parent(tree_view)), "private"));
+  bool is_text = GTK_IS_CELL_RENDERER_TEXT(renderer);
+  if (iter->stamp &&
+      priv->selection.Contains(GPOINTER_TO_INT(iter->user_data))) {
+    g_object_set(renderer,
+                 "cell-background-rgba", &priv->selected_background, nullptr);
+    if (is_text) {
+      g_object_set(renderer,
+                   "foreground-rgba", &priv->selected_foreground, nullptr);
+    }
+  } else {
+    g_object_set(renderer, "cell-background-set", FALSE, nullptr);
+    if (is_text)
+      g_object_set(renderer, "foreground-set", FALSE, nullptr);
+  }
+
+  // Read cell from model.
+  TableCell cell = nu_tree_model_get_cell(NU_TREE_MODEL(tree_model), iter,
+                                          options->column);
 
   // Pass value.
   switch (options->type) {
     case Table::ColumnType::Text:
     case Table::ColumnType::Edit: {
-      if (value && value->is_string())
-        g_object_set(renderer, "text", value->GetString().c_str(), nullptr);
+      if (!cell.is_string()) {
+        g_object_set(renderer, "text", "", nullptr);
+      } else if (const char* text = cell.GetCString()) {
+        // Strings stored in the model can be passed without copying.
+        g_object_set(renderer, "text", text, nullptr);
+      } else {
+        g_object_set(renderer, "text", cell.GetString().as_string().c_str(),
+                     nullptr);
+      }
       break;
     }
 
     case nu::Table::ColumnType::Custom: {
-      g_object_set(renderer, "value", value, nullptr);
+      g_object_set(renderer, "cell", &cell, nullptr);
       break;
     }
   }
@@ -89,7 +244,25 @@ NativeView Table::PlatformCreate() {
   gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(tree_view), true);
   gtk_widget_show(tree_view);
 
+  // Selection is managed by ourselves.
+  NUTablePrivate* priv = new NUTablePrivate;
+  gtk_tree_selection_set_mode(
+      gtk_tree_view_get_selection(GTK_TREE_VIEW(tree_view)),
+      GTK_SELECTION_NONE);
+  OnStyleUpdated(tree_view, priv);
+  g_signal_connect(tree_view, "style-updated",
+                   G_CALLBACK(OnStyleUpdated), priv);
+  g_signal_connect(tree_view, "button-press-event",
+                   G_CALLBACK(OnButtonPress), this);
+  g_signal_connect(tree_view, "cursor-changed",
+                   G_CALLBACK(OnCursorChanged), this);
+  g_signal_connect(tree_view, "select-all", G_CALLBACK(OnSelectAll), this);
+  g_signal_connect(tree_view, "unselect-all",
+                   G_CALLBACK(OnUnselectAll), this);
+
   GtkWidget* scroll = gtk_scrolled_window_new(nullptr, nullptr);
+  g_object_set_data_full(G_OBJECT(scroll), "private", priv,
+                         Delete<NUTablePrivate>);
   g_object_set_data(G_OBJECT(scroll), "tree-view", tree_view);
   g_object_set_data(G_OBJECT(scroll), "row-height",
                     GINT_TO_POINTER(GetDefaultRowHeight()));
@@ -108,6 +281,8 @@ void Table::PlatformSetModel(TableModel* model) {
                                                     "tree-view"));
   NUTreeModel* tree_model = nu_tree_model_new(this, model);
   gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  // Rows of old model are no longer selected.
+  DeselectAll();
 }
 
 void Table::AddColumnWithOptions(const std::string& title,
@@ -185,27 +360,95 @@ float Table::GetRowHeight() const {
 }
 
 void Table::SelectRow(int row) {
-  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
-                                                    "tree-view"));
-  auto* tree_model = gtk_tree_view_get_model(tree_view);
-  if (!tree_model)
+  if (row < 0 || static_cast<uint32_t>(row) >= GetModelRowCount(this))
     return;
-  GtkTreeSelection* selection = gtk_tree_view_get_selection(tree_view);
-  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
-  gtk_tree_selection_select_iter(selection, &iter);
+  SetSelection(this, Range(row, row + 1));
+  GetPrivate(this)->anchor = row;
 }
 
 int Table::GetSelectedRow() const {
-  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
-                                                    "tree-view"));
-  auto* tree_model = gtk_tree_view_get_model(tree_view);
-  if (!tree_model)
-    return -1;
-  GtkTreeIter iter;
-  GtkTreeSelection* selection = gtk_tree_view_get_selection(tree_view);
-  if (gtk_tree_selection_get_selected(selection, &tree_model, &iter))
-    return GPOINTER_TO_INT(iter.user_data);
-  return -1;
+  const RangeSet& selection = GetPrivate(this)->selection;
+  return selection.empty() ? -1 : selection.ranges().front().start;
+}
+
+void Table::SetMultipleSelection(bool multiple) {
+  NUTablePrivate* priv = GetPrivate(this);
+  priv->multiple = multiple;
+  // Only keep the first selected row.
+  if (!multiple && priv->selection.Size() > 1) {
+    uint32_t first = priv->selection.ranges().front().start;
+    SetSelection(this, Range(first, first + 1));
+  }
+}
+
+bool Table::IsMultipleSelection() const {
+  return GetPrivate(this)->multiple;
+}
+
+void Table::SelectRange(uint32_t start, uint32_t end) {
+  end = std::min(end, GetModelRowCount(this));
+  if (start >= end)
+    return;
+  NUTablePrivate* priv = GetPrivate(this);
+  priv->anchor = start;
+  if (!priv->multiple) {
+    SetSelection(this, Range(start, start + 1));
+    return;
+  }
+  std::vector<Range> added;
+  priv->selection.Add(Range(start, end), &added);
+  NotifySelectionChange(this, added, {});
+}
+
+void Table::DeselectRange(uint32_t start, uint32_t end) {
+  std::vector<Range> removed;
+  GetPrivate(this)->selection.Remove(Range(start, end), &removed);
+  NotifySelectionChange(this, {}, removed);
+}
+
+void Table::ToggleRange(uint32_t start, uint32_t end) {
+  end = std::min(end, GetModelRowCount(this));
+  if (start >= end)
+    return;
+  NUTablePrivate* priv = GetPrivate(this);
+  if (!priv->multiple) {
+    if (priv->selection.Contains(start))
+      DeselectRange(start, start + 1);
+    else
+      SetSelection(this, Range(start, start + 1));
+    return;
+  }
+  std::vector<Range> added, removed;
+  priv->selection.Toggle(Range(start, end), &added, &removed);
+  NotifySelectionChange(this, added, removed);
+}
+
+void Table::SelectAll() {
+  if (IsMultipleSelection())
+    SelectRange(0, GetModelRowCount(this));
+}
+
+void Table::DeselectAll() {
+  std::vector<Range> removed;
+  GetPrivate(this)->selection.Clear(&removed);
+  NotifySelectionChange(this, {}, removed);
+}
+
+void Table::InvertSelection() {
+  NUTablePrivate* priv = GetPrivate(this);
+  if (!priv->multiple)
+    return;
+  std::vector<Range> added, removed;
+  priv->selection.Invert(GetModelRowCount(this), &added, &removed);
+  NotifySelectionChange(this, added, removed);
+}
+
+bool Table::IsRowSelected(uint32_t row) const {
+  return GetPrivate(this)->selection.Contains(row);
+}
+
+std::vector<Range> Table::GetSelectedRanges() const {
+  return GetPrivate(this)->selection.ranges();
 }
 
 void Table::NotifyRowInsertion(uint32_t row) {
@@ -218,6 +461,11 @@ void Table::NotifyRowInsertion(uint32_t row) {
   GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
   gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
   gtk_tree_path_free(tree_path);
+  // Selected rows move with the inserted row.
+  NUTablePrivate* priv = GetPrivate(this);
+  priv->selection.InsertAt(row);
+  if (priv->anchor >= row)
+    priv->anchor++;
 }
 
 void Table::NotifyRowDeletion(uint32_t row) {
@@ -229,6 +477,12 @@ void Table::NotifyRowDeletion(uint32_t row) {
   GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
   gtk_tree_model_row_deleted(tree_model, tree_path);
   gtk_tree_path_free(tree_path);
+  // Selected rows move with the deleted row.
+  NUTablePrivate* priv = GetPrivate(this);
+  if (priv->anchor > row)
+    priv->anchor--;
+  if (priv->selection.RemoveAt(row))
+    NotifySelectionChange(this, {}, {Range(row, row + 1)});
 }
 
 void Table::NotifyValueChange(uint32_t column, uint32_t row) {
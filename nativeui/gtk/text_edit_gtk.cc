@@ -62,6 +62,14 @@ void TextEdit::SetText(const std::string& text) {
   gtk_text_buffer_set_text(buffer, text.c_str(), text.size());
 }
 
+size_t TextEdit::EstimateMemoryUsage() const {
+  // The text buffer is usually much larger than the view itself, count it
+  // without copying the text.
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  return sizeof(TextEdit) + gtk_text_buffer_get_char_count(buffer);
+}
+
 std::string TextEdit::GetText() const {
   GtkTextBuffer* buffer = gtk_text_view_get_buffer(
       GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
@@ -201,6 +209,7 @@ RectF TextEdit::GetTextBounds() const {
   // work when widget is not mapped, and it returns wrong values with empty
   // lines.
   std::string text = GetText();
+  WaitForFontWarmup();
   PangoLayout* layout =
       pango_layout_new(gtk_widget_get_pango_context(GetNative()));
   if (font())
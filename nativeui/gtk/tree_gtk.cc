@@ -0,0 +1,312 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree.h"
+
+#include <string>
+
+#include "base/values.h"
+#include "nativeui/gtk/nu_custom_cell_renderer.h"
+#include "nativeui/gtk/nu_node_model.h"
+#include "nativeui/gtk/widget_util.h"
+
+namespace nu {
+
+namespace {
+
+inline GtkTreeView* GetTreeView(const Tree* tree) {
+  return GTK_TREE_VIEW(g_object_get_data(G_OBJECT(tree->GetNative()),
+                                         "tree-view"));
+}
+
+inline NUNodeModel* GetNodeModel(const Tree* tree) {
+  GtkTreeModel* model = gtk_tree_view_get_model(GetTreeView(tree));
+  return model ? NU_NODE_MODEL(model) : nullptr;
+}
+
+// Expand |node| after its children are loaded, and call |callback| after the
+// node is expanded. When |node| is not materialized, its parent is expanded
+// first to materialize it.
+void ExpandNodeWithCallback(Tree* tree,
+                            TreeModel::NodeId node,
+                            const std::function<void()>& callback,
+                            bool expand_parent = true) {
+  NUNodeModel* model = GetNodeModel(tree);
+  if (!model || node == TreeModel::kRootNode)
+    return;
+  GtkTreeIter iter;
+  // The callbacks are stored in the node model owned by the tree, so they
+  // must not keep the tree alive.
+  base::WeakPtr<Tree> weak = tree->AsWeakPtr();
+  if (!nu_node_model_get_iter(model, node, &iter)) {
+    TreeModel::NodeId parent = tree->GetModel()->GetParent(node);
+    if (!expand_parent || parent == TreeModel::kRootNode)
+      return;
+    ExpandNodeWithCallback(tree, parent, [weak, node, callback]() {
+      if (weak)
+        ExpandNodeWithCallback(weak.get(), node, callback, false);
+    });
+    return;
+  }
+  nu_node_model_load_children(model, node, [weak, model, node, callback]() {
+    // The tree may have been destroyed or changed model while loading.
+    GtkTreeIter iter;
+    if (!weak || GetNodeModel(weak.get()) != model ||
+        !nu_node_model_get_iter(model, node, &iter))
+      return;
+    GtkTreePath* path = gtk_tree_model_get_path(GTK_TREE_MODEL(model), &iter);
+    gtk_tree_view_expand_row(GetTreeView(weak.get()), path, false);
+    gtk_tree_path_free(path);
+    if (callback)
+      callback();
+  });
+}
+
+// Load children before expanding.
+gboolean OnTestExpandRow(GtkTreeView* tree_view,
+                         GtkTreeIter* iter,
+                         GtkTreePath* path,
+                         Tree* tree) {
+  NUNodeModel* model = NU_NODE_MODEL(gtk_tree_view_get_model(tree_view));
+  TreeModel::NodeId node = nu_node_model_get_node_id(model, iter);
+  if (nu_node_model_is_loaded(model, node))
+    return FALSE;
+  nu_node_model_load_children(model, node, nullptr);
+  // Children are loaded synchronously.
+  if (nu_node_model_is_loaded(model, node))
+    return FALSE;
+  // Otherwise cancel the expansion and do it after loading.
+  tree->ExpandNode(node);
+  return TRUE;
+}
+
+void OnRowExpanded(GtkTreeView* tree_view,
+                   GtkTreeIter* iter,
+                   GtkTreePath* path,
+                   Tree* tree) {
+  NUNodeModel* model = NU_NODE_MODEL(gtk_tree_view_get_model(tree_view));
+  tree->on_node_expand.Emit(tree, nu_node_model_get_node_id(model, iter));
+}
+
+void OnRowCollapsed(GtkTreeView* tree_view,
+                    GtkTreeIter* iter,
+                    GtkTreePath* path,
+                    Tree* tree) {
+  NUNodeModel* model = NU_NODE_MODEL(gtk_tree_view_get_model(tree_view));
+  tree->on_node_collapse.Emit(tree, nu_node_model_get_node_id(model, iter));
+}
+
+// Called when user has done editing a cell.
+void OnEdited(GtkCellRendererText* cell,
+              const gchar* path,
+              const gchar* new_text,
+              Tree* tree) {
+  NUNodeModel* model = GetNodeModel(tree);
+  GtkTreeIter iter;
+  if (!model ||
+      !gtk_tree_model_get_iter_from_string(GTK_TREE_MODEL(model), &iter, path))
+    return;
+  gint column = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(cell), "column"));
+  tree->GetModel()->SetValue(column, nu_node_model_get_node_id(model, &iter),
+                             base::Value(new_text));
+}
+
+// Called to provide data to cell renderer.
+void TreeCellData(GtkTreeViewColumn* tree_column,
+                  GtkCellRenderer* renderer,
+                  GtkTreeModel* tree_model,
+                  GtkTreeIter* iter,
+                  void* user_data) {
+  auto* options = static_cast<Table::ColumnOptions*>(user_data);
+  TableCell cell = nu_node_model_get_cell(NU_NODE_MODEL(tree_model), iter,
+                                          options->column);
+
+  switch (options->type) {
+    case Table::ColumnType::Text:
+    case Table::ColumnType::Edit: {
+      if (!cell.is_string()) {
+        g_object_set(renderer, "text", "", nullptr);
+      } else if (const char* text = cell.GetCString()) {
+        // Strings stored in the model can be passed without copying.
+        g_object_set(renderer, "text", text, nullptr);
+      } else {
+        g_object_set(renderer, "text", cell.GetString().as_string().c_str(),
+                     nullptr);
+      }
+      break;
+    }
+
+    case Table::ColumnType::Custom: {
+      g_object_set(renderer, "cell", &cell, nullptr);
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+NativeView Tree::PlatformCreate() {
+  GtkWidget* tree_view = gtk_tree_view_new();
+  gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(tree_view), true);
+  gtk_widget_show(tree_view);
+  g_signal_connect(tree_view, "test-expand-row",
+                   G_CALLBACK(OnTestExpandRow), this);
+  g_signal_connect(tree_view, "row-expanded",
+                   G_CALLBACK(OnRowExpanded), this);
+  g_signal_connect(tree_view, "row-collapsed",
+                   G_CALLBACK(OnRowCollapsed), this);
+
+  GtkWidget* scroll = gtk_scrolled_window_new(nullptr, nullptr);
+  g_object_set_data(G_OBJECT(scroll), "tree-view", tree_view);
+  gtk_container_add(GTK_CONTAINER(scroll), tree_view);
+  return scroll;
+}
+
+void Tree::PlatformSetModel(TreeModel* model) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  gtk_tree_view_set_model(tree_view, nullptr);
+  if (!model) {
+    g_object_set_data(G_OBJECT(GetNative()), "node-model", nullptr);
+    return;
+  }
+  // Only show the model after the root's children are loaded.
+  NUNodeModel* node_model = nu_node_model_new(model);
+  g_object_set_data_full(G_OBJECT(GetNative()), "node-model", node_model,
+                         g_object_unref);
+  base::WeakPtr<Tree> weak = AsWeakPtr();
+  nu_node_model_load_children(node_model, TreeModel::kRootNode,
+                              [weak, node_model]() {
+    // Ignore if the tree is gone or the model has been replaced.
+    if (!weak)
+      return;
+    GObject* scroll = G_OBJECT(weak->GetNative());
+    if (g_object_get_data(scroll, "node-model") == node_model)
+      gtk_tree_view_set_model(GetTreeView(weak.get()),
+                              GTK_TREE_MODEL(node_model));
+  });
+}
+
+void Tree::AddColumnWithOptions(const std::string& title,
+                                const Table::ColumnOptions& options) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  // Create renderer.
+  GtkCellRenderer* renderer = nullptr;
+  switch (options.type) {
+    case Table::ColumnType::Text:
+    case Table::ColumnType::Edit:
+      renderer = gtk_cell_renderer_text_new();
+      if (options.type == Table::ColumnType::Edit) {
+        g_object_set(renderer, "editable", true, nullptr);
+        g_signal_connect(renderer, "edited", G_CALLBACK(OnEdited), this);
+      }
+      break;
+    case Table::ColumnType::Custom:
+      renderer = nu_custom_cell_renderer_new(options);
+      break;
+  }
+  // Store the column index for later use.
+  int column = options.column == -1 ? GetColumnCount() : options.column;
+  g_object_set_data(G_OBJECT(renderer), "column", GINT_TO_POINTER(column));
+
+  // Create column, the first column shows the expanders.
+  auto* tree_column = gtk_tree_view_column_new_with_attributes(
+      title.c_str(), renderer, nullptr);
+  gtk_tree_view_column_set_sizing(tree_column, GTK_TREE_VIEW_COLUMN_FIXED);
+  gtk_tree_view_column_set_resizable(tree_column, true);
+  if (options.width != -1)
+    gtk_tree_view_column_set_fixed_width(tree_column, options.width);
+  gtk_tree_view_append_column(tree_view, tree_column);
+
+  // Pass the ColumnOptions to renderer.
+  auto* data = new Table::ColumnOptions(options);
+  data->column = column;
+  gtk_tree_view_column_set_cell_data_func(
+      tree_column, renderer, &TreeCellData, data,
+      &Delete<Table::ColumnOptions>);
+}
+
+int Tree::GetColumnCount() const {
+  return gtk_tree_view_get_n_columns(GetTreeView(this));
+}
+
+void Tree::SetColumnsVisible(bool visible) {
+  gtk_tree_view_set_headers_visible(GetTreeView(this), visible);
+}
+
+bool Tree::IsColumnsVisible() const {
+  return gtk_tree_view_get_headers_visible(GetTreeView(this));
+}
+
+void Tree::ExpandNode(NodeId node) {
+  ExpandNodeWithCallback(this, node, nullptr);
+}
+
+void Tree::CollapseNode(NodeId node) {
+  NUNodeModel* model = GetNodeModel(this);
+  GtkTreeIter iter;
+  if (!model || !nu_node_model_get_iter(model, node, &iter))
+    return;
+  GtkTreePath* path = gtk_tree_model_get_path(GTK_TREE_MODEL(model), &iter);
+  gtk_tree_view_collapse_row(GetTreeView(this), path);
+  gtk_tree_path_free(path);
+}
+
+bool Tree::IsNodeExpanded(NodeId node) const {
+  NUNodeModel* model = GetNodeModel(this);
+  GtkTreeIter iter;
+  if (!model || !nu_node_model_get_iter(model, node, &iter))
+    return false;
+  GtkTreePath* path = gtk_tree_model_get_path(GTK_TREE_MODEL(model), &iter);
+  bool expanded = gtk_tree_view_row_expanded(GetTreeView(this), path);
+  gtk_tree_path_free(path);
+  return expanded;
+}
+
+void Tree::SelectNode(NodeId node) {
+  NUNodeModel* model = GetNodeModel(this);
+  if (!model || !model_)
+    return;
+  base::WeakPtr<Tree> weak = AsWeakPtr();
+  auto select = [weak, model, node]() {
+    GtkTreeIter iter;
+    if (weak && GetNodeModel(weak.get()) == model &&
+        nu_node_model_get_iter(model, node, &iter))
+      gtk_tree_selection_select_iter(
+          gtk_tree_view_get_selection(GetTreeView(weak.get())), &iter);
+  };
+  // Make the node visible by expanding its parent.
+  NodeId parent = model_->GetParent(node);
+  if (parent == TreeModel::kRootNode) {
+    select();
+    return;
+  }
+  ExpandNodeWithCallback(this, parent, select);
+}
+
+Tree::NodeId Tree::GetSelectedNode() const {
+  GtkTreeModel* model = nullptr;
+  GtkTreeIter iter;
+  if (!gtk_tree_selection_get_selected(
+          gtk_tree_view_get_selection(GetTreeView(this)), &model, &iter))
+    return TreeModel::kRootNode;
+  return nu_node_model_get_node_id(NU_NODE_MODEL(model), &iter);
+}
+
+void Tree::NotifyChildrenChanged(NodeId parent) {
+  NUNodeModel* model = GetNodeModel(this);
+  if (model)
+    nu_node_model_update_children(model, parent);
+}
+
+void Tree::NotifyNodeChanged(NodeId node) {
+  NUNodeModel* model = GetNodeModel(this);
+  GtkTreeIter iter;
+  if (!model || !nu_node_model_get_iter(model, node, &iter))
+    return;
+  GtkTreePath* path = gtk_tree_model_get_path(GTK_TREE_MODEL(model), &iter);
+  gtk_tree_model_row_changed(GTK_TREE_MODEL(model), path, &iter);
+  gtk_tree_path_free(path);
+}
+
+}  // namespace nu
@@ -9,12 +9,17 @@
 #include "base/strings/stringprintf.h"
 #include "nativeui/container.h"
 #include "nativeui/events/event.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/point_f.h"
 #include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/gtk/frame_stats_recorder.h"
 #include "nativeui/gtk/nu_container.h"
 #include "nativeui/gtk/widget_util.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/window.h"
+#include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
 
@@ -28,8 +33,172 @@ struct NUViewPrivate {
   View* delegate;
   // Current view size.
   Size size;
+  // The windowless descendant under mouse, cleared when it is removed.
+  View* hovered_view = nullptr;
 };
 
+// Whether the events of |view| are dispatched by its ancestors.
+bool IsEventRouted(View* view) {
+  GtkWidget* widget = view->GetNative();
+  if (NU_IS_CONTAINER(widget))
+    return gtk_widget_get_realized(widget) &&
+           !nu_container_get_window(NU_CONTAINER(widget));
+  if (GTK_IS_LABEL(widget))
+    return !gtk_widget_get_has_window(widget);
+  return false;
+}
+
+// The origin of |view| in its parent, computed from the yoga frame.
+inline Vector2dF GetOriginInParent(View* view) {
+  return Vector2dF(YGNodeLayoutGetLeft(view->node()),
+                   YGNodeLayoutGetTop(view->node()));
+}
+
+// Find the deepest windowless view under |point| that has events dispatched
+// by |host|, the |point| is converted to the coordinates of the result.
+View* HitTestRoutedView(View* host, PointF* point) {
+  View* view = host;
+  while (view->IsContainer()) {
+    Container* container = static_cast<Container*>(view);
+    View* hit = nullptr;
+    // Views added later are on top.
+    for (int i = container->ChildCount() - 1; i >= 0; --i) {
+      View* child = container->ChildAt(i);
+      if (!child->IsVisible())
+        continue;
+      RectF frame(PointF() + GetOriginInParent(child),
+                  SizeF(YGNodeLayoutGetWidth(child->node()),
+                        YGNodeLayoutGetHeight(child->node())));
+      if (frame.Contains(*point)) {
+        hit = child;
+        break;
+      }
+    }
+    // Views that have their own windows or do not receive events stop the
+    // search.
+    if (!hit || !IsEventRouted(hit))
+      break;
+    *point -= GetOriginInParent(hit);
+    view = hit;
+  }
+  return view;
+}
+
+// Return whether |view| has events dispatched by |host|, and compute the
+// |offset| from |host| to |view|.
+bool IsRoutedDescendant(View* view, View* host, Vector2dF* offset) {
+  *offset = Vector2dF();
+  for (; view && view != host; view = view->GetParent()) {
+    if (!IsEventRouted(view))
+      return false;
+    *offset += GetOriginInParent(view);
+  }
+  return view == host;
+}
+
+// Whether |event| was sent to the event window of |view|, instead of being
+// propagated from the window of a child widget.
+bool IsOwnEvent(View* view, GdkEvent* event) {
+  GtkWidget* widget = view->GetNative();
+  GdkWindow* window = NU_IS_CONTAINER(widget) ?
+      nu_container_get_window(NU_CONTAINER(widget)) :
+      gtk_widget_get_window(widget);
+  return window && event->any.window == window;
+}
+
+// Find the view that should receive the mouse |event| sent to |host|, the
+// position of |event| is converted to the coordinates of the result.
+View* GetMouseEventTarget(View* host, MouseEvent* event) {
+  Vector2dF offset;
+  if (g_grabbed_view && g_grabbed_view != host &&
+      IsRoutedDescendant(g_grabbed_view, host, &offset)) {
+    event->position_in_view -= offset;
+    return g_grabbed_view;
+  }
+  return HitTestRoutedView(host, &event->position_in_view);
+}
+
+bool EmitMouseEvent(View* view, const MouseEvent& event) {
+  switch (event.type) {
+    case EventType::MouseDown:
+      return view->on_mouse_down.Emit(view, event);
+    case EventType::MouseUp:
+      return view->on_mouse_up.Emit(view, event);
+    case EventType::MouseMove:
+      view->on_mouse_move.Emit(view, event);
+      return false;
+    case EventType::MouseEnter:
+      view->on_mouse_enter.Emit(view, event);
+      return false;
+    case EventType::MouseLeave:
+      view->on_mouse_leave.Emit(view, event);
+      return false;
+    default:
+      return false;
+  }
+}
+
+// Give the lightweight items of |view| a chance to handle the |event|.
+bool DispatchMouseEventToItems(View* view, const MouseEvent& event) {
+  return view->IsContainer() &&
+         static_cast<Container*>(view)->DispatchMouseEventToItems(event);
+}
+
+// Emit |event| on |target| and then its ancestors until |host|, which matches
+// how GTK propagates events to parent widgets.
+bool DispatchMouseEvent(View* host, View* target, MouseEvent event) {
+  // Items are below the child views, so only the items of |target| can be
+  // under mouse.
+  if (DispatchMouseEventToItems(target, event))
+    return true;
+  for (View* view = target; ; view = view->GetParent()) {
+    if (EmitMouseEvent(view, event))
+      return true;
+    if (view == host)
+      return false;
+    event.position_in_view += GetOriginInParent(view);
+  }
+}
+
+// Emit enter and leave events when the windowless view under mouse changes.
+void UpdateHoveredView(View* host, View* target, const MouseEvent& event) {
+  NUViewPrivate* priv = static_cast<NUViewPrivate*>(
+      g_object_get_data(G_OBJECT(host->GetNative()), "private"));
+  if (priv->hovered_view == target)
+    return;
+  MouseEvent crossing = event;
+  crossing.type = EventType::MouseLeave;
+  if (priv->hovered_view && priv->hovered_view != host)
+    EmitMouseEvent(priv->hovered_view, crossing);
+  // The items of previous view are no longer under mouse.
+  if (priv->hovered_view)
+    DispatchMouseEventToItems(priv->hovered_view, crossing);
+  if (target && target != host) {
+    crossing.type = EventType::MouseEnter;
+    EmitMouseEvent(target, crossing);
+  }
+  priv->hovered_view = target;
+}
+
+// When |view| is removed, forget it in the ancestors that have it, or one of
+// its descendants, as hovered view, so it does not get leave events after
+// being detached.
+void OnParentSet(GtkWidget* widget, GtkWidget* previous_parent, View* view) {
+  for (GtkWidget* ancestor = previous_parent; ancestor;
+       ancestor = gtk_widget_get_parent(ancestor)) {
+    NUViewPrivate* priv = static_cast<NUViewPrivate*>(
+        g_object_get_data(G_OBJECT(ancestor), "private"));
+    if (!priv)
+      continue;
+    for (View* v = priv->hovered_view; v; v = v->GetParent()) {
+      if (v == view) {
+        priv->hovered_view = nullptr;
+        break;
+      }
+    }
+  }
+}
+
 void OnSizeAllocate(GtkWidget* widget, GdkRectangle* allocation,
                     NUViewPrivate* priv) {
   // Ignore empty sizes on initialization.
@@ -41,44 +210,85 @@ void OnSizeAllocate(GtkWidget* widget, GdkRectangle* allocation,
   Size size(allocation->width, allocation->height);
   if (size != priv->size) {
     priv->size = size;
+    // The window may want to defer the layout of its content view.
+    Window* window = priv->delegate->GetWindow();
+    if (window && window->GetContentView() == priv->delegate) {
+      if (window->ShouldDeferContentLayout())
+        return;
+      FrameStatsRecorder* recorder = GetFrameStatsRecorder(widget);
+      if (recorder) {
+        gint64 start = g_get_monotonic_time();
+        priv->delegate->OnSizeChanged();
+        recorder->RecordLayout(g_get_monotonic_time() - start);
+        return;
+      }
+    }
     priv->delegate->OnSizeChanged();
   }
 }
 
 gboolean OnMouseMove(GtkWidget* widget, GdkEvent* event, View* view) {
+  MouseEvent mouse_event(event, widget);
+  // Only the events of own window are routed, events propagated from child
+  // widgets have been seen by the views between, and their positions are
+  // relative to the child's window.
+  bool routed = IsOwnEvent(view, event);
+  View* target = view;
+  if (routed) {
+    target = GetMouseEventTarget(view, &mouse_event);
+    UpdateHoveredView(view, target, mouse_event);
+  }
+
   // If user is dragging a widget that supports mouseDownMoveWindow, then we
   // need to move the window.
-  if (event->motion.state & GDK_BUTTON1_MASK &&
-      view->IsMouseDownCanMoveWindow()) {
-    GtkWidget* toplevel = gtk_widget_get_toplevel(widget);
-    if (gtk_widget_is_toplevel(toplevel)) {
-      GdkWindow* window = gtk_widget_get_window(toplevel);
-      gdk_window_begin_move_drag(window, 1,
-                                 event->motion.x_root, event->motion.y_root,
-                                 event->motion.time);
-      return true;
+  if (event->motion.state & GDK_BUTTON1_MASK) {
+    for (View* v = target; v; v = v == view ? nullptr : v->GetParent()) {
+      if (!v->IsMouseDownCanMoveWindow())
+        continue;
+      GtkWidget* toplevel = gtk_widget_get_toplevel(widget);
+      if (gtk_widget_is_toplevel(toplevel)) {
+        GdkWindow* window = gtk_widget_get_window(toplevel);
+        gdk_window_begin_move_drag(window, 1,
+                                   event->motion.x_root, event->motion.y_root,
+                                   event->motion.time);
+        return true;
+      }
+      break;
     }
   }
 
   // Otherwise dispatch the event.
-  if (!view->on_mouse_move.IsEmpty()) {
-    view->on_mouse_move.Emit(view, MouseEvent(event, widget));
-    return false;
-  }
-
+  if (routed)
+    DispatchMouseEvent(view, target, mouse_event);
+  else
+    EmitMouseEvent(view, mouse_event);
   return false;
 }
 
 gboolean OnMouseEvent(GtkWidget* widget, GdkEvent* event, View* view) {
+  MouseEvent mouse_event(event, widget);
+  bool routed = IsOwnEvent(view, event);
   switch (event->any.type) {
     case GDK_BUTTON_PRESS:
-      return view->on_mouse_down.Emit(view, MouseEvent(event, widget));
-    case GDK_BUTTON_RELEASE:
-      return view->on_mouse_up.Emit(view, MouseEvent(event, widget));
-    case GDK_ENTER_NOTIFY:
-      view->on_mouse_enter.Emit(view, MouseEvent(event, widget));
+    case GDK_BUTTON_RELEASE: {
+      if (!routed)
+        return EmitMouseEvent(view, mouse_event);
+      View* target = GetMouseEventTarget(view, &mouse_event);
+      return DispatchMouseEvent(view, target, mouse_event);
+    }
+    case GDK_ENTER_NOTIFY: {
+      view->on_mouse_enter.Emit(view, mouse_event);
+      if (routed) {
+        View* target = GetMouseEventTarget(view, &mouse_event);
+        UpdateHoveredView(view, target, mouse_event);
+      }
       return false;
+    }
     case GDK_LEAVE_NOTIFY:
+      if (routed) {
+        UpdateHoveredView(view, nullptr, mouse_event);
+        DispatchMouseEventToItems(view, mouse_event);
+      }
       view->on_mouse_leave.Emit(view, MouseEvent(event, widget));
       return false;
     default:
@@ -94,6 +304,60 @@ gboolean OnKeyUp(GtkWidget* widget, GdkEvent* event, View* view) {
   return view->on_key_up.Emit(view, KeyEvent(event, widget));
 }
 
+// Pending request of CaptureToCanvasAsync.
+//
+// The request does not reference the view, instead it is failed when the
+// view's widget is destroyed, or is moved out of the window whose frame clock
+// the request is waiting for.
+struct CaptureRequest {
+  View* view;
+  float scale_factor;
+  View::CaptureCallback callback;
+  GdkFrameClock* clock;
+  gulong paint_handler;
+  gulong destroy_handler;
+  gulong hierarchy_handler;
+};
+
+// Disconnect the signals and run the callback out of the frame, so it can
+// safely change the views.
+void FinishCaptureRequest(CaptureRequest* request, Canvas* canvas) {
+  scoped_refptr<Canvas> result(canvas);
+  View::CaptureCallback callback = request->callback;
+  g_signal_handler_disconnect(request->clock, request->paint_handler);
+  g_signal_handler_disconnect(request->view->GetNative(),
+                              request->destroy_handler);
+  g_signal_handler_disconnect(request->view->GetNative(),
+                              request->hierarchy_handler);
+  g_object_unref(request->clock);
+  delete request;
+  MessageLoop::PostTask([result, callback]() {
+    callback(result.get());
+  });
+}
+
+void OnAfterPaint(GdkFrameClock* clock, CaptureRequest* request) {
+  // The view might be hidden or removed from window after the request.
+  if (!gtk_widget_is_drawable(request->view->GetNative())) {
+    FinishCaptureRequest(request, nullptr);
+    return;
+  }
+  // Capture while the painted content is current.
+  FinishCaptureRequest(request,
+                       request->view->CaptureToCanvas(request->scale_factor));
+}
+
+void OnCaptureViewDestroy(GtkWidget* widget, CaptureRequest* request) {
+  FinishCaptureRequest(request, nullptr);
+}
+
+// The view, or one of its ancestors, is removed from the window.
+void OnCaptureViewHierarchyChanged(GtkWidget* widget,
+                                   GtkWidget* previous_toplevel,
+                                   CaptureRequest* request) {
+  FinishCaptureRequest(request, nullptr);
+}
+
 }  // namespace
 
 void View::PlatformDestroy() {
@@ -122,6 +386,7 @@ void View::TakeOverView(NativeView view) {
 
   // Install event hooks.
   g_signal_connect(view, "size-allocate", G_CALLBACK(OnSizeAllocate), priv);
+  g_signal_connect(view, "parent-set", G_CALLBACK(OnParentSet), this);
   g_signal_connect(view, "motion-notify-event", G_CALLBACK(OnMouseMove), this);
   // TODO(zcbenz): Lazily install the event hooks.
   g_signal_connect(view, "button-press-event", G_CALLBACK(OnMouseEvent), this);
@@ -240,12 +505,18 @@ bool View::IsFocusable() const {
 }
 
 void View::SetCapture() {
+  // Windowless views grab the event window of the ancestor that dispatches
+  // their events.
+  View* host = this;
+  while (IsEventRouted(host) && host->GetParent())
+    host = host->GetParent();
+
   // Get the GDK window.
   GdkWindow* window;
-  if (NU_IS_CONTAINER(view_))
-    window = nu_container_get_window(NU_CONTAINER(view_));
+  if (NU_IS_CONTAINER(host->GetNative()))
+    window = nu_container_get_window(NU_CONTAINER(host->GetNative()));
   else
-    window = gtk_widget_get_window(view_);
+    window = gtk_widget_get_window(host->GetNative());
   if (!window)
     return;
 
@@ -273,6 +544,36 @@ bool View::HasCapture() const {
   return gdk_pointer_is_grabbed() && g_grabbed_view == this;
 }
 
+Canvas* View::CaptureToCanvas(float scale_factor) {
+  Canvas* canvas = new Canvas(GetBounds().size(), scale_factor);
+  // The canvas surface has the device scale set, so the widget is drawn in
+  // its own coordinates.
+  cairo_t* cr = cairo_create(canvas->GetBitmap());
+  gtk_widget_draw(view_, cr);
+  cairo_destroy(cr);
+  return canvas;
+}
+
+void View::CaptureToCanvasAsync(float scale_factor,
+                                const CaptureCallback& callback) {
+  // Views that are hidden or not in a window would never be painted.
+  GdkFrameClock* clock = gtk_widget_get_frame_clock(view_);
+  if (!clock || !gtk_widget_is_drawable(view_)) {
+    callback(nullptr);
+    return;
+  }
+  CaptureRequest* request = new CaptureRequest{this, scale_factor, callback};
+  request->clock = static_cast<GdkFrameClock*>(g_object_ref(clock));
+  request->paint_handler = g_signal_connect(
+      clock, "after-paint", G_CALLBACK(OnAfterPaint), request);
+  request->destroy_handler = g_signal_connect(
+      view_, "destroy", G_CALLBACK(OnCaptureViewDestroy), request);
+  request->hierarchy_handler = g_signal_connect(
+      view_, "hierarchy-changed", G_CALLBACK(OnCaptureViewHierarchyChanged),
+      request);
+  gtk_widget_queue_draw(view_);
+}
+
 void View::SetMouseDownCanMoveWindow(bool yes) {
   g_object_set_data(G_OBJECT(view_), "draggable", yes ? this : nullptr);
 }
@@ -0,0 +1,151 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <gtk/gtk.h>
+
+#include <string>
+#include <vector>
+
+#include "nativeui/gtk/nu_container.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Send a mouse event of |type| to |view| as if it happened on |window|.
+bool SendMouseEvent(nu::View* view, GdkEventType type, GdkWindow* window,
+                    double x, double y) {
+  GdkEvent* event = gdk_event_new(type);
+  event->any.window = static_cast<GdkWindow*>(g_object_ref(window));
+  if (type == GDK_MOTION_NOTIFY) {
+    event->motion.x = x;
+    event->motion.y = y;
+  } else {
+    event->button.x = x;
+    event->button.y = y;
+    event->button.button = 1;
+  }
+  GdkSeat* seat = gdk_display_get_default_seat(gdk_display_get_default());
+  gdk_event_set_device(event, gdk_seat_get_pointer(seat));
+  bool handled = gtk_widget_event(view->GetNative(), event);
+  gdk_event_free(event);
+  return handled;
+}
+
+}  // namespace
+
+// Three nested containers, only the outermost one has an event window.
+class ViewGtkTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    host_ = new nu::Container;
+    outer_ = new nu::Container;
+    outer_->SetStyle("width", 60, "height", 60);
+    inner_ = new nu::Container;
+    inner_->SetStyle("width", 30, "height", 30);
+    outer_->AddChildView(inner_.get());
+    host_->AddChildView(outer_.get());
+    window_->SetContentView(host_.get());
+    window_->SetContentSize(nu::SizeF(100, 100));
+    window_->SetVisible(true);
+    for (nu::View* view : {host_.get(), outer_.get(), inner_.get()}) {
+      view->on_mouse_down.Connect([this](nu::View* view,
+                                         const nu::MouseEvent&) {
+        events_.push_back(std::string("down ") + Name(view));
+        return false;
+      });
+      view->on_mouse_enter.Connect([this](nu::View* view,
+                                          const nu::MouseEvent&) {
+        events_.push_back(std::string("enter ") + Name(view));
+      });
+      view->on_mouse_leave.Connect([this](nu::View* view,
+                                          const nu::MouseEvent&) {
+        events_.push_back(std::string("leave ") + Name(view));
+      });
+    }
+  }
+
+  const char* Name(nu::View* view) const {
+    if (view == host_.get())
+      return "host";
+    return view == outer_.get() ? "outer" : "inner";
+  }
+
+  GdkWindow* HostWindow() const {
+    return nu_container_get_window(NU_CONTAINER(host_->GetNative()));
+  }
+
+  // A window that is not the event window of any container.
+  GdkWindow* OtherWindow() const {
+    return gtk_widget_get_window(GTK_WIDGET(window_->GetNative()));
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Container> host_;
+  scoped_refptr<nu::Container> outer_;
+  scoped_refptr<nu::Container> inner_;
+  std::vector<std::string> events_;
+};
+
+TEST_F(ViewGtkTest, RouteNestedContainers) {
+  ASSERT_TRUE(HostWindow());
+  EXPECT_FALSE(nu_container_get_window(NU_CONTAINER(outer_->GetNative())));
+  SendMouseEvent(host_.get(), GDK_BUTTON_PRESS, HostWindow(), 10, 10);
+  std::vector<std::string> expected = {
+      "down inner", "down outer", "down host",
+  };
+  EXPECT_EQ(events_, expected);
+
+  // Events propagated from a child's window are only emitted on the widgets
+  // GTK propagates them to.
+  events_.clear();
+  SendMouseEvent(outer_.get(), GDK_BUTTON_PRESS, OtherWindow(), 10, 10);
+  SendMouseEvent(host_.get(), GDK_BUTTON_PRESS, OtherWindow(), 10, 10);
+  expected = { "down outer", "down host" };
+  EXPECT_EQ(events_, expected);
+}
+
+TEST_F(ViewGtkTest, HoverNestedContainers) {
+  ASSERT_TRUE(HostWindow());
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, HostWindow(), 10, 10);
+  std::vector<std::string> expected = { "enter inner" };
+  EXPECT_EQ(events_, expected);
+
+  // Moving out of inner but still inside outer.
+  events_.clear();
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, HostWindow(), 50, 50);
+  expected = { "leave inner", "enter outer" };
+  EXPECT_EQ(events_, expected);
+
+  // Moving inside the same view does not emit crossing events.
+  events_.clear();
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, HostWindow(), 55, 55);
+  EXPECT_TRUE(events_.empty());
+
+  // Propagated events do not change the hovered view.
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, OtherWindow(), 10, 10);
+  EXPECT_TRUE(events_.empty());
+
+  // Moving to host itself.
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, HostWindow(), 80, 80);
+  expected = { "leave outer" };
+  EXPECT_EQ(events_, expected);
+}
+
+TEST_F(ViewGtkTest, HoveredViewRemoved) {
+  ASSERT_TRUE(HostWindow());
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, HostWindow(), 10, 10);
+  std::vector<std::string> expected = { "enter inner" };
+  EXPECT_EQ(events_, expected);
+
+  // The removed view does not get leave events after being detached.
+  events_.clear();
+  outer_->RemoveChildView(inner_.get());
+  SendMouseEvent(host_.get(), GDK_MOTION_NOTIFY, HostWindow(), 10, 10);
+  expected = { "enter outer" };
+  EXPECT_EQ(events_, expected);
+}
@@ -4,10 +4,20 @@
 
 #include "nativeui/gtk/widget_util.h"
 
+#include <string.h>
+
 #include <algorithm>
+#include <vector>
 
 #include "base/logging.h"
+#include "nativeui/app.h"
 #include "nativeui/gfx/color.h"
+#include "nativeui/memory_dump.h"
+#include "nativeui/state.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 #ifdef GDK_WINDOWING_X11
 #include <gdk/gdkx.h>
@@ -18,6 +28,19 @@ namespace nu {
 
 namespace {
 
+// Rough size of a parsed GtkCssProvider, not including the style text.
+const int64_t kCssProviderSize = 512;
+
+// Destroy notify of the providers created by ApplyStyle.
+void UnrefStyleProvider(gpointer data) {
+  // Only set when the creation was recorded.
+  int64_t bytes = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(data),
+                                                    "memory-bytes"));
+  if (bytes > 0)
+    RecordNativeMemory("GtkCssProvider", -1, -bytes);
+  g_object_unref(data);
+}
+
 bool CairoSurfaceExtents(cairo_surface_t* surface, GdkRectangle* extents) {
   double x1 = 0, y1 = 0, x2 = 0, y2 = 0;
   cairo_t* cr = cairo_create(surface);
@@ -31,6 +54,131 @@ bool CairoSurfaceExtents(cairo_surface_t* surface, GdkRectangle* extents) {
   return true;
 }
 
+// Return the first index in [x, end) whose pixel is fully transparent.
+// Only full-transparent pixels are treated as transparent, this is to match
+// the behavior of macOS and Win32.
+int FindTransparentPixel(const uint8_t* row, int x, int end) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128i zero = _mm_setzero_si128();
+  for (; x + 16 <= end; x += 16) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero));
+    if (mask)
+      return x + __builtin_ctz(mask);
+  }
+#else
+  for (; x + 8 <= end; x += 8) {
+    uint64_t pixels;
+    memcpy(&pixels, row + x, sizeof(pixels));
+    // Whether any byte is zero.
+    if ((pixels - 0x0101010101010101ULL) & ~pixels & 0x8080808080808080ULL)
+      break;
+  }
+#endif
+  while (x < end && row[x] != 0)
+    x++;
+  return x;
+}
+
+// Return the first index in [x, end) whose pixel is not fully transparent.
+int FindOpaquePixel(const uint8_t* row, int x, int end) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128i zero = _mm_setzero_si128();
+  for (; x + 16 <= end; x += 16) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+    int mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero)) & 0xFFFF;
+    if (mask)
+      return x + __builtin_ctz(mask);
+  }
+#else
+  for (; x + 8 <= end; x += 8) {
+    uint64_t pixels;
+    memcpy(&pixels, row + x, sizeof(pixels));
+    if (pixels)
+      break;
+  }
+#endif
+  while (x < end && row[x] == 0)
+    x++;
+  return x;
+}
+
+// Collect the rectangles of non-transparent pixels in A8 |data|, runs with
+// identical spans in consecutive rows are merged into one rectangle.
+void CollectOpaqueRects(const uint8_t* data, int stride,
+                        int width, int height,
+                        int offset_x, int offset_y,
+                        std::vector<cairo_rectangle_int_t>* rects) {
+  // Indices of rectangles that reach the previous row, sorted by x.
+  std::vector<size_t> open, next_open;
+  for (int y = 0; y < height; ++y) {
+    size_t o = 0;
+    int x = FindOpaquePixel(data, 0, width);
+    while (x < width) {
+      int ps = x;
+      x = FindTransparentPixel(data, x, width);
+      // Skip the rectangles that end before this run.
+      while (o < open.size() && (*rects)[open[o]].x < ps + offset_x)
+        o++;
+      cairo_rectangle_int_t* prev =
+          o < open.size() ? &(*rects)[open[o]] : nullptr;
+      if (prev && prev->x == ps + offset_x && prev->width == x - ps) {
+        // Extend the rectangle with the same span in previous row.
+        prev->height++;
+        next_open.push_back(open[o++]);
+      } else {
+        next_open.push_back(rects->size());
+        rects->push_back({ps + offset_x, y + offset_y, x - ps, 1});
+      }
+      x = FindOpaquePixel(data, x, width);
+    }
+    open.swap(next_open);
+    next_open.clear();
+    data += stride;
+  }
+}
+
+// Create region from pixels of |surface| inside |rect|, which must be inside
+// |extents| of the surface.
+cairo_region_t* CreateRegionInRect(cairo_surface_t* surface,
+                                   const GdkRectangle& extents,
+                                   const GdkRectangle& rect) {
+  // The entire surface is a region if there is no alpha channel.
+  if (cairo_surface_get_content(surface) == CAIRO_CONTENT_COLOR)
+    return cairo_region_create_rectangle(&rect);
+
+  cairo_surface_t* image;
+  const uint8_t* data;
+  int stride;
+  if (cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE ||
+      cairo_image_surface_get_format(surface) != CAIRO_FORMAT_A8) {
+    // We work on A8 images to get full alpha channel.
+    image = cairo_image_surface_create(CAIRO_FORMAT_A8,
+                                       rect.width, rect.height);
+    cairo_t* cr = cairo_create(image);
+    cairo_set_source_surface(cr, surface, -rect.x, -rect.y);
+    cairo_paint(cr);
+    cairo_surface_flush(image);
+    cairo_destroy(cr);
+    data = cairo_image_surface_get_data(image);
+    stride = cairo_image_surface_get_stride(image);
+  } else {
+    // Read the A8 image directly.
+    image = cairo_surface_reference(surface);
+    cairo_surface_flush(image);
+    stride = cairo_image_surface_get_stride(image);
+    data = cairo_image_surface_get_data(image) +
+           (rect.y - extents.y) * stride + (rect.x - extents.x);
+  }
+
+  std::vector<cairo_rectangle_int_t> rects;
+  CollectOpaqueRects(data, stride, rect.width, rect.height, rect.x, rect.y,
+                     &rects);
+  cairo_surface_destroy(image);
+  // Creating from all rectangles at once is much faster than unions.
+  return cairo_region_create_rectangles(rects.data(), rects.size());
+}
+
 }  // namespace
 
 bool GtkVersionCheck(int major, int minor, int micro) {
@@ -54,66 +202,54 @@ bool GtkVersionCheck(int major, int minor, int micro) {
 }
 
 SizeF GetPreferredSizeForWidget(GtkWidget* widget) {
+  // Measuring widgets creates Pango layouts.
+  WaitForFontWarmup();
   GtkRequisition size;
   gtk_widget_get_preferred_size(widget, nullptr, &size);
   return SizeF(size.width, size.height);
 }
 
+std::string GetDefaultFontName() {
+  gchar* font_name = nullptr;
+  g_object_get(gtk_settings_get_default(), "gtk-font-name", &font_name,
+               nullptr);
+  std::string result(font_name ? font_name : "Sans 10");
+  g_free(font_name);
+  return result;
+}
+
+void WaitForFontWarmup() {
+  if (State::GetCurrent())
+    App::GetCurrent()->WaitForFontWarmup();
+}
+
 cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface) {
   GdkRectangle extents;
   CairoSurfaceExtents(surface, &extents);
+  return CreateRegionInRect(surface, extents, extents);
+}
 
-  // The entire surface is a region if there is no alpha channel.
-  if (cairo_surface_get_content(surface) == CAIRO_CONTENT_COLOR)
-    return cairo_region_create_rectangle(&extents);
-
-  cairo_surface_t* image;
-  if (cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE ||
-      cairo_image_surface_get_format(surface) != CAIRO_FORMAT_A8) {
-    // We work on A8 images to get full alpha channel.
-    image = cairo_image_surface_create(CAIRO_FORMAT_A8,
-                                       extents.width, extents.height);
-    cairo_t* cr = cairo_create(image);
-    cairo_set_source_surface(cr, surface, -extents.x, -extents.y);
-    cairo_paint(cr);
-    cairo_surface_flush(image);
-    cairo_destroy(cr);
-  } else {
-    image = cairo_surface_reference(surface);
-    cairo_surface_flush(image);
-  }
-
-  cairo_region_t* region = cairo_region_create();
-
-  // Iterate through the image.
-  uint8_t* data = cairo_image_surface_get_data(image);
-  int stride = cairo_image_surface_get_stride(image);
-
-  for (int y = 0; y < extents.height; y++) {
-    for (int x = 0; x < extents.width; x++) {
-      // Find a row with all transparent pixels.
-      int ps = x;
-      while (x < extents.width) {
-        // Only full-transparent pixels are treated as transparent, this is
-        // to match the behavior of macOS and Win32.
-        if (data[x] == 0)
-          break;
-        x++;
-      }
-
-      if (x > ps) {
-        // Add the row to region.
-        GdkRectangle rect = {ps, y, x - ps, 1};
-        cairo_region_union_rectangle(region, &rect);
-      }
-    }
+bool UpdateRegionFromSurface(cairo_region_t* region,
+                             cairo_surface_t* surface,
+                             const GdkRectangle& dirty) {
+  GdkRectangle extents, rect;
+  CairoSurfaceExtents(surface, &extents);
+  if (!gdk_rectangle_intersect(&extents, &dirty, &rect))
+    return false;
 
-    data += stride;
+  // Leave the region untouched if nothing has changed, so callers can skip
+  // the costly update of window shape.
+  cairo_region_t* part = CreateRegionInRect(surface, extents, rect);
+  cairo_region_t* old = cairo_region_copy(region);
+  cairo_region_intersect_rectangle(old, &rect);
+  bool changed = !cairo_region_equal(old, part);
+  cairo_region_destroy(old);
+  if (changed) {
+    cairo_region_subtract_rectangle(region, &rect);
+    cairo_region_union(region, part);
   }
-
-  cairo_surface_destroy(image);
-  cairo_region_translate(region, extents.x, extents.y);
-  return region;
+  cairo_region_destroy(part);
+  return changed;
 }
 
 void ApplyStyle(GtkWidget* widget,
@@ -131,9 +267,15 @@ void ApplyStyle(GtkWidget* widget,
   gtk_style_context_add_provider(
       gtk_widget_get_style_context(widget),
       GTK_STYLE_PROVIDER(provider), G_MAXUINT);
+  if (IsMemoryTrackingEnabled()) {
+    int bytes = static_cast<int>(kCssProviderSize + style.length());
+    RecordNativeMemory("GtkCssProvider", 1, bytes);
+    g_object_set_data(G_OBJECT(provider), "memory-bytes",
+                      GINT_TO_POINTER(bytes));
+  }
   // Store the provider inside widget.
   g_object_set_data_full(G_OBJECT(widget), name.data(), provider,
-                         g_object_unref);
+                         UnrefStyleProvider);
 }
 
 bool IsUsingCSD(GtkWindow* window) {
@@ -7,6 +7,8 @@
 
 #include <gtk/gtk.h>
 
+#include <string>
+
 #include "base/strings/string_piece.h"
 #include "nativeui/gfx/geometry/insets_f.h"
 #include "nativeui/gfx/geometry/size_f.h"
@@ -20,10 +22,23 @@ bool GtkVersionCheck(int major = 0, int minor = 0, int micro = 0);
 
 SizeF GetPreferredSizeForWidget(NativeView widget);
 
+// Return the name of default font from GTK settings, like "Sans 10".
+std::string GetDefaultFontName();
+
+// Block until App::WarmupFonts finishes, should be called before any Pango
+// work on main thread. It does nothing when called from other threads.
+void WaitForFontWarmup();
+
 // Like gdk_cairo_region_create_from_surface, but also include semi-transparent
 // points into the region.
 cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface);
 
+// Recompute the part of |region| inside |dirty| from the pixels of |surface|,
+// return false if the region is not changed.
+bool UpdateRegionFromSurface(cairo_region_t* region,
+                             cairo_surface_t* surface,
+                             const GdkRectangle& dirty);
+
 // Apply CSS |style| on |widget|, the style with same |name| will be
 // overwritten.
 void ApplyStyle(GtkWidget* widget,
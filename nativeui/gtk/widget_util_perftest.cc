@@ -0,0 +1,38 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <math.h>
+
+#include "nativeui/gtk/widget_util.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A rounded window with shadows, which is the common case of frameless
+// transparent windows.
+TEST(WidgetUtilPerfTest, CreateRegionFromSurface) {
+  cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                        1920, 1080);
+  cairo_t* cr = cairo_create(surface);
+  cairo_new_sub_path(cr);
+  cairo_arc(cr, 1880, 40, 30, -M_PI / 2, 0);
+  cairo_arc(cr, 1880, 1040, 30, 0, M_PI / 2);
+  cairo_arc(cr, 40, 1040, 30, M_PI / 2, M_PI);
+  cairo_arc(cr, 40, 40, 30, M_PI, 3 * M_PI / 2);
+  cairo_close_path(cr);
+  cairo_set_source_rgba(cr, 1, 1, 1, 0.5);
+  cairo_fill(cr);
+  cairo_destroy(cr);
+
+  nu::RunPerfTest("WidgetUtil.CreateRegionFromSurface.1080p", 1080, [&]() {
+    cairo_region_destroy(nu::CreateRegionFromSurface(surface));
+  });
+
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface);
+  GdkRectangle dirty = {100, 100, 200, 30};
+  nu::RunPerfTest("WidgetUtil.UpdateRegionFromSurface.200x30", 30, [&]() {
+    nu::UpdateRegionFromSurface(region, surface, dirty);
+  });
+  cairo_region_destroy(region);
+  cairo_surface_destroy(surface);
+}
@@ -0,0 +1,67 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/widget_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Fill |rect| of A8 |surface| with |alpha|.
+void FillRect(cairo_surface_t* surface, int x, int y, int width, int height,
+              double alpha) {
+  cairo_t* cr = cairo_create(surface);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_rgba(cr, 0, 0, 0, alpha);
+  cairo_rectangle(cr, x, y, width, height);
+  cairo_fill(cr);
+  cairo_destroy(cr);
+}
+
+}  // namespace
+
+class WidgetUtilTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    surface_ = cairo_image_surface_create(CAIRO_FORMAT_A8, 100, 100);
+  }
+
+  void TearDown() override {
+    cairo_surface_destroy(surface_);
+  }
+
+  cairo_surface_t* surface_;
+};
+
+TEST_F(WidgetUtilTest, CreateRegionFromSurface) {
+  FillRect(surface_, 10, 10, 50, 30, 1);
+  FillRect(surface_, 30, 50, 3, 40, 0.1);
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface_);
+  cairo_region_t* expected = cairo_region_create();
+  cairo_rectangle_int_t r1 = {10, 10, 50, 30};
+  cairo_rectangle_int_t r2 = {30, 50, 3, 40};
+  cairo_region_union_rectangle(expected, &r1);
+  cairo_region_union_rectangle(expected, &r2);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+  // Identical spans are merged into tall rectangles.
+  EXPECT_EQ(cairo_region_num_rectangles(region), 2);
+  cairo_region_destroy(expected);
+  cairo_region_destroy(region);
+}
+
+TEST_F(WidgetUtilTest, UpdateRegionFromSurface) {
+  FillRect(surface_, 0, 0, 100, 100, 1);
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface_);
+  GdkRectangle dirty = {20, 20, 10, 10};
+  EXPECT_FALSE(nu::UpdateRegionFromSurface(region, surface_, dirty));
+  FillRect(surface_, 20, 20, 10, 10, 0);
+  // Changes outside the dirty rect are ignored.
+  FillRect(surface_, 50, 50, 10, 10, 0);
+  EXPECT_TRUE(nu::UpdateRegionFromSurface(region, surface_, dirty));
+  cairo_region_t* expected = cairo_region_create_rectangle(&dirty);
+  cairo_rectangle_int_t full = {0, 0, 100, 100};
+  cairo_region_xor_rectangle(expected, &full);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+  cairo_region_destroy(expected);
+  cairo_region_destroy(region);
+}
@@ -6,6 +6,7 @@
 
 #include <gtk/gtk.h>
 
+#include "nativeui/gtk/frame_stats_recorder.h"
 #include "nativeui/gtk/widget_util.h"
 #include "nativeui/menu_bar.h"
 
@@ -28,11 +29,31 @@ struct NUWindowPrivate {
   SizeF min_size;
   SizeF max_size;
   // Input shape fields.
-  bool is_input_shape_set = false;
+  cairo_region_t* input_shape = nullptr;
   bool is_draw_handler_set = false;
   guint draw_handler_id = 0;
+  // Resize throttling fields.
+  bool resize_throttled = false;
+  guint layout_tick_id = 0;
+  int skipped_layouts = 0;
+  guint resize_end_timer = 0;
+  // The client size set by SetBounds or SetContentSize, cleared once the
+  // window gets the size or the resizing ends.
+  Size requested_size;
+
+  ~NUWindowPrivate() {
+    if (input_shape)
+      cairo_region_destroy(input_shape);
+  }
 };
 
+// How long to wait without any size change before emitting on_resize_end.
+//
+// GTK does not tell when user stops dragging the window border, and the
+// window manager usually sends configure events at the rate of frames, so a
+// pause much longer than a frame means the resizing has ended.
+const guint kResizeEndDelayMs = 200;
+
 // Helper to receive private data.
 inline NUWindowPrivate* GetPrivate(const Window* window) {
   return static_cast<NUWindowPrivate*>(g_object_get_data(
@@ -90,16 +111,54 @@ void OnScreenChanged(GtkWidget* widget, GdkScreen* old_screen, Window* window) {
 // Set input shape for frameless transparent window.
 gboolean OnDraw(GtkWidget* widget, cairo_t* cr, NUWindowPrivate* priv) {
   cairo_surface_t* surface = cairo_get_target(cr);
-  cairo_region_t* region = CreateRegionFromSurface(surface);
-  gtk_widget_input_shape_combine_region(widget, region);
-  cairo_region_destroy(region);
-  // Only handle once.
-  priv->is_draw_handler_set = false;
-  priv->is_input_shape_set = true;
-  g_signal_handler_disconnect(widget, priv->draw_handler_id);
+  if (!priv->input_shape) {
+    priv->input_shape = CreateRegionFromSurface(surface);
+  } else {
+    // Only recompute the redrawn area.
+    GdkRectangle dirty;
+    if (!gdk_cairo_get_clip_rectangle(cr, &dirty) ||
+        !UpdateRegionFromSurface(priv->input_shape, surface, dirty))
+      return FALSE;
+  }
+  gtk_widget_input_shape_combine_region(widget, priv->input_shape);
   return FALSE;
 }
 
+// Do the deferred layout of content view in the frame clock.
+gboolean OnLayoutTick(GtkWidget* widget, GdkFrameClock* clock,
+                      NUWindowPrivate* priv) {
+  priv->layout_tick_id = 0;
+  View* content_view = priv->delegate->GetContentView();
+  if (content_view) {
+    gint64 start = g_get_monotonic_time();
+    content_view->OnSizeChanged();
+    FrameStatsRecorder* recorder = GetFrameStatsRecorder(widget);
+    if (recorder)
+      recorder->RecordLayout(g_get_monotonic_time() - start);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+// No size change happened for a while, assume resizing has ended.
+gboolean OnResizeEndTimer(NUWindowPrivate* priv) {
+  priv->resize_end_timer = 0;
+  priv->requested_size = Size();
+  priv->delegate->on_resize_end.Emit(priv->delegate);
+  return G_SOURCE_REMOVE;
+}
+
+// Remove pending sources before private data is freed.
+void OnDestroy(GtkWidget* widget, NUWindowPrivate* priv) {
+  if (priv->layout_tick_id) {
+    gtk_widget_remove_tick_callback(widget, priv->layout_tick_id);
+    priv->layout_tick_id = 0;
+  }
+  if (priv->resize_end_timer) {
+    g_source_remove(priv->resize_end_timer);
+    priv->resize_end_timer = 0;
+  }
+}
+
 // Get the height of menubar.
 inline int GetMenuBarHeight(const Window* window) {
   int menu_bar_height = 0;
@@ -131,6 +190,7 @@ void Window::PlatformInit(const Options& options) {
                    G_CALLBACK(OnWindowState), priv);
   g_signal_connect(window_, "notify::is-active",
                    G_CALLBACK(OnIsActiveChanged), this);
+  g_signal_connect(window_, "destroy", G_CALLBACK(OnDestroy), priv);
 
   if (!options.frame) {
     // Rely on client-side decoration to provide window features for frameless
@@ -189,11 +249,15 @@ void Window::PlatformSetContentView(View* view) {
   ForceSizeAllocation(window_, GTK_WIDGET(vbox));
 
   // For frameless transparent window, we need to set input shape to allow
-  // click-through in transparent areas. For best performance we only set
-  // input shape the first time when content view is drawn, GTK do redraws very
-  // frequently and computing input shape is rather expensive.
+  // click-through in transparent areas. The input shape is computed for the
+  // whole window when content view is drawn for the first time, and later
+  // redraws only update the dirty areas.
   if (IsTransparent() && !HasFrame()) {
     NUWindowPrivate* priv = GetPrivate(this);
+    if (priv->input_shape) {
+      cairo_region_destroy(priv->input_shape);
+      priv->input_shape = nullptr;
+    }
     if (!priv->is_draw_handler_set) {
       priv->is_draw_handler_set = true;
       priv->draw_handler_id = g_signal_connect_after(
@@ -228,14 +292,20 @@ void Window::Center() {
 
 void Window::SetContentSize(const SizeF& size) {
   // Menubar is part of client area in GTK.
-  ResizeWindow(window_, IsResizable(),
-               size.width(), size.height() + GetMenuBarHeight(this));
+  int width = size.width();
+  int height = size.height() + GetMenuBarHeight(this);
+  GetPrivate(this)->requested_size = Size(width, height);
+  ResizeWindow(window_, IsResizable(), width, height);
 }
 
 void Window::SetBounds(const RectF& bounds) {
   RectF cbounds(bounds);
-  cbounds.Inset(GetPrivate(this)->native_frame);
-  ResizeWindow(window_, IsResizable(), cbounds.width(), cbounds.height());
+  NUWindowPrivate* priv = GetPrivate(this);
+  cbounds.Inset(priv->native_frame);
+  int width = cbounds.width();
+  int height = cbounds.height();
+  priv->requested_size = Size(width, height);
+  ResizeWindow(window_, IsResizable(), width, height);
   gtk_window_move(window_, cbounds.x(), cbounds.y());
 }
 
@@ -341,6 +411,7 @@ std::tuple<SizeF, SizeF> Window::GetContentSizeConstraints() const {
 }
 
 void Window::Activate() {
+  WaitForFontWarmup();
   if (!IsVisible())
     gtk_window_set_focus_on_map(window_, true);
   gtk_window_present(window_);
@@ -355,6 +426,9 @@ bool Window::IsActive() const {
 }
 
 void Window::SetVisible(bool visible) {
+  // Mapping the window lays out and draws the text of widgets.
+  if (visible)
+    WaitForFontWarmup();
   gtk_widget_set_visible(GTK_WIDGET(window_), visible);
 }
 
@@ -510,6 +584,99 @@ void Window::PlatformSetMenuBar(MenuBar* menu_bar) {
   ForceSizeAllocation(window_, GTK_WIDGET(vbox));
 }
 
+void Window::SetResizeThrottled(bool throttled) {
+  NUWindowPrivate* priv = GetPrivate(this);
+  priv->resize_throttled = throttled;
+  // Flush the pending layout.
+  if (!throttled && priv->layout_tick_id) {
+    gtk_widget_remove_tick_callback(GTK_WIDGET(window_), priv->layout_tick_id);
+    priv->layout_tick_id = 0;
+    content_view_->OnSizeChanged();
+  }
+}
+
+bool Window::IsResizeThrottled() const {
+  return GetPrivate(this)->resize_throttled;
+}
+
+int Window::GetSkippedLayoutCount() const {
+  return GetPrivate(this)->skipped_layouts;
+}
+
+void Window::SetFrameStatsEnabled(bool enabled) {
+  if (enabled == IsFrameStatsEnabled())
+    return;
+  g_object_set_data_full(
+      G_OBJECT(window_), "frame-stats",
+      enabled ? new FrameStatsRecorder(GTK_WIDGET(window_)) : nullptr,
+      Delete<FrameStatsRecorder>);
+}
+
+bool Window::IsFrameStatsEnabled() const {
+  return GetFrameStatsRecorder(GTK_WIDGET(window_)) != nullptr;
+}
+
+Window::FrameStats Window::GetFrameStats() const {
+  FrameStatsRecorder* recorder = GetFrameStatsRecorder(GTK_WIDGET(window_));
+  return recorder ? recorder->GetStats() : FrameStats();
+}
+
+void Window::ResetFrameStats() {
+  FrameStatsRecorder* recorder = GetFrameStatsRecorder(GTK_WIDGET(window_));
+  if (recorder)
+    recorder->Reset();
+}
+
+void Window::SetFrameStatsOverlayVisible(bool visible) {
+  if (visible)
+    SetFrameStatsEnabled(true);
+  FrameStatsRecorder* recorder = GetFrameStatsRecorder(GTK_WIDGET(window_));
+  if (recorder)
+    recorder->set_overlay_visible(visible);
+  gtk_widget_queue_draw(GTK_WIDGET(window_));
+}
+
+bool Window::IsFrameStatsOverlayVisible() const {
+  FrameStatsRecorder* recorder = GetFrameStatsRecorder(GTK_WIDGET(window_));
+  return recorder && recorder->overlay_visible();
+}
+
+bool Window::ShouldDeferContentLayout() {
+  NUWindowPrivate* priv = GetPrivate(this);
+  // Restart the timer for detecting the end of resizing, size changes made by
+  // SetBounds and SetContentSize are not resizing done by user.
+  GtkWidget* vbox = gtk_bin_get_child(GTK_BIN(window_));
+  Size client_size(gtk_widget_get_allocated_width(vbox),
+                   gtk_widget_get_allocated_height(vbox));
+  if (client_size == priv->requested_size) {
+    // The size set by SetBounds or SetContentSize has been applied, later
+    // changes to the same size are made by user.
+    priv->requested_size = Size();
+  } else if (!on_resize_end.IsEmpty()) {
+    if (priv->resize_end_timer)
+      g_source_remove(priv->resize_end_timer);
+    priv->resize_end_timer = g_timeout_add(
+        kResizeEndDelayMs, reinterpret_cast<GSourceFunc>(OnResizeEndTimer),
+        priv);
+  }
+
+  // Layout immediately if the window is not shown yet, otherwise there would
+  // be no frame to do the layout.
+  if (!priv->resize_throttled || !gtk_widget_get_mapped(GTK_WIDGET(window_)))
+    return false;
+
+  // There is already a pending layout, the new size will be picked up by it.
+  if (priv->layout_tick_id) {
+    priv->skipped_layouts++;
+    return true;
+  }
+
+  priv->layout_tick_id = gtk_widget_add_tick_callback(
+      GTK_WIDGET(window_), reinterpret_cast<GtkTickCallback>(OnLayoutTick),
+      priv, nullptr);
+  return true;
+}
+
 void Window::PlatformAddChildWindow(Window* child) {
   gtk_window_set_transient_for(child->GetNative(), window_);
 }
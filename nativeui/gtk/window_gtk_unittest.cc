@@ -0,0 +1,70 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <gtk/gtk.h>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class WindowGtkTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetVisible(true);
+  }
+
+  // Allocate the client area as if user is resizing the window.
+  void AllocateClientArea(int width, int height) {
+    GtkWidget* vbox = gtk_bin_get_child(GTK_BIN(window_->GetNative()));
+    GtkAllocation allocation = { 0, 0, width, height };
+    gtk_widget_size_allocate(vbox, &allocation);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+};
+
+TEST_F(WindowGtkTest, ResizeThrottledSkipsLayouts) {
+  // The bounds of child are only updated by layout.
+  scoped_refptr<nu::Container> child(new nu::Container);
+  child->SetStyle("flex", 1);
+  static_cast<nu::Container*>(window_->GetContentView())->AddChildView(
+      child.get());
+  window_->SetResizeThrottled(true);
+  ASSERT_TRUE(gtk_widget_get_mapped(GTK_WIDGET(window_->GetNative())));
+  // Only the first size change schedules a layout, the others are picked up
+  // by it.
+  AllocateClientArea(210, 210);
+  AllocateClientArea(220, 220);
+  AllocateClientArea(230, 230);
+  EXPECT_EQ(window_->GetSkippedLayoutCount(), 2);
+  EXPECT_NE(child->GetBounds().size(), nu::SizeF(230, 230));
+
+  // The pending layout is flushed when disabling throttling, and later size
+  // changes are not skipped.
+  window_->SetResizeThrottled(false);
+  EXPECT_EQ(child->GetBounds().size(), nu::SizeF(230, 230));
+  AllocateClientArea(240, 240);
+  EXPECT_EQ(window_->GetSkippedLayoutCount(), 2);
+  EXPECT_EQ(child->GetBounds().size(), nu::SizeF(240, 240));
+}
+
+TEST_F(WindowGtkTest, OnResizeEndAfterQuietPeriod) {
+  gint64 ended_time = 0;
+  window_->on_resize_end.Connect([&ended_time](nu::Window*) {
+    ended_time = g_get_monotonic_time();
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::PostDelayedTask(2000, []() {
+    nu::MessageLoop::Quit();
+  });
+  gint64 start_time = g_get_monotonic_time();
+  AllocateClientArea(210, 210);
+  AllocateClientArea(220, 220);
+  nu::MessageLoop::Run();
+  ASSERT_NE(ended_time, 0);
+  // Emitted only after no size change for 200ms.
+  EXPECT_GE(ended_time - start_time, 200 * 1000);
+}
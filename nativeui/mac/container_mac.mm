@@ -45,6 +45,7 @@
   painter.SetColor(background_color_);
   painter.FillRect(dirty);
   shell->on_draw.Emit(shell, &painter, dirty);
+  shell->DrawItems(&painter, dirty);
 }
 
 @end
@@ -7,6 +7,7 @@
 #include <objc/objc-runtime.h>
 
 #include "base/logging.h"
+#include "nativeui/container.h"
 #include "nativeui/events/event.h"
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_view.h"
@@ -82,6 +83,9 @@ bool DispatchMouseEvent(View* view, NSEvent* event) {
   bool prevent_default = false;
   NUPrivate* priv = [view->GetNative() nuPrivate];
   MouseEvent mouse_event(event, view->GetNative());
+  if (view->IsContainer() &&
+      static_cast<Container*>(view)->DispatchMouseEventToItems(mouse_event))
+    return true;
   switch (mouse_event.type) {
     case EventType::MouseDown:
       prevent_default = view->on_mouse_down.Emit(view, mouse_event);
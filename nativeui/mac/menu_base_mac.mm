@@ -8,13 +8,37 @@
 
 #include "nativeui/menu_item.h"
 
+@interface NUMenuDelegate : NSObject<NSMenuDelegate> {
+ @private
+  nu::MenuBase* shell_;
+}
+- (id)initWithShell:(nu::MenuBase*)shell;
+@end
+
+@implementation NUMenuDelegate
+
+- (id)initWithShell:(nu::MenuBase*)shell {
+  if ((self = [super init]))
+    shell_ = shell;
+  return self;
+}
+
+- (void)menuWillOpen:(NSMenu*)menu {
+  shell_->on_will_open.Emit(shell_);
+}
+
+@end
+
 namespace nu {
 
 void MenuBase::PlatformInit() {
   [menu_ setAutoenablesItems:NO];
+  [menu_ setDelegate:[[NUMenuDelegate alloc] initWithShell:this]];
 }
 
 void MenuBase::PlatformDestroy() {
+  [[menu_ delegate] release];
+  [menu_ setDelegate:nil];
   [menu_ release];
 }
 
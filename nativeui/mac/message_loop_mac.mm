@@ -84,6 +84,12 @@ MessageLoop::TimerId MessageLoop::SetTimeout(int ms, const Task& task) {
   return id;
 }
 
+// static
+MessageLoop::TimerId MessageLoop::SetIdleTimeout(const Task& task) {
+  // The main queue is only served after the pending events are handled.
+  return SetTimeout(0, task);
+}
+
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
   base::AutoLock auto_lock(lock_);
@@ -33,9 +33,10 @@
 }
 
 - (void)drawRect:(NSRect)dirtyRect {
-  if (options_.on_draw) {
+  if (options_.HasDrawHandler()) {
     nu::PainterMac painter;
-    options_.on_draw(&painter, nu::RectF(dirtyRect), value_);
+    options_.Draw(&painter, nu::RectF(dirtyRect),
+                  nu::TableCell::FromValue(&value_));
   }
 }
 
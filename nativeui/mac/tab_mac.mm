@@ -27,6 +27,7 @@
 
 - (void)tabView:(NSTabView*)tabView
     didSelectTabViewItem:(NSTabViewItem*)tabViewItem {
+  shell_->OnPageSelected([tabView indexOfTabViewItem:tabViewItem]);
   shell_->on_selected_page_change.Emit(shell_);
 }
 
@@ -94,6 +95,10 @@ void Tab::PlatformRemovePage(int index, View* view) {
   [tab removeTabViewItem:[tab tabViewItemAtIndex:index]];
 }
 
+void Tab::PlatformUnloadPage(View* view) {
+  // NSTabView already removes hidden pages from the view hierarchy.
+}
+
 void Tab::SelectPageAt(int index) {
   auto* tab = static_cast<NUTab*>(GetNative());
   if (index >= 0 && index < [tab numberOfTabViewItems])
@@ -113,6 +113,13 @@ void TextEdit::SetText(const std::string& text) {
   [textView setString:base::SysUTF8ToNSString(text)];
 }
 
+size_t TextEdit::EstimateMemoryUsage() const {
+  // The text buffer is usually much larger than the view itself.
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  return sizeof(TextEdit) + [[textView textStorage] length] * sizeof(unichar);
+}
+
 std::string TextEdit::GetText() const {
   auto* textView = static_cast<NSTextView*>(
       [static_cast<NUTextEdit*>(GetNative()) documentView]);
@@ -51,6 +51,10 @@
   shell_->on_blur.Emit(shell_);
 }
 
+- (void)windowDidEndLiveResize:(NSNotification*)notification {
+  shell_->on_resize_end.Emit(shell_);
+}
+
 @end
 
 namespace nu {
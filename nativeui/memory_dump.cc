@@ -0,0 +1,174 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/memory_dump.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "nativeui/container.h"
+#include "nativeui/group.h"
+#include "nativeui/scroll.h"
+#include "nativeui/tab.h"
+#include "nativeui/window.h"
+
+namespace nu {
+
+namespace {
+
+// Count and bytes of natively recorded objects, the bytes is signed so a
+// destruction recorded before its creation does not wrap around.
+struct RecordedUsage {
+  int count = 0;
+  int64_t bytes = 0;
+};
+
+// Objects may be created and destroyed on different threads.
+struct MemoryRegistry {
+  // Checked before taking the lock, so untracked objects never touch it.
+  std::atomic<bool> enabled{false};
+  base::Lock lock;
+  // Tracked objects and the threads that created them.
+  std::map<MemoryTracked*, base::PlatformThreadId> tracked;
+  std::map<std::string, RecordedUsage> recorded;
+};
+
+MemoryRegistry* GetRegistry() {
+  // Leaked on purpose, objects can be destroyed during exit.
+  static MemoryRegistry* registry = new MemoryRegistry;
+  return registry;
+}
+
+// Return the views that are directly managed by |view|.
+std::vector<View*> GetChildViews(View* view) {
+  std::vector<View*> children;
+  const char* name = view->GetClassName();
+  if (view->IsContainer()) {
+    auto* container = static_cast<Container*>(view);
+    for (int i = 0; i < container->ChildCount(); ++i)
+      children.push_back(container->ChildAt(i));
+  } else if (name == Scroll::kClassName) {
+    children.push_back(static_cast<Scroll*>(view)->GetContentView());
+  } else if (name == Group::kClassName) {
+    children.push_back(static_cast<Group*>(view)->GetContentView());
+  } else if (name == Tab::kClassName) {
+    auto* tab = static_cast<Tab*>(view);
+    for (int i = 0; i < tab->PageCount(); ++i)
+      children.push_back(tab->PageAt(i));
+  }
+  return children;
+}
+
+}  // namespace
+
+void EnableMemoryTracking() {
+  GetRegistry()->enabled.store(true);
+}
+
+bool IsMemoryTrackingEnabled() {
+  return GetRegistry()->enabled.load(std::memory_order_relaxed);
+}
+
+std::map<std::string, MemoryUsage> GetMemoryUsage() {
+  MemoryRegistry* registry = GetRegistry();
+  std::map<std::string, MemoryUsage> result;
+  if (!IsMemoryTrackingEnabled())
+    return result;
+  std::vector<MemoryTracked*> objects;
+  {
+    base::AutoLock auto_lock(registry->lock);
+    for (const auto& it : registry->recorded) {
+      MemoryUsage& usage = result[it.first];
+      usage.count = it.second.count;
+      usage.bytes = static_cast<uint64_t>(std::max<int64_t>(it.second.bytes,
+                                                            0));
+    }
+    // Only objects of current thread can be estimated, objects on other
+    // threads may be in the middle of construction or destruction. Calling
+    // virtual methods under the lock could also deadlock when they create
+    // or destroy tracked objects.
+    base::PlatformThreadId current = base::PlatformThread::CurrentId();
+    for (const auto& it : registry->tracked) {
+      if (it.second == current)
+        objects.push_back(it.first);
+    }
+  }
+  // Objects of current thread can not be destroyed while we are running.
+  for (MemoryTracked* object : objects) {
+    MemoryUsage& usage = result[object->GetMemoryClassName()];
+    usage.count++;
+    usage.bytes += object->EstimateMemoryUsage();
+  }
+  // Do not report classes that have no live objects.
+  for (auto it = result.begin(); it != result.end();) {
+    if (it->second.count <= 0)
+      it = result.erase(it);
+    else
+      ++it;
+  }
+  return result;
+}
+
+void RecordNativeMemory(const char* class_name, int count, int64_t bytes) {
+  if (!IsMemoryTrackingEnabled())
+    return;
+  MemoryRegistry* registry = GetRegistry();
+  base::AutoLock auto_lock(registry->lock);
+  RecordedUsage& usage = registry->recorded[class_name];
+  usage.count += count;
+  usage.bytes += bytes;
+}
+
+MemoryTracked::MemoryTracked() {
+  if (!IsMemoryTrackingEnabled())
+    return;
+  MemoryRegistry* registry = GetRegistry();
+  base::AutoLock auto_lock(registry->lock);
+  registry->tracked[this] = base::PlatformThread::CurrentId();
+  is_memory_tracked_ = true;
+}
+
+MemoryTracked::~MemoryTracked() {
+  if (!is_memory_tracked_)
+    return;
+  MemoryRegistry* registry = GetRegistry();
+  base::AutoLock auto_lock(registry->lock);
+  registry->tracked.erase(this);
+}
+
+MemoryDump::MemoryDump() {}
+
+MemoryDump::MemoryDump(const MemoryDump& other) = default;
+
+MemoryDump::~MemoryDump() {}
+
+// static
+MemoryDump MemoryDump::FromView(View* view) {
+  MemoryDump dump;
+  if (!view)
+    return dump;
+  dump.view = view;
+  dump.class_name = view->GetClassName();
+  dump.self_bytes = view->EstimateMemoryUsage();
+  dump.total_bytes = dump.self_bytes;
+  dump.view_count = 1;
+  for (View* child : GetChildViews(view)) {
+    if (!child)
+      continue;
+    dump.children.push_back(FromView(child));
+    dump.total_bytes += dump.children.back().total_bytes;
+    dump.view_count += dump.children.back().view_count;
+  }
+  return dump;
+}
+
+// static
+MemoryDump MemoryDump::FromWindow(Window* window) {
+  return FromView(window->GetContentView());
+}
+
+}  // namespace nu
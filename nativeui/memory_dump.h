@@ -0,0 +1,97 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_MEMORY_DUMP_H_
+#define NATIVEUI_MEMORY_DUMP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class View;
+class Window;
+
+// Live object count and estimated native memory of a class.
+struct NATIVEUI_EXPORT MemoryUsage {
+  int count = 0;
+  uint64_t bytes = 0;
+};
+
+// Start tracking native objects for GetMemoryUsage. Objects created before
+// calling it are not counted, and tracking can not be stopped once started.
+//
+// Tracking is off by default so creating and destroying objects costs nothing
+// when nobody asks for memory usage.
+NATIVEUI_EXPORT void EnableMemoryTracking();
+NATIVEUI_EXPORT bool IsMemoryTrackingEnabled();
+
+// Return the memory usage of live native objects created after tracking was
+// enabled, keyed by class name.
+// Only objects created on the calling thread, which should be the GUI thread,
+// are reported: objects of other threads can not be safely estimated.
+NATIVEUI_EXPORT std::map<std::string, MemoryUsage> GetMemoryUsage();
+
+// Internal: Record creation (positive |count|) or destruction (negative
+// |count|) of native objects that do not inherit from MemoryTracked. It does
+// nothing when tracking is not enabled, so callers should only record the
+// destruction of objects whose creation was recorded.
+NATIVEUI_EXPORT void RecordNativeMemory(const char* class_name,
+                                        int count,
+                                        int64_t bytes);
+
+// Internal: Objects inheriting from this class are reported by GetMemoryUsage.
+// The estimation is only computed when memory usage is queried, on the thread
+// that created the object.
+class NATIVEUI_EXPORT MemoryTracked {
+ public:
+  // The name used for grouping objects.
+  virtual const char* GetMemoryClassName() const = 0;
+
+  // Estimated bytes of native memory owned by the object, not including its
+  // children.
+  virtual size_t EstimateMemoryUsage() const = 0;
+
+ protected:
+  MemoryTracked();
+  virtual ~MemoryTracked();
+
+  // Whether the object was created when tracking was enabled.
+  bool is_memory_tracked() const { return is_memory_tracked_; }
+
+ private:
+  bool is_memory_tracked_ = false;
+};
+
+// The memory usage of a view and its children.
+struct NATIVEUI_EXPORT MemoryDump {
+  MemoryDump();
+  MemoryDump(const MemoryDump& other);
+  ~MemoryDump();
+
+  // Walk the view tree.
+  static MemoryDump FromView(View* view);
+  static MemoryDump FromWindow(Window* window);
+
+  scoped_refptr<View> view;
+  std::string class_name;
+  // Memory of the view itself.
+  uint64_t self_bytes = 0;
+  // Memory of the whole subtree.
+  uint64_t total_bytes = 0;
+  // Number of views in the subtree, including the view itself.
+  int view_count = 0;
+  std::vector<MemoryDump> children;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_MEMORY_DUMP_H_
@@ -0,0 +1,97 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class MemoryDumpTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    nu::EnableMemoryTracking();
+  }
+
+  int GetLiveCount(const std::string& class_name) {
+    auto usage = nu::GetMemoryUsage();
+    auto it = usage.find(class_name);
+    return it == usage.end() ? 0 : it->second.count;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(MemoryDumpTest, LiveCount) {
+  int labels = GetLiveCount(nu::Label::kClassName);
+  int nodes = GetLiveCount("YogaNode");
+  {
+    scoped_refptr<nu::Label> label(new nu::Label("label"));
+    EXPECT_EQ(GetLiveCount(nu::Label::kClassName), labels + 1);
+    EXPECT_EQ(GetLiveCount("YogaNode"), nodes + 1);
+  }
+  EXPECT_EQ(GetLiveCount(nu::Label::kClassName), labels);
+  EXPECT_EQ(GetLiveCount("YogaNode"), nodes);
+}
+
+TEST_F(MemoryDumpTest, ClampRecordedBytes) {
+  // Destruction estimated larger than creation does not wrap around.
+  nu::RecordNativeMemory("TestObject", 1, 10);
+  nu::RecordNativeMemory("TestObject", 0, -100);
+  auto usage = nu::GetMemoryUsage();
+  ASSERT_EQ(usage.count("TestObject"), 1u);
+  EXPECT_EQ(usage["TestObject"].count, 1);
+  EXPECT_EQ(usage["TestObject"].bytes, 0u);
+  nu::RecordNativeMemory("TestObject", -1, 90);
+  EXPECT_EQ(GetLiveCount("TestObject"), 0);
+}
+
+TEST_F(MemoryDumpTest, TableModelBytes) {
+  scoped_refptr<nu::SimpleTableModel> model(new nu::SimpleTableModel(1));
+  size_t empty = model->EstimateMemoryUsage();
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(std::string(1000, 'a'));
+  model->AddRow(std::move(row));
+  EXPECT_GE(model->EstimateMemoryUsage(), empty + 1000);
+}
+
+TEST_F(MemoryDumpTest, ViewTree) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  nu::Container* content = new nu::Container;
+  window->SetContentView(content);
+  nu::Scroll* scroll = new nu::Scroll;
+  content->AddChildView(scroll);
+  content->AddChildView(new nu::Label("label"));
+  scroll->SetContentView(new nu::TextEdit);
+
+  nu::MemoryDump dump = nu::MemoryDump::FromWindow(window.get());
+  EXPECT_EQ(dump.view.get(), content);
+  EXPECT_EQ(dump.view_count, 4);
+  ASSERT_EQ(dump.children.size(), 2u);
+  EXPECT_EQ(dump.children[0].class_name, nu::Scroll::kClassName);
+  EXPECT_EQ(dump.children[0].view_count, 2);
+  EXPECT_EQ(dump.total_bytes,
+            dump.self_bytes + dump.children[0].total_bytes +
+            dump.children[1].total_bytes);
+}
+
+TEST(MemoryTrackingTest, ObjectsCreatedBeforeEnabling) {
+  nu::Lifetime lifetime;
+  nu::State state;
+  // Objects created before enabling are not tracked, and destroying them
+  // after enabling does not change the counts.
+  bool enabled = nu::IsMemoryTrackingEnabled();
+  scoped_refptr<nu::Label> label(new nu::Label("label"));
+  nu::EnableMemoryTracking();
+  auto usage = nu::GetMemoryUsage();
+  int labels = usage[nu::Label::kClassName].count;
+  int nodes = usage["YogaNode"].count;
+  label = nullptr;
+  usage = nu::GetMemoryUsage();
+  if (enabled) {
+    EXPECT_EQ(usage[nu::Label::kClassName].count, labels - 1);
+    EXPECT_EQ(usage["YogaNode"].count, nodes - 1);
+  } else {
+    EXPECT_EQ(usage[nu::Label::kClassName].count, labels);
+    EXPECT_EQ(usage["YogaNode"].count, nodes);
+  }
+}
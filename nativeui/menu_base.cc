@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include "base/logging.h"
 #include "nativeui/menu_item.h"
 
 namespace nu {
@@ -41,6 +42,51 @@ void MenuBase::Remove(MenuItem* item) {
   items_.erase(i);
 }
 
+void MenuBase::SetItems(const std::vector<MenuItem*>& items) {
+  // Remove the items that no longer exist.
+  for (int i = ItemCount() - 1; i >= 0; --i) {
+    MenuItem* item = ItemAt(i);
+    if (std::find(items.begin(), items.end(), item) == items.end())
+      Remove(item);
+  }
+
+  // Walk through the new list and only touch the positions that differ.
+  int index = 0;
+  for (MenuItem* item : items) {
+    if (!item)
+      continue;
+    if (item->GetMenu() == this) {
+      const auto i(std::find(items_.begin(), items_.end(), item));
+      int current = static_cast<int>(i - items_.begin());
+      if (current < index)  // duplicate item in the list
+        continue;
+      if (current != index)
+        MoveItem(item, index);
+    } else if (!item->GetMenu()) {
+      items_.insert(items_.begin() + index, item);
+      item->set_menu(this);
+      PlatformInsert(item, index);
+      item->SetAcceleratorManager(accel_manager_);
+    } else {
+      // The item belongs to another menu.
+      continue;
+    }
+    ++index;
+  }
+}
+
+void MenuBase::MoveItem(MenuItem* item, int index) {
+  const auto i(std::find(items_.begin(), items_.end(), item));
+  DCHECK(i != items_.end());
+  // Keep the item alive and registered in AcceleratorManager, only the native
+  // item is moved.
+  scoped_refptr<MenuItem> holder(item);
+  PlatformRemove(item);
+  items_.erase(i);
+  items_.insert(items_.begin() + index, holder);
+  PlatformInsert(item, index);
+}
+
 void MenuBase::SetAcceleratorManager(AcceleratorManager* accel_manager) {
   accel_manager_ = accel_manager;
   for (int i = 0; i < ItemCount(); ++i)
@@ -9,6 +9,7 @@
 
 #include "base/memory/ref_counted.h"
 #include "nativeui/nativeui_export.h"
+#include "nativeui/signal.h"
 #include "nativeui/types.h"
 
 namespace nu {
@@ -28,6 +29,12 @@ class NATIVEUI_EXPORT MenuBase : public base::RefCounted<MenuBase> {
   void Insert(MenuItem* item, int index);
   void Remove(MenuItem* item);
 
+  // Replace the items of menu with |items|. Items that are already in the menu
+  // are reused with their accelerators, and only the positions that have
+  // changed are updated in the native menu. Like Insert, items that belong to
+  // another menu are ignored.
+  void SetItems(const std::vector<MenuItem*>& items);
+
   int ItemCount() const { return static_cast<int>(items_.size()); }
   MenuItem* ItemAt(int index) const {
     if (index < 0 || index >= ItemCount())
@@ -38,6 +45,9 @@ class NATIVEUI_EXPORT MenuBase : public base::RefCounted<MenuBase> {
   // Return the native Menu object.
   NativeMenu GetNative() const { return menu_; }
 
+  // Events.
+  Signal<void(MenuBase*)> on_will_open;
+
   // Internal: Relationships with submenu items.
   void SetParent(MenuItem* item) { parent_ = item; }
   MenuItem* GetParent() const { return parent_; }
@@ -57,6 +67,9 @@ class NATIVEUI_EXPORT MenuBase : public base::RefCounted<MenuBase> {
   void PlatformInsert(MenuItem* item, int index);
   void PlatformRemove(MenuItem* item);
 
+  // Move an existing |item| to |index| without changing its ownership.
+  void MoveItem(MenuItem* item, int index);
+
   // Weak ref to the AcceleratorManager.
   AcceleratorManager* accel_manager_ = nullptr;
 
@@ -25,3 +25,40 @@ TEST_F(MenuTest, ItemCount) {
   menu_->Remove(menu_->ItemAt(0));
   EXPECT_EQ(menu_->ItemCount(), 0);
 }
+
+TEST_F(MenuTest, SetItems) {
+  scoped_refptr<nu::MenuItem> item1 =
+      new nu::MenuItem(nu::MenuItem::Type::Label);
+  scoped_refptr<nu::MenuItem> item2 =
+      new nu::MenuItem(nu::MenuItem::Type::Label);
+  scoped_refptr<nu::MenuItem> item3 =
+      new nu::MenuItem(nu::MenuItem::Type::Label);
+  menu_->SetItems({item1.get(), item2.get()});
+  EXPECT_EQ(menu_->ItemCount(), 2);
+  EXPECT_EQ(menu_->ItemAt(0), item1.get());
+  EXPECT_EQ(menu_->ItemAt(1), item2.get());
+  menu_->SetItems({item3.get(), item2.get(), item1.get()});
+  EXPECT_EQ(menu_->ItemCount(), 3);
+  EXPECT_EQ(menu_->ItemAt(0), item3.get());
+  EXPECT_EQ(menu_->ItemAt(1), item2.get());
+  EXPECT_EQ(menu_->ItemAt(2), item1.get());
+  menu_->SetItems({item2.get()});
+  EXPECT_EQ(menu_->ItemCount(), 1);
+  EXPECT_EQ(menu_->ItemAt(0), item2.get());
+  EXPECT_EQ(item1->GetMenu(), nullptr);
+  EXPECT_EQ(item2->GetMenu(), menu_.get());
+}
+
+TEST_F(MenuTest, SetItemsOfOtherMenu) {
+  scoped_refptr<nu::Menu> other = new nu::Menu;
+  scoped_refptr<nu::MenuItem> item1 =
+      new nu::MenuItem(nu::MenuItem::Type::Label);
+  scoped_refptr<nu::MenuItem> item2 =
+      new nu::MenuItem(nu::MenuItem::Type::Label);
+  other->Append(item1.get());
+  menu_->SetItems({item1.get(), item2.get()});
+  EXPECT_EQ(menu_->ItemCount(), 1);
+  EXPECT_EQ(menu_->ItemAt(0), item2.get());
+  EXPECT_EQ(other->ItemCount(), 1);
+  EXPECT_EQ(item1->GetMenu(), other.get());
+}
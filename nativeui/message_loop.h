@@ -31,6 +31,9 @@ class NATIVEUI_EXPORT MessageLoop {
   using TimerId = unsigned int;
 #endif
   static TimerId SetTimeout(int ms, const Task& task);
+  // Run |task| when there are no pending events, it is also cancelled by
+  // ClearTimeout.
+  static TimerId SetIdleTimeout(const Task& task);
   static void ClearTimeout(TimerId id);
 
  private:
@@ -15,21 +15,26 @@
 #include "nativeui/events/keyboard_codes.h"
 #include "nativeui/file_open_dialog.h"
 #include "nativeui/file_save_dialog.h"
+#include "nativeui/gfx/attributed_text.h"
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/insets.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/image_atlas.h"
+#include "nativeui/gfx/image_set.h"
 #include "nativeui/gfx/painter.h"
 #include "nativeui/gif_player.h"
 #include "nativeui/group.h"
 #include "nativeui/label.h"
 #include "nativeui/lifetime.h"
+#include "nativeui/memory_dump.h"
 #include "nativeui/menu.h"
 #include "nativeui/menu_bar.h"
 #include "nativeui/menu_item.h"
 #include "nativeui/message_loop.h"
 #include "nativeui/progress_bar.h"
 #include "nativeui/protocol_asar_job.h"
+#include "nativeui/scene_item.h"
 #include "nativeui/scroll.h"
 #include "nativeui/slider.h"
 #include "nativeui/state.h"
@@ -40,6 +45,11 @@
 #include "nativeui/tray.h"
 #include "nativeui/window.h"
 
+#if defined(OS_LINUX)
+#include "nativeui/tree.h"
+#include "nativeui/tree_model.h"
+#endif
+
 #if defined(OS_MACOSX)
 #include "nativeui/toolbar.h"
 #include "nativeui/vibrant.h"
@@ -0,0 +1,58 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/scene_item.h"
+
+#include "nativeui/container.h"
+
+namespace nu {
+
+SceneItem::SceneItem() {}
+
+SceneItem::~SceneItem() {}
+
+void SceneItem::SetBounds(const RectF& bounds) {
+  if (bounds == bounds_)
+    return;
+  // Repaint the old and new areas separately, which results in smaller
+  // damage than their union when the item moves far.
+  SchedulePaint();
+  RectF old_bounds = bounds_;
+  bounds_ = bounds;
+  if (container_)
+    container_->OnItemBoundsChanged(this, old_bounds);
+  SchedulePaint();
+}
+
+void SceneItem::SetZIndex(int z_index) {
+  if (z_index == z_index_)
+    return;
+  z_index_ = z_index;
+  SchedulePaint();
+}
+
+void SceneItem::SetVisible(bool visible) {
+  if (visible == visible_)
+    return;
+  // Hidden items are still indexed, the hit testing filters them out.
+  visible_ = visible;
+  if (container_)
+    container_->SchedulePaintRect(bounds_);
+}
+
+void SceneItem::SchedulePaint() {
+  SchedulePaintRect(RectF(bounds_.size()));
+}
+
+void SceneItem::SchedulePaintRect(const RectF& rect) {
+  if (!container_ || !visible_)
+    return;
+  RectF dirty(rect);
+  dirty.Offset(bounds_.OffsetFromOrigin());
+  dirty.Intersect(bounds_);
+  if (!dirty.IsEmpty())
+    container_->SchedulePaintRect(dirty);
+}
+
+}  // namespace nu
@@ -0,0 +1,72 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_SCENE_ITEM_H_
+#define NATIVEUI_SCENE_ITEM_H_
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/nativeui_export.h"
+#include "nativeui/signal.h"
+
+namespace nu {
+
+class Container;
+class Painter;
+struct MouseEvent;
+
+// A lightweight drawable item owned by a Container, which has no native
+// widget and is drawn and hit-tested by the container.
+class NATIVEUI_EXPORT SceneItem : public base::RefCounted<SceneItem> {
+ public:
+  SceneItem();
+
+  // Bounds in the coordinates of container.
+  void SetBounds(const RectF& bounds);
+  RectF GetBounds() const { return bounds_; }
+
+  // Items with larger z-index are drawn above, items with the same z-index
+  // are drawn in the order they were added.
+  void SetZIndex(int z_index);
+  int GetZIndex() const { return z_index_; }
+
+  void SetVisible(bool visible);
+  bool IsVisible() const { return visible_; }
+
+  // Mark the item, or |rect| in the item's coordinates, as needing repaint.
+  void SchedulePaint();
+  void SchedulePaintRect(const RectF& rect);
+
+  // The container that owns the item.
+  Container* GetContainer() const { return container_; }
+
+  // Events, the coordinates are relative to the item.
+  Signal<void(SceneItem*, Painter*, const RectF&)> on_draw;
+  Signal<bool(SceneItem*, const MouseEvent&)> on_mouse_down;
+  Signal<bool(SceneItem*, const MouseEvent&)> on_mouse_up;
+  Signal<void(SceneItem*, const MouseEvent&)> on_mouse_move;
+  Signal<void(SceneItem*, const MouseEvent&)> on_mouse_enter;
+  Signal<void(SceneItem*, const MouseEvent&)> on_mouse_leave;
+
+ protected:
+  virtual ~SceneItem();
+
+ private:
+  friend class base::RefCounted<SceneItem>;
+  friend class Container;
+
+  Container* container_ = nullptr;
+  RectF bounds_;
+  int z_index_ = 0;
+  bool visible_ = true;
+  // Position in container, used for ordering items with the same z-index.
+  size_t order_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SceneItem);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_SCENE_ITEM_H_
@@ -0,0 +1,80 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class SceneItemTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    container_ = new nu::Container;
+  }
+
+  nu::SceneItem* AddItem(const nu::RectF& bounds) {
+    nu::SceneItem* item = new nu::SceneItem;
+    item->SetBounds(bounds);
+    container_->AddItem(item);
+    return item;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Container> container_;
+};
+
+TEST_F(SceneItemTest, AddRemove) {
+  scoped_refptr<nu::SceneItem> item = AddItem(nu::RectF(0, 0, 10, 10));
+  EXPECT_EQ(item->GetContainer(), container_.get());
+  EXPECT_EQ(container_->ItemCount(), 1);
+  EXPECT_EQ(container_->ItemAt(0), item.get());
+  container_->RemoveItem(item.get());
+  EXPECT_EQ(item->GetContainer(), nullptr);
+  EXPECT_EQ(container_->ItemCount(), 0);
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(5, 5)), nullptr);
+}
+
+TEST_F(SceneItemTest, GetItemAt) {
+  nu::SceneItem* bottom = AddItem(nu::RectF(0, 0, 100, 100));
+  nu::SceneItem* top = AddItem(nu::RectF(50, 50, 100, 100));
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(10, 10)), bottom);
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(60, 60)), top);
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(200, 200)), nullptr);
+  bottom->SetZIndex(1);
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(60, 60)), bottom);
+  bottom->SetVisible(false);
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(60, 60)), top);
+  // Moving items updates the index.
+  top->SetBounds(nu::RectF(200, 200, 10, 10));
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(60, 60)), nullptr);
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(205, 205)), top);
+}
+
+TEST_F(SceneItemTest, DragItem) {
+  std::vector<nu::SceneItem*> items;
+  for (int i = 0; i < 100; ++i)
+    items.push_back(AddItem(nu::RectF(i * 10, 0, 10, 10)));
+  // Build the index.
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(5, 5)), items[0]);
+  // Moving an item repeatedly keeps the index in sync.
+  for (int y = 20; y < 200; y += 20) {
+    items[0]->SetBounds(nu::RectF(0, y, 10, 10));
+    EXPECT_EQ(container_->GetItemAt(nu::PointF(5, y + 5)), items[0]);
+    EXPECT_EQ(container_->GetItemAt(nu::PointF(5, y - 15)), nullptr);
+  }
+  // Items added after the index is built are found too.
+  nu::SceneItem* added = AddItem(nu::RectF(500, 500, 10, 10));
+  EXPECT_EQ(container_->GetItemAt(nu::PointF(505, 505)), added);
+}
+
+TEST_F(SceneItemTest, GetItemsInRect) {
+  nu::SceneItem* a = AddItem(nu::RectF(0, 0, 10, 10));
+  nu::SceneItem* b = AddItem(nu::RectF(5, 5, 10, 10));
+  nu::SceneItem* c = AddItem(nu::RectF(100, 100, 10, 10));
+  a->SetZIndex(1);
+  std::vector<nu::SceneItem*> items =
+      container_->GetItemsInRect(nu::RectF(0, 0, 20, 20));
+  EXPECT_EQ(items, std::vector<nu::SceneItem*>({b, a}));
+  items = container_->GetItemsInRect(nu::RectF(0, 0, 200, 200));
+  EXPECT_EQ(items, std::vector<nu::SceneItem*>({b, c, a}));
+}
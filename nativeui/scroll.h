@@ -11,6 +11,8 @@
 
 namespace nu {
 
+class Painter;
+
 class NATIVEUI_EXPORT Scroll : public View {
  public:
   Scroll();
@@ -37,6 +39,28 @@ class NATIVEUI_EXPORT Scroll : public View {
   void SetScrollbarPolicy(Policy h_policy, Policy v_policy);
   std::tuple<Policy, Policy> GetScrollbarPolicy() const;
 
+#if defined(OS_LINUX)
+  // In virtual content mode the content view is not shown, the scroll only
+  // keeps the scroll position and the logical content size, and the visible
+  // area is drawn by on_draw_content.
+  void SetVirtualContentMode(bool enabled);
+  bool IsVirtualContentMode() const;
+
+  // Logical size of content in virtual content mode, which can be larger than
+  // the largest size of native widgets.
+  void SetVirtualContentSize(double width, double height);
+  std::tuple<double, double> GetVirtualContentSize() const;
+
+  void SetScrollPosition(double x, double y);
+  std::tuple<double, double> GetScrollPosition() const;
+
+  // Events.
+  // The painter's origin is at the logical position (x, y), and the dirty
+  // rect is in the painter's coordinates.
+  Signal<void(Scroll*, Painter*, double, double, const RectF&)>
+      on_draw_content;
+#endif
+
   // View:
   const char* GetClassName() const override;
 
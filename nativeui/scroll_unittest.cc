@@ -0,0 +1,38 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ScrollTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ScrollTest, ContentView) {
+  scoped_refptr<nu::Scroll> scroll(new nu::Scroll);
+  nu::Container* view = new nu::Container;
+  scroll->SetContentView(view);
+  EXPECT_EQ(scroll->GetContentView(), view);
+  EXPECT_EQ(view->GetParent(), scroll.get());
+}
+
+#if defined(OS_LINUX)
+TEST_F(ScrollTest, VirtualContentMode) {
+  scoped_refptr<nu::Scroll> scroll(new nu::Scroll);
+  EXPECT_FALSE(scroll->IsVirtualContentMode());
+  scroll->SetVirtualContentMode(true);
+  EXPECT_TRUE(scroll->IsVirtualContentMode());
+  // Far larger than what a widget can allocate.
+  scroll->SetVirtualContentSize(1e12, 100);
+  EXPECT_EQ(scroll->GetVirtualContentSize(), std::make_tuple(1e12, 100.0));
+  // Content view can still be changed in virtual content mode.
+  nu::Container* view = new nu::Container;
+  scroll->SetContentView(view);
+  scroll->SetVirtualContentMode(false);
+  EXPECT_FALSE(scroll->IsVirtualContentMode());
+  EXPECT_EQ(scroll->GetContentView(), view);
+}
+#endif
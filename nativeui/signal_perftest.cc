@@ -0,0 +1,39 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+
+#include "nativeui/signal.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kEmitCount = 100000;
+
+}  // namespace
+
+TEST(SignalPerfTest, EmitVoid) {
+  for (int slots : {0, 1, 10}) {
+    nu::Signal<void(int)> signal;
+    int sum = 0;
+    for (int i = 0; i < slots; ++i)
+      signal.Connect([&sum](int value) { sum += value; });
+    nu::RunPerfTest("Signal.EmitVoid." + std::to_string(slots) + "Slots",
+                    kEmitCount, [&]() {
+      for (int i = 0; i < kEmitCount; ++i)
+        signal.Emit(i);
+    });
+  }
+}
+
+TEST(SignalPerfTest, EmitBool) {
+  nu::Signal<bool(int)> signal;
+  for (int i = 0; i < 10; ++i)
+    signal.Connect([](int value) { return false; });
+  nu::RunPerfTest("Signal.EmitBool.10Slots", kEmitCount, [&]() {
+    for (int i = 0; i < kEmitCount; ++i)
+      signal.Emit(i);
+  });
+}
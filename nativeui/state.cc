@@ -6,6 +6,7 @@
 
 #include "base/lazy_instance.h"
 #include "base/threading/thread_local.h"
+#include "nativeui/asar_archive.h"
 #include "nativeui/protocol_job.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
@@ -53,4 +54,19 @@ State* State::GetCurrent() {
   return lazy_tls_ptr.Pointer()->Get();
 }
 
+AsarArchive* State::GetAsarArchive(const base::FilePath& path) {
+  auto it = asar_archives_.find(path);
+  if (it != asar_archives_.end())
+    return it->second.get();
+  // The old asar format uses the ".asar" extension.
+  std::unique_ptr<AsarArchive> archive(new AsarArchive(
+      base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ),
+      !path.MatchesExtension(FILE_PATH_LITERAL(".asar"))));
+  if (!archive->IsValid())
+    return nullptr;
+  AsarArchive* result = archive.get();
+  asar_archives_[path] = std::move(archive);
+  return result;
+}
+
 }  // namespace nu
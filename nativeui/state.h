@@ -5,8 +5,10 @@
 #ifndef NATIVEUI_STATE_H_
 #define NATIVEUI_STATE_H_
 
+#include <map>
 #include <memory>
 
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "nativeui/app.h"
 
@@ -22,6 +24,8 @@ class ScopedCOMInitializer;
 
 namespace nu {
 
+class AsarArchive;
+
 #if defined(OS_WIN)
 class ClassRegistrar;
 class GdiplusHolder;
@@ -51,6 +55,12 @@ class NATIVEUI_EXPORT State {
   UINT GetNextCommandID();
 #endif
 
+  // Internal: Return the archive at |path|, which is opened on first call and
+  // shared by later calls. Return null if it is not a valid asar archive.
+  // The archives and their memory mappings are owned by State, and images
+  // created from them may point into the mappings until State is destroyed.
+  AsarArchive* GetAsarArchive(const base::FilePath& path);
+
   // Internal: Return the default yoga config.
   YGConfigRef yoga_config() const { return yoga_config_; }
 
@@ -76,6 +86,9 @@ class NATIVEUI_EXPORT State {
 
   YGConfigRef yoga_config_;
 
+  // Opened asar archives.
+  std::map<base::FilePath, std::unique_ptr<AsarArchive>> asar_archives_;
+
   DISALLOW_COPY_AND_ASSIGN(State);
 };
 
@@ -4,6 +4,10 @@
 
 #include "nativeui/tab.h"
 
+#include <algorithm>
+
+#include "nativeui/container.h"
+
 namespace nu {
 
 // static
@@ -15,6 +19,10 @@ Tab::Tab() {
 }
 
 Tab::~Tab() {
+  if (prefetch_timer_)
+    MessageLoop::ClearTimeout(prefetch_timer_);
+  if (unload_timer_)
+    MessageLoop::ClearTimeout(unload_timer_);
 }
 
 void Tab::AddPage(const std::string& title, View* view) {
@@ -32,7 +40,149 @@ void Tab::RemovePage(View* view) {
     return;
   PlatformRemovePage(it - pages_.begin(), view);
   (*it)->SetParent(nullptr);
+  lazy_pages_.erase(view);
   pages_.erase(it);
+  // Removing the selected page may select another page, in which case the
+  // selected page has already been updated.
+  if (selected_page_ == view)
+    selected_page_ = nullptr;
+}
+
+void Tab::AddLazyPage(const std::string& title, const PageFactory& factory) {
+  scoped_refptr<Container> host(new Container);
+  lazy_pages_[host.get()].factory = factory;
+  AddPage(title, host.get());
+  // The first page is selected when added.
+  int index = PageCount() - 1;
+  if (GetSelectedPageIndex() == index)
+    LoadPageAt(index);
+  else
+    SchedulePrefetch();
+}
+
+void Tab::LoadPageAt(int index) {
+  // Keep the host alive in case the factory removes the page.
+  scoped_refptr<View> host = PageAt(index);
+  auto it = lazy_pages_.find(host.get());
+  if (it == lazy_pages_.end() || it->second.loaded || it->second.loading)
+    return;
+  it->second.loading = true;
+  it->second.attempted = true;
+  PageFactory factory = it->second.factory;
+  // The factory returns null when it fails, in which case it is called again
+  // when the page is selected next time.
+  scoped_refptr<View> content = factory();
+  it = lazy_pages_.find(host.get());
+  if (it == lazy_pages_.end())
+    return;
+  LazyPage& page = it->second;
+  page.loading = false;
+  if (!content)
+    return;
+  page.loaded = true;
+  if (host.get() != GetSelectedPage()) {
+    page.hidden_since = base::TimeTicks::Now();
+    ScheduleUnload();
+  }
+  content->SetStyleProperty("flex", 1);
+  static_cast<Container*>(host.get())->AddChildView(content.get());
+}
+
+bool Tab::IsPageLoadedAt(int index) const {
+  View* host = PageAt(index);
+  if (!host)
+    return false;
+  auto it = lazy_pages_.find(host);
+  return it == lazy_pages_.end() || it->second.loaded;
+}
+
+void Tab::SetPrefetchLazyPages(bool prefetch) {
+  prefetch_lazy_pages_ = prefetch;
+  if (prefetch) {
+    SchedulePrefetch();
+  } else if (prefetch_timer_) {
+    MessageLoop::ClearTimeout(prefetch_timer_);
+    prefetch_timer_ = 0;
+  }
+}
+
+void Tab::SetUnloadHiddenPagesAfter(int seconds) {
+  unload_after_seconds_ = std::max(0, seconds);
+  if (unload_timer_) {
+    MessageLoop::ClearTimeout(unload_timer_);
+    unload_timer_ = 0;
+  }
+  ScheduleUnload();
+}
+
+void Tab::OnPageSelected(int index) {
+  View* page = PageAt(index);
+  if (page != selected_page_) {
+    auto it = lazy_pages_.find(selected_page_);
+    if (it != lazy_pages_.end()) {
+      it->second.hidden_since = base::TimeTicks::Now();
+      ScheduleUnload();
+    }
+  }
+  selected_page_ = page;
+  LoadPageAt(index);
+  auto it = lazy_pages_.find(page);
+  if (it != lazy_pages_.end())
+    it->second.hidden_since = base::TimeTicks();
+}
+
+void Tab::SchedulePrefetch() {
+  if (!prefetch_lazy_pages_ || prefetch_timer_)
+    return;
+  // Load pages when idle so prefetching does not block user interactions.
+  prefetch_timer_ = MessageLoop::SetIdleTimeout([this]() {
+    prefetch_timer_ = 0;
+    PrefetchNextPage();
+  });
+}
+
+void Tab::PrefetchNextPage() {
+  // Load one page at a time and continue in next task.
+  for (int i = 0; i < PageCount(); ++i) {
+    auto it = lazy_pages_.find(PageAt(i));
+    if (it != lazy_pages_.end() && !it->second.attempted) {
+      LoadPageAt(i);
+      SchedulePrefetch();
+      return;
+    }
+  }
+}
+
+void Tab::ScheduleUnload() {
+  if (unload_after_seconds_ <= 0 || unload_timer_)
+    return;
+  unload_timer_ = MessageLoop::SetTimeout(unload_after_seconds_ * 1000,
+                                          [this]() {
+    unload_timer_ = 0;
+    UnloadHiddenPages(base::TimeTicks::Now());
+  });
+}
+
+void Tab::UnloadHiddenPages(base::TimeTicks now) {
+  if (unload_after_seconds_ <= 0)
+    return;
+  base::TimeDelta timeout = base::TimeDelta::FromSeconds(unload_after_seconds_);
+  bool pending = false;
+  for (auto& it : lazy_pages_) {
+    LazyPage& page = it.second;
+    if (!page.loaded || page.hidden_since.is_null())
+      continue;
+    if (now - page.hidden_since < timeout) {
+      pending = true;
+      continue;
+    }
+    // Only the native resources are released, so the states of contents
+    // are kept.
+    PlatformUnloadPage(it.first);
+    page.hidden_since = base::TimeTicks();
+  }
+  if (pending)
+    ScheduleUnload();
 }
 
 const char* Tab::GetClassName() const {
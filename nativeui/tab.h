@@ -5,9 +5,13 @@
 #ifndef NATIVEUI_TAB_H_
 #define NATIVEUI_TAB_H_
 
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/time/time.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/view.h"
 
 namespace nu {
@@ -22,6 +26,25 @@ class NATIVEUI_EXPORT Tab : public View {
   void AddPage(const std::string& title, View* view);
   void RemovePage(View* view);
 
+  // Add a page whose content is created by |factory| when the page is first
+  // selected or prefetched. The page is a container hosting the content.
+  using PageFactory = std::function<View*()>;
+  void AddLazyPage(const std::string& title, const PageFactory& factory);
+
+  // Create the content of lazy page at |index| if it has not been created.
+  void LoadPageAt(int index);
+  bool IsPageLoadedAt(int index) const;
+
+  // Whether to create the contents of lazy pages one by one when idle.
+  void SetPrefetchLazyPages(bool prefetch);
+  bool IsPrefetchLazyPages() const { return prefetch_lazy_pages_; }
+
+  // Release the native resources of lazy pages that have been hidden for
+  // |seconds|, the contents are kept and realized again when selected.
+  // Passing 0 disables unloading.
+  void SetUnloadHiddenPagesAfter(int seconds);
+  int GetUnloadHiddenPagesAfter() const { return unload_after_seconds_; }
+
   int PageCount() const { return static_cast<int>(pages_.size()); }
   View* PageAt(int index) const {
     if (index < 0 || static_cast<size_t>(index) >= pages_.size())
@@ -37,6 +60,14 @@ class NATIVEUI_EXPORT Tab : public View {
   const char* GetClassName() const override;
   SizeF GetMinimumSize() const override;
 
+  // Internal: Called by platform implementations before emitting
+  // on_selected_page_change.
+  void OnPageSelected(int index);
+
+  // Internal: Unload the pages that have been hidden for long enough at |now|,
+  // called by the unload timer and tests.
+  void UnloadHiddenPages(base::TimeTicks now);
+
   // Events.
   Signal<void(Tab*)> on_selected_page_change;
 
@@ -44,11 +75,39 @@ class NATIVEUI_EXPORT Tab : public View {
   ~Tab() override;
 
  private:
+  struct LazyPage {
+    PageFactory factory;
+    bool loaded = false;
+    bool loading = false;
+    // Pages whose factories have been called are not prefetched again, even
+    // if the factories failed.
+    bool attempted = false;
+    // When the page was hidden, null if it is the selected page or has been
+    // unloaded.
+    base::TimeTicks hidden_since;
+  };
+
   NativeView PlatformCreate();
   void PlatformAddPage(const std::string& title, View* view);
   void PlatformRemovePage(int index, View* view);
+  void PlatformUnloadPage(View* view);
+
+  void SchedulePrefetch();
+  void PrefetchNextPage();
+  void ScheduleUnload();
 
   std::vector<scoped_refptr<View>> pages_;
+
+  // Lazy pages keyed by their hosting containers.
+  std::unordered_map<View*, LazyPage> lazy_pages_;
+  // The page that was selected in last OnPageSelected, which is tracked by
+  // page instead of index so removing pages does not invalidate it.
+  View* selected_page_ = nullptr;
+
+  bool prefetch_lazy_pages_ = false;
+  MessageLoop::TimerId prefetch_timer_ = 0;
+  int unload_after_seconds_ = 0;
+  MessageLoop::TimerId unload_timer_ = 0;
 };
 
 }  // namespace nu
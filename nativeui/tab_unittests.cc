@@ -62,3 +62,96 @@ TEST_F(TabTest, SelectPageShouldEmitEvent) {
   tab_->SelectPageAt(1);
   EXPECT_TRUE(emitted);
 }
+
+TEST_F(TabTest, LazyPage) {
+  int created = 0;
+  auto factory = [&created]() {
+    ++created;
+    return new nu::Label("page");
+  };
+  tab_->AddLazyPage("Tab 1", factory);
+  tab_->AddLazyPage("Tab 2", factory);
+  // The first page is selected and created immediately.
+  EXPECT_EQ(created, 1);
+  EXPECT_TRUE(tab_->IsPageLoadedAt(0));
+  EXPECT_FALSE(tab_->IsPageLoadedAt(1));
+  bool emitted = false;
+  tab_->on_selected_page_change.Connect([&emitted](nu::Tab*) {
+    emitted = true;
+  });
+  tab_->SelectPageAt(1);
+  EXPECT_TRUE(emitted);
+  EXPECT_EQ(created, 2);
+  EXPECT_TRUE(tab_->IsPageLoadedAt(1));
+  nu::Container* page = static_cast<nu::Container*>(tab_->PageAt(1));
+  ASSERT_EQ(page->ChildCount(), 1);
+  EXPECT_STREQ(page->ChildAt(0)->GetClassName(), nu::Label::kClassName);
+  // Selecting again does not create the page again.
+  tab_->SelectPageAt(0);
+  tab_->SelectPageAt(1);
+  EXPECT_EQ(created, 2);
+}
+
+TEST_F(TabTest, PrefetchLazyPages) {
+  tab_->AddPage("Tab 1", new nu::Container);
+  tab_->AddLazyPage("Tab 2", []() { return new nu::Container; });
+  tab_->AddLazyPage("Tab 3", []() {
+    nu::MessageLoop::Quit();
+    return new nu::Container;
+  });
+  tab_->SetPrefetchLazyPages(true);
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(tab_->IsPageLoadedAt(1));
+  EXPECT_TRUE(tab_->IsPageLoadedAt(2));
+}
+
+TEST_F(TabTest, UnloadAfterRemovingPage) {
+  scoped_refptr<nu::View> first = new nu::Container;
+  tab_->AddPage("Tab 1", first.get());
+  int created = 0;
+  auto factory = [&created]() {
+    ++created;
+    return new nu::Container;
+  };
+  tab_->AddLazyPage("Tab 2", factory);
+  tab_->AddLazyPage("Tab 3", factory);
+  tab_->SetUnloadHiddenPagesAfter(1);
+  tab_->SelectPageAt(2);
+  EXPECT_TRUE(tab_->IsPageLoadedAt(2));
+  // The selected page moves to index 1, selecting another page should still
+  // hide it.
+  tab_->RemovePage(first.get());
+  tab_->SelectPageAt(0);
+  tab_->UnloadHiddenPages(base::TimeTicks::Now() +
+                          base::TimeDelta::FromSeconds(2));
+  // Unloading keeps the content.
+  EXPECT_TRUE(tab_->IsPageLoadedAt(0));
+  EXPECT_TRUE(tab_->IsPageLoadedAt(1));
+  nu::Container* page = static_cast<nu::Container*>(tab_->PageAt(1));
+  EXPECT_EQ(page->ChildCount(), 1);
+  tab_->SelectPageAt(1);
+  EXPECT_EQ(created, 2);
+}
+
+TEST_F(TabTest, FailedLazyPage) {
+  bool fail = true;
+  tab_->AddPage("Tab 1", new nu::Container);
+  tab_->AddLazyPage("Tab 2", [&fail]() -> nu::View* {
+    return fail ? nullptr : new nu::Container;
+  });
+  tab_->SelectPageAt(1);
+  EXPECT_FALSE(tab_->IsPageLoadedAt(1));
+  // Tried again when selected next time.
+  fail = false;
+  tab_->SelectPageAt(0);
+  tab_->SelectPageAt(1);
+  EXPECT_TRUE(tab_->IsPageLoadedAt(1));
+}
+
+TEST_F(TabTest, InvalidPageIsNotLoaded) {
+  EXPECT_FALSE(tab_->IsPageLoadedAt(0));
+  tab_->AddPage("Tab 1", new nu::Container);
+  EXPECT_TRUE(tab_->IsPageLoadedAt(0));
+  EXPECT_FALSE(tab_->IsPageLoadedAt(-1));
+  EXPECT_FALSE(tab_->IsPageLoadedAt(1));
+}
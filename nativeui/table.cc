@@ -4,6 +4,7 @@
 
 #include "nativeui/table.h"
 
+#include "base/values.h"
 #include "nativeui/table_model.h"
 
 namespace nu {
@@ -17,6 +18,19 @@ Table::ColumnOptions::ColumnOptions(const ColumnOptions& other) = default;
 
 Table::ColumnOptions::~ColumnOptions() = default;
 
+bool Table::ColumnOptions::HasDrawHandler() const {
+  return on_draw_cell || on_draw;
+}
+
+void Table::ColumnOptions::Draw(Painter* painter,
+                                const RectF& rect,
+                                const TableCell& cell) const {
+  if (on_draw_cell)
+    on_draw_cell(painter, rect, cell);
+  else if (on_draw)
+    on_draw(painter, rect, cell.ToValue());
+}
+
 Table::Table() {
   TakeOverView(PlatformCreate());
 }
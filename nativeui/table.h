@@ -6,7 +6,9 @@
 #define NATIVEUI_TABLE_H_
 
 #include <string>
+#include <vector>
 
+#include "nativeui/util/range_set.h"
 #include "nativeui/view.h"
 
 namespace base {
@@ -16,6 +18,7 @@ class Value;
 namespace nu {
 
 class Painter;
+class TableCell;
 class TableModel;
 
 class NATIVEUI_EXPORT Table : public View {
@@ -34,6 +37,13 @@ class NATIVEUI_EXPORT Table : public View {
     ColumnType type = ColumnType::Text;
     // Method used for drawing the column when type is Custom.
     std::function<void(Painter*, const RectF&, const base::Value&)> on_draw;
+    // Receives a view of the cell instead, which can also be an image. It is
+    // used instead of on_draw when set.
+    std::function<void(Painter*, const RectF&, const TableCell&)> on_draw_cell;
+
+    // Internal: Call the drawing method that is set.
+    bool HasDrawHandler() const;
+    void Draw(Painter* painter, const RectF& rect, const TableCell& cell) const;
     // Which column of model, -1 means current last column.
     int column = -1;
     // Initial width.
@@ -58,9 +68,30 @@ class NATIVEUI_EXPORT Table : public View {
   void SelectRow(int row);
   int GetSelectedRow() const;
 
+#if defined(OS_LINUX)
+  // The selected rows are stored as ranges, so selecting all rows of a huge
+  // table is cheap. The ranges are half-open, i.e. [start, end).
+  void SetMultipleSelection(bool multiple);
+  bool IsMultipleSelection() const;
+  void SelectRange(uint32_t start, uint32_t end);
+  void DeselectRange(uint32_t start, uint32_t end);
+  void ToggleRange(uint32_t start, uint32_t end);
+  void SelectAll();
+  void DeselectAll();
+  void InvertSelection();
+  bool IsRowSelected(uint32_t row) const;
+  std::vector<Range> GetSelectedRanges() const;
+#endif
+
   // View:
   const char* GetClassName() const override;
 
+#if defined(OS_LINUX)
+  // Events.
+  Signal<void(Table*, const std::vector<Range>& added,
+              const std::vector<Range>& removed)> on_selection_change;
+#endif
+
  protected:
   ~Table() override;
 
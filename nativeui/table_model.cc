@@ -4,12 +4,120 @@
 
 #include "nativeui/table_model.h"
 
+#include <limits.h>
+#include <string.h>
+
 #include <utility>
 
+#include "base/logging.h"
 #include "nativeui/table.h"
 
 namespace nu {
 
+namespace {
+
+// Estimate the memory used by a cell value.
+size_t EstimateValueMemoryUsage(const base::Value& value) {
+  size_t size = sizeof(base::Value);
+  if (value.is_string())
+    size += value.GetString().capacity();
+  return size;
+}
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// TableCell implementation.
+
+TableCell::TableCell(const char* value) : type_(Type::String) {
+  string_.data = value;
+  string_.size = strlen(value);
+  string_.null_terminated = true;
+}
+
+TableCell::TableCell(const std::string& value) : type_(Type::String) {
+  string_.data = value.c_str();
+  string_.size = value.size();
+  string_.null_terminated = true;
+}
+
+TableCell::TableCell(base::StringPiece value) : type_(Type::String) {
+  string_.data = value.data();
+  string_.size = value.size();
+  string_.null_terminated = false;
+}
+
+// static
+TableCell TableCell::FromValue(const base::Value* value) {
+  if (!value)
+    return TableCell();
+  switch (value->type()) {
+    case base::Value::Type::BOOLEAN:
+      return TableCell(value->GetBool());
+    case base::Value::Type::INTEGER:
+      return TableCell(value->GetInt());
+    case base::Value::Type::DOUBLE:
+      return TableCell(value->GetDouble());
+    case base::Value::Type::STRING:
+      return TableCell(value->GetString());
+    default:
+      return TableCell();
+  }
+}
+
+base::Value TableCell::ToValue() const {
+  switch (type_) {
+    case Type::Integer:
+      // base::Value does not have 64bit integers.
+      if (integer_ >= INT_MIN && integer_ <= INT_MAX)
+        return base::Value(static_cast<int>(integer_));
+      return base::Value(static_cast<double>(integer_));
+    case Type::Double:
+      return base::Value(double_);
+    case Type::Boolean:
+      return base::Value(boolean_);
+    case Type::String:
+      return base::Value(GetString().as_string());
+    default:
+      return base::Value();
+  }
+}
+
+int64_t TableCell::GetInteger() const {
+  DCHECK(is_integer());
+  return integer_;
+}
+
+double TableCell::GetDouble() const {
+  DCHECK(is_double() || is_integer());
+  return is_integer() ? static_cast<double>(integer_) : double_;
+}
+
+bool TableCell::GetBool() const {
+  DCHECK(is_bool());
+  return boolean_;
+}
+
+base::StringPiece TableCell::GetString() const {
+  DCHECK(is_string());
+  return base::StringPiece(string_.data, string_.size);
+}
+
+const char* TableCell::GetCString() const {
+  DCHECK(is_string());
+  return string_.null_terminated ? string_.data : nullptr;
+}
+
+Image* TableCell::GetImage() const {
+  DCHECK(is_image());
+  return image_;
+}
+
+AtlasImage* TableCell::GetAtlasImage() const {
+  DCHECK(is_atlas_image());
+  return atlas_image_;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // TableModel implementation.
 
@@ -17,6 +125,11 @@ TableModel::TableModel() {}
 
 TableModel::~TableModel() {}
 
+const base::Value* TableModel::GetValue(uint32_t column, uint32_t row) const {
+  value_ = GetCell(column, row).ToValue();
+  return &value_;
+}
+
 void TableModel::NotifyRowInsertion(uint32_t row) {
   for (Table* table : tables_)
     table->NotifyRowInsertion(row);
@@ -32,6 +145,14 @@ void TableModel::NotifyValueChange(uint32_t column, uint32_t row) {
     table->NotifyValueChange(column, row);
 }
 
+const char* TableModel::GetMemoryClassName() const {
+  return "TableModel";
+}
+
+size_t TableModel::EstimateMemoryUsage() const {
+  return sizeof(TableModel) + tables_.size() * sizeof(Table*);
+}
+
 void TableModel::Subscribe(Table* view) {
   tables_.push_back(view);
 }
@@ -54,6 +175,11 @@ uint32_t AbstractTableModel::GetRowCount() const {
   return get_row_count(const_cast<AbstractTableModel*>(this));
 }
 
+TableCell AbstractTableModel::GetCell(uint32_t column, uint32_t row) const {
+  // The cell refers to the copy kept by GetValue.
+  return TableCell::FromValue(GetValue(column, row));
+}
+
 const base::Value* AbstractTableModel::GetValue(
     uint32_t column, uint32_t row) const {
   if (!get_value)
@@ -81,6 +207,10 @@ void AbstractTableModel::SetValue(uint32_t column, uint32_t row,
             column, row, std::move(value));
 }
 
+const char* AbstractTableModel::GetMemoryClassName() const {
+  return "AbstractTableModel";
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // SimpleTableModel implementation.
 
@@ -106,6 +236,10 @@ uint32_t SimpleTableModel::GetRowCount() const {
   return static_cast<uint32_t>(rows_.size());
 }
 
+TableCell SimpleTableModel::GetCell(uint32_t column, uint32_t row) const {
+  return TableCell::FromValue(GetValue(column, row));
+}
+
 const base::Value* SimpleTableModel::GetValue(
     uint32_t column, uint32_t row) const {
   if (columns_ >= 0 && column < columns_ && row >= 0 && row < rows_.size())
@@ -121,4 +255,18 @@ void SimpleTableModel::SetValue(uint32_t column, uint32_t row,
   }
 }
 
+const char* SimpleTableModel::GetMemoryClassName() const {
+  return "SimpleTableModel";
+}
+
+size_t SimpleTableModel::EstimateMemoryUsage() const {
+  size_t size = TableModel::EstimateMemoryUsage() +
+                rows_.capacity() * sizeof(Row);
+  for (const Row& row : rows_) {
+    for (const base::Value& value : row)
+      size += EstimateValueMemoryUsage(value);
+  }
+  return size;
+}
+
 }  // namespace nu
@@ -7,26 +7,106 @@
 
 #include <functional>
 #include <list>
+#include <string>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
+#include "nativeui/memory_dump.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
 
+class AtlasImage;
+class Image;
 class Table;
 
+// A lightweight view of the data in a cell.
+//
+// It never owns the data: strings and images point into storage owned by the
+// model, and are only valid until the model is changed.
+class NATIVEUI_EXPORT TableCell {
+ public:
+  enum class Type {
+    None,
+    Integer,
+    Double,
+    Boolean,
+    String,
+    Image,
+    AtlasImage,
+  };
+
+  TableCell() : type_(Type::None) {}
+  explicit TableCell(int value) : TableCell(static_cast<int64_t>(value)) {}
+  explicit TableCell(int64_t value) : type_(Type::Integer), integer_(value) {}
+  explicit TableCell(double value) : type_(Type::Double), double_(value) {}
+  explicit TableCell(bool value) : type_(Type::Boolean), boolean_(value) {}
+  explicit TableCell(const char* value);
+  explicit TableCell(const std::string& value);
+  explicit TableCell(base::StringPiece value);
+  explicit TableCell(Image* value) : type_(Type::Image), image_(value) {}
+  explicit TableCell(AtlasImage* value)
+      : type_(Type::AtlasImage), atlas_image_(value) {}
+
+  // Create a view of |value|, which must outlive the returned cell.
+  static TableCell FromValue(const base::Value* value);
+
+  // Create a base::Value from the cell, images are converted to none.
+  base::Value ToValue() const;
+
+  Type type() const { return type_; }
+  bool is_none() const { return type_ == Type::None; }
+  bool is_integer() const { return type_ == Type::Integer; }
+  bool is_double() const { return type_ == Type::Double; }
+  bool is_bool() const { return type_ == Type::Boolean; }
+  bool is_string() const { return type_ == Type::String; }
+  bool is_image() const { return type_ == Type::Image; }
+  bool is_atlas_image() const { return type_ == Type::AtlasImage; }
+
+  int64_t GetInteger() const;
+  // Integers are also converted to double.
+  double GetDouble() const;
+  bool GetBool() const;
+  base::StringPiece GetString() const;
+  // Return the string if it is null-terminated, otherwise nullptr.
+  const char* GetCString() const;
+  Image* GetImage() const;
+  AtlasImage* GetAtlasImage() const;
+
+ private:
+  Type type_;
+  union {
+    int64_t integer_;
+    double double_;
+    bool boolean_;
+    struct {
+      const char* data;
+      size_t size;
+      bool null_terminated;
+    } string_;
+    Image* image_;
+    AtlasImage* atlas_image_;
+  };
+};
+
 // Users should sublcass TableModel to provide their own implementation.
-class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
+class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel>,
+                                    public MemoryTracked {
  public:
   // Return how many rows are in the model.
   virtual uint32_t GetRowCount() const = 0;
 
+  // Return a view of the data in the model without copying it.
+  virtual TableCell GetCell(uint32_t column, uint32_t row) const = 0;
+
   // Return the reference to the data in the model.
   // Caller should not store the return value, as it is a temporary reference
   // that may immediately get destroyed after exiting current stack.
-  virtual const base::Value* GetValue(uint32_t column, uint32_t row) const = 0;
+  // The default implementation converts the result of GetCell, and is kept
+  // for compatibility.
+  virtual const base::Value* GetValue(uint32_t column, uint32_t row) const;
 
   // Change the value.
   virtual void SetValue(uint32_t column, uint32_t row, base::Value value) = 0;
@@ -36,6 +116,10 @@ class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
   void NotifyRowDeletion(uint32_t row);
   void NotifyValueChange(uint32_t column, uint32_t row);
 
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+  size_t EstimateMemoryUsage() const override;
+
  protected:
   TableModel();
   virtual ~TableModel();
@@ -49,6 +133,9 @@ class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
   void Unsubscribe(Table* view);
 
   std::list<Table*> tables_;
+
+  // Storage of the value returned by the default GetValue.
+  mutable base::Value value_;
 };
 
 // Used by language bindings.
@@ -59,9 +146,13 @@ class NATIVEUI_EXPORT AbstractTableModel : public TableModel {
 
   // TableModel:
   uint32_t GetRowCount() const override;
+  TableCell GetCell(uint32_t column, uint32_t row) const override;
   const base::Value* GetValue(uint32_t column, uint32_t row) const override;
   void SetValue(uint32_t column, uint32_t row, base::Value value) override;
 
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+
   // Delegate methods.
   std::function<uint32_t(AbstractTableModel*)> get_row_count;
   std::function<base::Value(AbstractTableModel*, uint32_t, uint32_t)> get_value;
@@ -88,9 +179,14 @@ class NATIVEUI_EXPORT SimpleTableModel : public TableModel {
 
   // TableModel:
   uint32_t GetRowCount() const override;
+  TableCell GetCell(uint32_t column, uint32_t row) const override;
   const base::Value* GetValue(uint32_t column, uint32_t row) const override;
   void SetValue(uint32_t column, uint32_t row, base::Value value) override;
 
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+  size_t EstimateMemoryUsage() const override;
+
  protected:
   ~SimpleTableModel() override;
 
@@ -0,0 +1,102 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <algorithm>
+#include <string>
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kRowCount = 10000;
+const int kColumnCount = 4;
+
+nu::SimpleTableModel::Row CreateRow(int index) {
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(index);
+  row.emplace_back("row " + std::to_string(index));
+  row.emplace_back(index % 2 == 0);
+  row.emplace_back(index * 0.5);
+  return row;
+}
+
+}  // namespace
+
+class TableModelPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    table_ = new nu::Table;
+    for (int i = 0; i < kColumnCount; ++i)
+      table_->AddColumn("column");
+    window_->SetContentView(table_.get());
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Table> table_;
+};
+
+TEST_F(TableModelPerfTest, Insert) {
+  scoped_refptr<nu::SimpleTableModel> model;
+  nu::RunPerfTest("SimpleTableModel.Insert.10000", kRowCount, [&]() {
+    for (int i = 0; i < kRowCount; ++i)
+      model->AddRow(CreateRow(i));
+  }, [&]() {
+    // The table observes the model so row insertions are sent to the view.
+    model = new nu::SimpleTableModel(kColumnCount);
+    table_->SetModel(model.get());
+  });
+}
+
+// Reads every cell page by page, which is what the view does when scrolling
+// through the whole table.
+TEST_F(TableModelPerfTest, Scroll) {
+  scoped_refptr<nu::SimpleTableModel> model(
+      new nu::SimpleTableModel(kColumnCount));
+  for (int i = 0; i < kRowCount; ++i)
+    model->AddRow(CreateRow(i));
+  table_->SetModel(model.get());
+  const uint32_t kPageSize = 30;
+  nu::RunPerfTest("SimpleTableModel.Scroll.10000", kRowCount, [&]() {
+    size_t bytes = 0;
+    for (uint32_t top = 0; top < model->GetRowCount(); top += kPageSize) {
+      uint32_t bottom = std::min(top + kPageSize, model->GetRowCount());
+      for (uint32_t row = top; row < bottom; ++row) {
+        for (uint32_t column = 0; column < kColumnCount; ++column) {
+          const base::Value* value = model->GetValue(column, row);
+          if (value && value->is_string())
+            bytes += value->GetString().size();
+        }
+      }
+    }
+    EXPECT_GT(bytes, 0u);
+  });
+}
+
+TEST_F(TableModelPerfTest, ScrollCells) {
+  scoped_refptr<nu::SimpleTableModel> model(
+      new nu::SimpleTableModel(kColumnCount));
+  for (int i = 0; i < kRowCount; ++i)
+    model->AddRow(CreateRow(i));
+  table_->SetModel(model.get());
+  const uint32_t kPageSize = 30;
+  nu::RunPerfTest("SimpleTableModel.ScrollCells.10000", kRowCount, [&]() {
+    size_t bytes = 0;
+    for (uint32_t top = 0; top < model->GetRowCount(); top += kPageSize) {
+      uint32_t bottom = std::min(top + kPageSize, model->GetRowCount());
+      for (uint32_t row = top; row < bottom; ++row) {
+        for (uint32_t column = 0; column < kColumnCount; ++column) {
+          nu::TableCell cell = model->GetCell(column, row);
+          if (cell.is_string())
+            bytes += cell.GetString().size();
+        }
+      }
+    }
+    EXPECT_GT(bytes, 0u);
+  });
+}
@@ -2,6 +2,10 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/strings/stringprintf.h"
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -36,9 +40,9 @@ class TestTableModel : public nu::TableModel {
     return 10000;
   }
 
-  const base::Value* GetValue(uint32_t column, uint32_t row) const override {
-    value_ = base::Value(base::StringPrintf("%d_%d", column, row));
-    return &value_;
+  nu::TableCell GetCell(uint32_t column, uint32_t row) const override {
+    text_ = base::StringPrintf("%d_%d", column, row);
+    return nu::TableCell(text_);
   }
 
   void SetValue(uint32_t column, uint32_t row, base::Value value) override {
@@ -47,7 +51,7 @@ class TestTableModel : public nu::TableModel {
  private:
   ~TestTableModel() override {}
 
-  mutable base::Value value_;
+  mutable std::string text_;
 };
 
 TEST_F(TableTest, SelectSingleRow) {
@@ -57,3 +61,121 @@ TEST_F(TableTest, SelectSingleRow) {
   table_->SelectRow(100001);
   EXPECT_EQ(table_->GetSelectedRow(), 9999);
 }
+
+TEST_F(TableTest, GetCell) {
+  scoped_refptr<nu::SimpleTableModel> model(new nu::SimpleTableModel(4));
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(1);
+  row.emplace_back(0.5);
+  row.emplace_back(true);
+  row.emplace_back("text");
+  model->AddRow(std::move(row));
+  EXPECT_EQ(model->GetCell(0, 0).GetInteger(), 1);
+  EXPECT_EQ(model->GetCell(1, 0).GetDouble(), 0.5);
+  EXPECT_TRUE(model->GetCell(2, 0).GetBool());
+  // The string refers to the storage of model.
+  nu::TableCell cell = model->GetCell(3, 0);
+  ASSERT_TRUE(cell.is_string());
+  EXPECT_EQ(cell.GetString().data(),
+            model->GetValue(3, 0)->GetString().data());
+  EXPECT_EQ(cell.GetCString(), model->GetValue(3, 0)->GetString().c_str());
+  EXPECT_TRUE(model->GetCell(4, 0).is_none());
+}
+
+TEST_F(TableTest, GetValueFromCell) {
+  scoped_refptr<nu::TableModel> model(new TestTableModel);
+  const base::Value* value = model->GetValue(1, 2);
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->GetString(), "1_2");
+  // Only strings known to be null-terminated are passed without copying.
+  EXPECT_FALSE(nu::TableCell(base::StringPiece("text", 2)).GetCString());
+}
+
+// Returns images that can not be stored in base::Value.
+class TestCellModel : public nu::TableModel {
+ public:
+  explicit TestCellModel(nu::Image* image) : image_(image) {}
+
+  uint32_t GetRowCount() const override {
+    return 1;
+  }
+
+  nu::TableCell GetCell(uint32_t column, uint32_t row) const override {
+    return nu::TableCell(image_.get());
+  }
+
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override {
+  }
+
+ private:
+  ~TestCellModel() override {}
+
+  scoped_refptr<nu::Image> image_;
+};
+
+TEST_F(TableTest, CustomCellOfImage) {
+  scoped_refptr<nu::Image> image(new nu::Image(nu::Buffer(), 1.f));
+  scoped_refptr<nu::TableModel> model(new TestCellModel(image.get()));
+  nu::TableCell cell = model->GetCell(0, 0);
+  ASSERT_TRUE(cell.is_image());
+  EXPECT_EQ(cell.GetImage(), image.get());
+  // Images can not be stored in base::Value.
+  EXPECT_TRUE(model->GetValue(0, 0)->is_none());
+  table_->SetModel(model.get());
+}
+
+TEST_F(TableTest, CellOfAtlasImage) {
+  scoped_refptr<nu::ImageAtlas> atlas(new nu::ImageAtlas(nu::SizeF(4, 4), 1));
+  scoped_refptr<nu::AtlasImage> image(
+      new nu::AtlasImage(atlas.get(), nu::RectF(0, 0, 2, 2)));
+  nu::TableCell cell(image.get());
+  ASSERT_TRUE(cell.is_atlas_image());
+  EXPECT_FALSE(cell.is_image());
+  EXPECT_EQ(cell.GetAtlasImage(), image.get());
+  EXPECT_TRUE(cell.ToValue().is_none());
+}
+
+TEST_F(TableTest, ColumnDrawHandlers) {
+  nu::Table::ColumnOptions options;
+  EXPECT_FALSE(options.HasDrawHandler());
+  std::string drawn;
+  options.on_draw = [&drawn](nu::Painter*, const nu::RectF&,
+                             const base::Value& value) {
+    drawn = "value " + value.GetString();
+  };
+  EXPECT_TRUE(options.HasDrawHandler());
+  options.Draw(nullptr, nu::RectF(), nu::TableCell("a"));
+  EXPECT_EQ(drawn, "value a");
+  // The cell handler is preferred.
+  options.on_draw_cell = [&drawn](nu::Painter*, const nu::RectF&,
+                                  const nu::TableCell& cell) {
+    drawn = "cell " + cell.GetString().as_string();
+  };
+  options.Draw(nullptr, nu::RectF(), nu::TableCell("b"));
+  EXPECT_EQ(drawn, "cell b");
+}
+
+#if defined(OS_LINUX)
+TEST_F(TableTest, SelectRanges) {
+  table_->SetModel(new TestTableModel);
+  table_->SetMultipleSelection(true);
+  std::vector<nu::Range> added, removed;
+  table_->on_selection_change.Connect(
+      [&](nu::Table*, const std::vector<nu::Range>& a,
+          const std::vector<nu::Range>& r) {
+    added = a;
+    removed = r;
+  });
+  table_->SelectAll();
+  EXPECT_EQ(table_->GetSelectedRanges(),
+            std::vector<nu::Range>({{0, 10000}}));
+  table_->ToggleRange(10, 20);
+  EXPECT_EQ(removed, std::vector<nu::Range>({{10, 20}}));
+  EXPECT_FALSE(table_->IsRowSelected(15));
+  table_->InvertSelection();
+  EXPECT_EQ(table_->GetSelectedRanges(), std::vector<nu::Range>({{10, 20}}));
+  EXPECT_EQ(table_->GetSelectedRow(), 10);
+  table_->SetMultipleSelection(false);
+  EXPECT_EQ(table_->GetSelectedRanges(), std::vector<nu::Range>({{10, 11}}));
+}
+#endif
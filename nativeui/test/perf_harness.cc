@@ -0,0 +1,206 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/perf_harness.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace nu {
+
+namespace {
+
+PerfReporter* g_current_reporter = nullptr;
+
+// Compute the summary of |samples|.
+void Summarize(std::vector<double> samples, PerfResult* result) {
+  if (samples.empty())
+    return;
+  std::sort(samples.begin(), samples.end());
+  size_t n = samples.size();
+  double sum = 0;
+  for (double sample : samples)
+    sum += sample;
+  result->iterations = static_cast<int>(n);
+  result->mean = sum / n;
+  result->median = n % 2 ? samples[n / 2]
+                         : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  result->min = samples.front();
+  result->max = samples.back();
+  double variance = 0;
+  for (double sample : samples)
+    variance += (sample - result->mean) * (sample - result->mean);
+  result->stddev = n > 1 ? std::sqrt(variance / (n - 1)) : 0;
+}
+
+int GetIntSwitch(const base::CommandLine& command_line,
+                 const char* name,
+                 int default_value) {
+  int value;
+  if (!command_line.HasSwitch(name) ||
+      !base::StringToInt(command_line.GetSwitchValueASCII(name), &value))
+    return default_value;
+  return value;
+}
+
+}  // namespace
+
+// static
+PerfReporter* PerfReporter::GetCurrent() {
+  return g_current_reporter;
+}
+
+PerfReporter::PerfReporter(const base::CommandLine& command_line) {
+  DCHECK(!g_current_reporter) << "There should only be one PerfReporter";
+  g_current_reporter = this;
+  warmup_ = std::max(0, GetIntSwitch(command_line, "perf-warmup", warmup_));
+  iterations_ = std::max(
+      1, GetIntSwitch(command_line, "perf-iterations", iterations_));
+  threshold_ = GetIntSwitch(command_line, "perf-threshold", threshold_);
+  json_path_ = command_line.GetSwitchValuePath("perf-json");
+  baseline_path_ = command_line.GetSwitchValuePath("perf-baseline");
+}
+
+PerfReporter::~PerfReporter() {
+  g_current_reporter = nullptr;
+}
+
+const PerfResult& PerfReporter::Run(const std::string& name,
+                                    int items,
+                                    const std::function<void()>& task,
+                                    const std::function<void()>& setup) {
+  for (int i = 0; i < warmup_; ++i) {
+    if (setup)
+      setup();
+    task();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(iterations_);
+  for (int i = 0; i < iterations_; ++i) {
+    if (setup)
+      setup();
+    base::TimeTicks start = base::TimeTicks::Now();
+    task();
+    samples.push_back((base::TimeTicks::Now() - start).InMicrosecondsF());
+  }
+
+  PerfResult result;
+  result.name = name;
+  result.items = std::max(1, items);
+  Summarize(std::move(samples), &result);
+  printf("[ PERF     ] %-40s %12.3f us/iter (median %.3f, stddev %.3f), "
+         "%.3f us/item\n",
+         name.c_str(), result.mean, result.median, result.stddev,
+         result.mean_per_item());
+  results_.push_back(std::move(result));
+  return results_.back();
+}
+
+bool PerfReporter::Finish() {
+  if (!json_path_.empty() && !WriteJSON(json_path_))
+    LOG(ERROR) << "Failed to write results to " << json_path_.value();
+
+  if (baseline_path_.empty())
+    return true;
+  std::map<std::string, double> baseline;
+  if (!ReadBaseline(baseline_path_, &baseline)) {
+    LOG(ERROR) << "Failed to read baseline from " << baseline_path_.value();
+    return false;
+  }
+
+  // Compare the per-item medians, which are less affected by outliers.
+  bool passed = true;
+  printf("\n%-40s %14s %14s %9s\n", "Benchmark", "Baseline", "Current",
+         "Delta");
+  for (const PerfResult& result : results_) {
+    double current = result.median / result.items;
+    auto it = baseline.find(result.name);
+    if (it == baseline.end() || it->second <= 0) {
+      printf("%-40s %14s %14.3f %9s\n", result.name.c_str(), "-", current,
+             "new");
+      continue;
+    }
+    double delta = (current - it->second) / it->second * 100;
+    bool regressed = threshold_ >= 0 && delta > threshold_;
+    if (regressed)
+      passed = false;
+    printf("%-40s %14.3f %14.3f %+8.1f%%%s\n", result.name.c_str(), it->second,
+           current, delta, regressed ? " REGRESSED" : "");
+  }
+  return passed;
+}
+
+bool PerfReporter::WriteJSON(const base::FilePath& path) const {
+  base::Value list(base::Value::Type::LIST);
+  for (const PerfResult& result : results_) {
+    base::Value entry(base::Value::Type::DICTIONARY);
+    entry.SetKey("name", base::Value(result.name));
+    entry.SetKey("items", base::Value(result.items));
+    entry.SetKey("iterations", base::Value(result.iterations));
+    entry.SetKey("mean", base::Value(result.mean));
+    entry.SetKey("median", base::Value(result.median));
+    entry.SetKey("stddev", base::Value(result.stddev));
+    entry.SetKey("min", base::Value(result.min));
+    entry.SetKey("max", base::Value(result.max));
+    entry.SetKey("median_per_item", base::Value(result.median / result.items));
+    list.GetList().push_back(std::move(entry));
+  }
+  base::Value root(base::Value::Type::DICTIONARY);
+  root.SetKey("unit", base::Value("us"));
+  root.SetKey("results", std::move(list));
+
+  std::string json;
+  if (!base::JSONWriter::WriteWithOptions(
+          root, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json))
+    return false;
+  return base::WriteFile(path, json.data(), static_cast<int>(json.size())) ==
+         static_cast<int>(json.size());
+}
+
+bool PerfReporter::ReadBaseline(const base::FilePath& path,
+                                std::map<std::string, double>* baseline) const {
+  std::string json;
+  if (!base::ReadFileToString(path, &json))
+    return false;
+  std::unique_ptr<base::Value> root = base::JSONReader::Read(json);
+  if (!root || !root->is_dict())
+    return false;
+  const base::Value* results = root->FindKey("results");
+  if (!results || !results->is_list())
+    return false;
+  for (const base::Value& entry : results->GetList()) {
+    if (!entry.is_dict())
+      continue;
+    const base::Value* name = entry.FindKey("name");
+    const base::Value* value = entry.FindKey("median_per_item");
+    if (!name || !name->is_string() || !value ||
+        !(value->is_double() || value->is_int()))
+      continue;
+    (*baseline)[name->GetString()] = value->GetDouble();
+  }
+  return true;
+}
+
+const PerfResult& RunPerfTest(const std::string& name,
+                              int items,
+                              const std::function<void()>& task,
+                              const std::function<void()>& setup) {
+  return PerfReporter::GetCurrent()->Run(name, items, task, setup);
+}
+
+}  // namespace nu
@@ -0,0 +1,94 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_PERF_HARNESS_H_
+#define NATIVEUI_TEST_PERF_HARNESS_H_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+
+namespace base {
+class CommandLine;
+}
+
+namespace nu {
+
+// Summary of a benchmark, all durations are in microseconds.
+struct PerfResult {
+  std::string name;
+  // How many work items are done in each iteration.
+  int items = 1;
+  int iterations = 0;
+  double mean = 0;
+  double median = 0;
+  double stddev = 0;
+  double min = 0;
+  double max = 0;
+
+  // Average time spent on each work item.
+  double mean_per_item() const { return mean / items; }
+};
+
+// Collects benchmark results of the whole run.
+//
+// Recognized switches:
+//   --perf-warmup=N      Runs before measuring, default 3.
+//   --perf-iterations=N  Measured runs, default 20.
+//   --perf-json=PATH     Write results to PATH in JSON.
+//   --perf-baseline=PATH Compare results with a JSON file written before.
+//   --perf-threshold=N   Percentage of change reported as regression, when
+//                        not set the comparison is only printed.
+class PerfReporter {
+ public:
+  static PerfReporter* GetCurrent();
+
+  explicit PerfReporter(const base::CommandLine& command_line);
+  ~PerfReporter();
+
+  // Run |task| with warmups and record the summary, |items| is the number of
+  // work items done in each run. The |setup| is called before each run and is
+  // not measured.
+  const PerfResult& Run(const std::string& name,
+                        int items,
+                        const std::function<void()>& task,
+                        const std::function<void()>& setup = nullptr);
+
+  // Write JSON and print the comparison with baseline, return false if there
+  // are regressions beyond the threshold.
+  bool Finish();
+
+  int warmup() const { return warmup_; }
+  int iterations() const { return iterations_; }
+
+ private:
+  bool WriteJSON(const base::FilePath& path) const;
+  bool ReadBaseline(const base::FilePath& path,
+                    std::map<std::string, double>* baseline) const;
+
+  int warmup_ = 3;
+  int iterations_ = 20;
+  // Negative value means regressions are not checked.
+  double threshold_ = -1;
+  base::FilePath json_path_;
+  base::FilePath baseline_path_;
+
+  std::vector<PerfResult> results_;
+
+  DISALLOW_COPY_AND_ASSIGN(PerfReporter);
+};
+
+// Shorthand of PerfReporter::GetCurrent()->Run().
+const PerfResult& RunPerfTest(const std::string& name,
+                              int items,
+                              const std::function<void()>& task,
+                              const std::function<void()>& setup = nullptr);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TEST_PERF_HARNESS_H_
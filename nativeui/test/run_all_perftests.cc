@@ -0,0 +1,19 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/command_line.h"
+#include "base/debug/stack_trace.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  base::CommandLine::Init(argc, argv);
+  base::debug::EnableInProcessStackDumping();
+  nu::PerfReporter reporter(*base::CommandLine::ForCurrentProcess());
+  int result = RUN_ALL_TESTS();
+  if (!reporter.Finish())
+    result = 1;
+  return result;
+}
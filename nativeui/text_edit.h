@@ -21,6 +21,7 @@ class NATIVEUI_EXPORT TextEdit : public View {
 
   // View:
   const char* GetClassName() const override;
+  size_t EstimateMemoryUsage() const override;
 
   void SetText(const std::string& text);
   std::string GetText() const;
@@ -0,0 +1,45 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree.h"
+
+namespace nu {
+
+// static
+const char Tree::kClassName[] = "Tree";
+
+Tree::Tree() : weak_factory_(this) {
+  TakeOverView(PlatformCreate());
+}
+
+Tree::~Tree() {
+  // The widget relies on Tree to get nodes, so we must ensure the widget is
+  // destroyed before this class.
+  PlatformDestroy();
+  if (model_)
+    model_->Unsubscribe(this);
+}
+
+void Tree::SetModel(TreeModel* model) {
+  if (model_)
+    model_->Unsubscribe(this);
+  PlatformSetModel(model);
+  model_ = model;
+  if (model_)
+    model_->Subscribe(this);
+}
+
+TreeModel* Tree::GetModel() {
+  return model_.get();
+}
+
+void Tree::AddColumn(const std::string& title) {
+  AddColumnWithOptions(title, Table::ColumnOptions());
+}
+
+const char* Tree::GetClassName() const {
+  return kClassName;
+}
+
+}  // namespace nu
@@ -0,0 +1,78 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TREE_H_
+#define NATIVEUI_TREE_H_
+
+#include <string>
+
+#include "base/memory/weak_ptr.h"
+#include "nativeui/table.h"
+#include "nativeui/tree_model.h"
+
+namespace nu {
+
+// Shows hierarchical data of TreeModel, only the children of expanded nodes
+// are loaded and materialized.
+class NATIVEUI_EXPORT Tree : public View {
+ public:
+  using NodeId = TreeModel::NodeId;
+
+  Tree();
+
+  // View class name.
+  static const char kClassName[];
+
+  void SetModel(TreeModel* model);
+  TreeModel* GetModel();
+  void AddColumn(const std::string& title);
+  void AddColumnWithOptions(const std::string& title,
+                            const Table::ColumnOptions& options);
+  int GetColumnCount() const;
+  void SetColumnsVisible(bool visible);
+  bool IsColumnsVisible() const;
+
+  // Expanding a node loads its children first if they have not been loaded,
+  // the ancestors of |node| are expanded too.
+  void ExpandNode(NodeId node);
+  void CollapseNode(NodeId node);
+  bool IsNodeExpanded(NodeId node) const;
+
+  void SelectNode(NodeId node);
+  // Return kRootNode when no node is selected.
+  NodeId GetSelectedNode() const;
+
+  // View:
+  const char* GetClassName() const override;
+
+  // Internal: Used by callbacks that must not keep the tree alive. Note that
+  // it is not called GetWeakPtr, which would make bindings treat Tree as a
+  // weak object instead of a refcounted one.
+  base::WeakPtr<Tree> AsWeakPtr() { return weak_factory_.GetWeakPtr(); }
+
+  // Events.
+  Signal<void(Tree*, NodeId)> on_node_expand;
+  Signal<void(Tree*, NodeId)> on_node_collapse;
+
+ protected:
+  ~Tree() override;
+
+ private:
+  friend class TreeModel;
+
+  NativeView PlatformCreate();
+  void PlatformSetModel(TreeModel* model);
+
+  // Called by TreeModel.
+  void NotifyChildrenChanged(NodeId parent);
+  void NotifyNodeChanged(NodeId node);
+
+  scoped_refptr<TreeModel> model_;
+
+  base::WeakPtrFactory<Tree> weak_factory_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TREE_H_
@@ -0,0 +1,124 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_model.h"
+
+#include <utility>
+
+#include "nativeui/tree.h"
+
+namespace nu {
+
+///////////////////////////////////////////////////////////////////////////////
+// TreeModel implementation.
+
+// static
+const TreeModel::NodeId TreeModel::kRootNode;
+
+TreeModel::TreeModel() {}
+
+TreeModel::~TreeModel() {}
+
+void TreeModel::SetValue(uint32_t column, NodeId node, base::Value value) {
+}
+
+void TreeModel::LoadChildren(NodeId node, const LoadCallback& done) {
+  done();
+}
+
+void TreeModel::NotifyChildrenChanged(NodeId parent) {
+  for (Tree* tree : trees_)
+    tree->NotifyChildrenChanged(parent);
+}
+
+void TreeModel::NotifyNodeChanged(NodeId node) {
+  for (Tree* tree : trees_)
+    tree->NotifyNodeChanged(node);
+}
+
+const char* TreeModel::GetMemoryClassName() const {
+  return "TreeModel";
+}
+
+size_t TreeModel::EstimateMemoryUsage() const {
+  return sizeof(TreeModel) + trees_.size() * sizeof(Tree*);
+}
+
+void TreeModel::Subscribe(Tree* view) {
+  trees_.push_back(view);
+}
+
+void TreeModel::Unsubscribe(Tree* view) {
+  trees_.remove(view);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// AbstractTreeModel implementation.
+
+AbstractTreeModel::AbstractTreeModel(bool index_starts_from_0)
+    : index_starts_from_0_(index_starts_from_0) {}
+
+AbstractTreeModel::~AbstractTreeModel() {}
+
+uint32_t AbstractTreeModel::GetChildCount(NodeId parent) const {
+  if (!get_child_count)
+    return 0;
+  return get_child_count(const_cast<AbstractTreeModel*>(this), parent);
+}
+
+TreeModel::NodeId AbstractTreeModel::GetChildAt(NodeId parent,
+                                                uint32_t index) const {
+  if (!get_child_at)
+    return kRootNode;
+  if (!index_starts_from_0_)
+    index += 1;
+  return get_child_at(const_cast<AbstractTreeModel*>(this), parent, index);
+}
+
+TreeModel::NodeId AbstractTreeModel::GetParent(NodeId node) const {
+  if (!get_parent)
+    return kRootNode;
+  return get_parent(const_cast<AbstractTreeModel*>(this), node);
+}
+
+bool AbstractTreeModel::HasChildren(NodeId node) const {
+  if (!has_children)
+    return GetChildCount(node) > 0;
+  return has_children(const_cast<AbstractTreeModel*>(this), node);
+}
+
+TableCell AbstractTreeModel::GetCell(uint32_t column, NodeId node) const {
+  if (!get_value)
+    return TableCell();
+  if (!index_starts_from_0_)
+    column += 1;
+  // We can not get a reference from scripting languages, so we just store a
+  // temporary copy and return a view of the copy.
+  auto* self = const_cast<AbstractTreeModel*>(this);
+  self->copy_ = get_value(self, column, node);
+  return TableCell::FromValue(&copy_);
+}
+
+void AbstractTreeModel::SetValue(uint32_t column, NodeId node,
+                                 base::Value value) {
+  if (!set_value)
+    return;
+  if (!index_starts_from_0_)
+    column += 1;
+  set_value(this, column, node, std::move(value));
+}
+
+void AbstractTreeModel::LoadChildren(NodeId node, const LoadCallback& done) {
+  if (!load_children) {
+    done();
+    return;
+  }
+  load_children(this, node, done);
+}
+
+const char* AbstractTreeModel::GetMemoryClassName() const {
+  return "AbstractTreeModel";
+}
+
+}  // namespace nu
@@ -0,0 +1,118 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TREE_MODEL_H_
+#define NATIVEUI_TREE_MODEL_H_
+
+#include <functional>
+#include <list>
+
+#include "base/memory/ref_counted.h"
+#include "base/values.h"
+#include "nativeui/memory_dump.h"
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+class Tree;
+
+// Users should subclass TreeModel to provide hierarchical data.
+//
+// Nodes are identified by IDs chosen by the model, which must stay the same
+// while the node exists. The ID of root node is kRootNode, the root node is
+// never displayed.
+class NATIVEUI_EXPORT TreeModel : public base::RefCounted<TreeModel>,
+                                   public MemoryTracked {
+ public:
+  using NodeId = uint64_t;
+  static const NodeId kRootNode = 0;
+
+  // Return how many children the |parent| has, it is only called after the
+  // children of |parent| have been loaded.
+  virtual uint32_t GetChildCount(NodeId parent) const = 0;
+
+  // Return the ID of the child at |index| of |parent|.
+  virtual NodeId GetChildAt(NodeId parent, uint32_t index) const = 0;
+
+  // Return the ID of the parent of |node|.
+  virtual NodeId GetParent(NodeId node) const = 0;
+
+  // Return whether |node| may have children, it is called before the children
+  // are loaded so it should be cheap.
+  virtual bool HasChildren(NodeId node) const = 0;
+
+  // Return a view of the data of |node| at |column|.
+  virtual TableCell GetCell(uint32_t column, NodeId node) const = 0;
+
+  // Change the value, called when user edits a cell.
+  virtual void SetValue(uint32_t column, NodeId node, base::Value value);
+
+  // Called when the children of |node| are needed for the first time, the
+  // model should call |done| after the children are ready, which can happen
+  // asynchronously. The default implementation calls |done| immediately.
+  using LoadCallback = std::function<void()>;
+  virtual void LoadChildren(NodeId node, const LoadCallback& done);
+
+  // Called by subclass to notify when the children of |parent| have changed.
+  void NotifyChildrenChanged(NodeId parent);
+  void NotifyNodeChanged(NodeId node);
+
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+  size_t EstimateMemoryUsage() const override;
+
+ protected:
+  TreeModel();
+  virtual ~TreeModel();
+
+ private:
+  friend class base::RefCounted<TreeModel>;
+  friend class Tree;
+
+  // Called by tree.
+  void Subscribe(Tree* view);
+  void Unsubscribe(Tree* view);
+
+  std::list<Tree*> trees_;
+};
+
+// Used by language bindings.
+class NATIVEUI_EXPORT AbstractTreeModel : public TreeModel {
+ public:
+  explicit AbstractTreeModel(bool index_starts_from_0 = true);
+
+  // TreeModel:
+  uint32_t GetChildCount(NodeId parent) const override;
+  NodeId GetChildAt(NodeId parent, uint32_t index) const override;
+  NodeId GetParent(NodeId node) const override;
+  bool HasChildren(NodeId node) const override;
+  TableCell GetCell(uint32_t column, NodeId node) const override;
+  void SetValue(uint32_t column, NodeId node, base::Value value) override;
+  void LoadChildren(NodeId node, const LoadCallback& done) override;
+
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+
+  // Delegate methods.
+  std::function<uint32_t(AbstractTreeModel*, NodeId)> get_child_count;
+  std::function<NodeId(AbstractTreeModel*, NodeId, uint32_t)> get_child_at;
+  std::function<NodeId(AbstractTreeModel*, NodeId)> get_parent;
+  std::function<bool(AbstractTreeModel*, NodeId)> has_children;
+  std::function<base::Value(AbstractTreeModel*, uint32_t, NodeId)> get_value;
+  std::function<void(AbstractTreeModel*,
+                     uint32_t, NodeId, base::Value)> set_value;
+  std::function<void(AbstractTreeModel*,
+                     NodeId, const LoadCallback&)> load_children;
+
+ protected:
+  ~AbstractTreeModel() override;
+
+ private:
+  bool index_starts_from_0_;
+  base::Value copy_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TREE_MODEL_H_
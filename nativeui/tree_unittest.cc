@@ -0,0 +1,209 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <gtk/gtk.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "nativeui/gtk/nu_node_model.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Every node has 10 children unless changed by SetChildCount, the child at |i|
+// of |parent| has the ID of |parent| * 10 + |i| + 1, nodes with IDs larger
+// than 1000 have no children.
+class TestTreeModel : public nu::TreeModel {
+ public:
+  explicit TestTreeModel(bool async) : async_(async) {}
+
+  uint32_t GetChildCount(NodeId parent) const override {
+    auto it = child_counts_.find(parent);
+    if (it != child_counts_.end())
+      return it->second;
+    return parent > 1000 ? 0 : 10;
+  }
+
+  NodeId GetChildAt(NodeId parent, uint32_t index) const override {
+    return parent * 10 + index + 1;
+  }
+
+  NodeId GetParent(NodeId node) const override {
+    return (node - 1) / 10;
+  }
+
+  bool HasChildren(NodeId node) const override {
+    return GetChildCount(node) > 0;
+  }
+
+  nu::TableCell GetCell(uint32_t column, NodeId node) const override {
+    return nu::TableCell(static_cast<int64_t>(node));
+  }
+
+  void LoadChildren(NodeId node, const LoadCallback& done) override {
+    loaded_.insert(node);
+    if (async_)
+      pending_.push_back(done);
+    else
+      done();
+  }
+
+  // Finish all pending loads.
+  void FinishLoading() {
+    std::vector<LoadCallback> pending;
+    pending.swap(pending_);
+    for (const auto& done : pending)
+      done();
+  }
+
+  void SetChildCount(NodeId parent, uint32_t count) {
+    child_counts_[parent] = count;
+  }
+
+  const std::set<NodeId>& loaded() const { return loaded_; }
+
+ private:
+  ~TestTreeModel() override {}
+
+  bool async_;
+  std::map<NodeId, uint32_t> child_counts_;
+  std::set<NodeId> loaded_;
+  std::vector<LoadCallback> pending_;
+};
+
+}  // namespace
+
+class TreeTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    tree_ = new nu::Tree();
+    tree_->AddColumn("ID");
+  }
+
+  // Return the IDs of the rows shown under |parent|.
+  std::vector<nu::TreeModel::NodeId> GetRows(nu::TreeModel::NodeId parent) {
+    std::vector<nu::TreeModel::NodeId> rows;
+    GtkTreeView* tree_view = GTK_TREE_VIEW(
+        g_object_get_data(G_OBJECT(tree_->GetNative()), "tree-view"));
+    GtkTreeModel* model = gtk_tree_view_get_model(tree_view);
+    if (!model)
+      return rows;
+    GtkTreeIter parent_iter;
+    if (parent != nu::TreeModel::kRootNode &&
+        !nu::nu_node_model_get_iter(NU_NODE_MODEL(model), parent,
+                                    &parent_iter))
+      return rows;
+    GtkTreeIter iter;
+    if (!gtk_tree_model_iter_children(
+            model, &iter,
+            parent == nu::TreeModel::kRootNode ? nullptr : &parent_iter))
+      return rows;
+    do {
+      rows.push_back(nu::nu_node_model_get_node_id(NU_NODE_MODEL(model),
+                                                   &iter));
+    } while (gtk_tree_model_iter_next(model, &iter));
+    return rows;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Tree> tree_;
+};
+
+TEST_F(TreeTest, OnlyLoadsRoot) {
+  scoped_refptr<TestTreeModel> model(new TestTreeModel(false));
+  tree_->SetModel(model.get());
+  EXPECT_EQ(model->loaded(), std::set<nu::TreeModel::NodeId>({0}));
+  EXPECT_FALSE(tree_->IsNodeExpanded(1));
+}
+
+TEST_F(TreeTest, ExpandNode) {
+  scoped_refptr<TestTreeModel> model(new TestTreeModel(false));
+  tree_->SetModel(model.get());
+  int expanded = 0;
+  tree_->on_node_expand.Connect([&](nu::Tree*, nu::TreeModel::NodeId) {
+    expanded++;
+  });
+  // Ancestors are expanded too.
+  tree_->ExpandNode(123);
+  EXPECT_TRUE(tree_->IsNodeExpanded(1));
+  EXPECT_TRUE(tree_->IsNodeExpanded(12));
+  EXPECT_TRUE(tree_->IsNodeExpanded(123));
+  EXPECT_EQ(expanded, 3);
+  EXPECT_EQ(model->loaded(),
+            std::set<nu::TreeModel::NodeId>({0, 1, 12, 123}));
+  tree_->CollapseNode(12);
+  EXPECT_FALSE(tree_->IsNodeExpanded(12));
+  EXPECT_TRUE(tree_->IsNodeExpanded(1));
+}
+
+TEST_F(TreeTest, AsyncLoading) {
+  scoped_refptr<TestTreeModel> model(new TestTreeModel(true));
+  tree_->SetModel(model.get());
+  model->FinishLoading();
+  tree_->ExpandNode(5);
+  EXPECT_FALSE(tree_->IsNodeExpanded(5));
+  model->FinishLoading();
+  EXPECT_TRUE(tree_->IsNodeExpanded(5));
+}
+
+TEST_F(TreeTest, SelectNode) {
+  tree_->SetModel(new TestTreeModel(false));
+  EXPECT_EQ(tree_->GetSelectedNode(), nu::TreeModel::kRootNode);
+  tree_->SelectNode(34);
+  EXPECT_TRUE(tree_->IsNodeExpanded(3));
+  EXPECT_EQ(tree_->GetSelectedNode(), 34u);
+}
+
+TEST_F(TreeTest, ChildrenChanged) {
+  scoped_refptr<TestTreeModel> model(new TestTreeModel(false));
+  tree_->SetModel(model.get());
+  tree_->ExpandNode(12);
+  model->SetChildCount(1, 3);
+  model->NotifyChildrenChanged(1);
+  // The nodes that are still there keep their expansion states.
+  EXPECT_TRUE(tree_->IsNodeExpanded(1));
+  EXPECT_TRUE(tree_->IsNodeExpanded(12));
+  EXPECT_EQ(GetRows(1), std::vector<nu::TreeModel::NodeId>({11, 12, 13}));
+  model->SetChildCount(nu::TreeModel::kRootNode, 2);
+  model->NotifyChildrenChanged(nu::TreeModel::kRootNode);
+  EXPECT_TRUE(tree_->IsNodeExpanded(1));
+  EXPECT_TRUE(tree_->IsNodeExpanded(12));
+  EXPECT_EQ(GetRows(nu::TreeModel::kRootNode),
+            std::vector<nu::TreeModel::NodeId>({1, 2}));
+  // New children are inserted without changing the existing ones.
+  model->SetChildCount(nu::TreeModel::kRootNode, 4);
+  model->NotifyChildrenChanged(nu::TreeModel::kRootNode);
+  EXPECT_TRUE(tree_->IsNodeExpanded(1));
+  EXPECT_EQ(GetRows(nu::TreeModel::kRootNode),
+            std::vector<nu::TreeModel::NodeId>({1, 2, 3, 4}));
+  // Removing all children of an expanded node.
+  model->SetChildCount(1, 0);
+  model->NotifyChildrenChanged(1);
+  EXPECT_TRUE(GetRows(1).empty());
+  EXPECT_FALSE(tree_->IsNodeExpanded(12));
+}
+
+TEST_F(TreeTest, PendingLoadDoesNotKeepTree) {
+  auto live_trees = []() {
+    auto usage = nu::GetMemoryUsage();
+    auto it = usage.find(nu::Tree::kClassName);
+    return it == usage.end() ? 0 : it->second.count;
+  };
+  nu::EnableMemoryTracking();
+  tree_ = new nu::Tree();
+  tree_->AddColumn("ID");
+  int trees = live_trees();
+  scoped_refptr<TestTreeModel> model(new TestTreeModel(true));
+  tree_->SetModel(model.get());
+  model->FinishLoading();
+  tree_->ExpandNode(5);
+  tree_ = nullptr;
+  EXPECT_EQ(live_trees(), trees - 1);
+  // Finishing the loads after the tree is gone does nothing.
+  model->FinishLoading();
+}
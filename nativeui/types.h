@@ -27,6 +27,7 @@ typedef struct _GtkMenuShell GtkMenuShell;
 typedef struct _GtkWidget GtkWidget;
 typedef struct _GtkWindow GtkWindow;
 typedef struct _PangoFontDescription PangoFontDescription;
+typedef struct _PangoLayout PangoLayout;
 typedef struct _cairo_surface cairo_surface_t;
 typedef struct _cairo cairo_t;
 typedef union _GdkEvent GdkEvent;
@@ -42,6 +43,7 @@ typedef struct CGContext* CGContextRef;
 @class NSImage;
 @class NSMenu;
 @class NSMenuItem;
+@class NSMutableAttributedString;
 @class NSSavePanel;
 @class NSStatusItem;
 @class NSToolbar;
@@ -55,6 +57,7 @@ class NSGraphicsContext;
 class NSImage;
 class NSMenu;
 class NSMenuItem;
+class NSMutableAttributedString;
 class NSSavePanel;
 class NSStatusItem;
 class NSToolbar;
@@ -85,6 +88,7 @@ class Image;
 namespace nu {
 
 #if defined(OS_WIN)
+struct AttributedTextImpl;
 class FileDialogImpl;
 class TrayImpl;
 class ViewImpl;
@@ -102,6 +106,7 @@ using NativeBitmap = CGContextRef;
 using NativeImage = NSImage*;
 using nativeGraphicsContext = NSGraphicsContext*;
 using NativeFont = NSFont*;
+using NativeAttributedText = NSMutableAttributedString*;
 using NativeMenu = NSMenu*;
 using NativeMenuItem = NSMenuItem*;
 using NativeToolbar = NSToolbar*;
@@ -115,6 +120,7 @@ using NativeBitmap = cairo_surface_t*;
 using NativeImage = GdkPixbufAnimation*;
 using nativeGraphicsContext = cairo_t*;
 using NativeFont = PangoFontDescription*;
+using NativeAttributedText = PangoLayout*;
 using NativeMenu = GtkMenuShell*;
 using NativeMenuItem = GtkMenuItem*;
 using NativeTray = AppIndicator*;
@@ -125,6 +131,7 @@ using NativeView = ViewImpl*;
 using NativeWindow = WindowImpl*;
 using NativeBitmap = Gdiplus::Bitmap*;
 using NativeFont = Gdiplus::Font*;
+using NativeAttributedText = AttributedTextImpl*;
 using nativeGraphicsContext = Gdiplus::Graphics*;
 using NativeImage = Gdiplus::Image*;
 using NativeMenu = HMENU;
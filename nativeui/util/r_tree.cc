@@ -0,0 +1,296 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/r_tree.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nu {
+
+namespace {
+
+// Order branches so each run of |max_children| branches is spatially close,
+// the input is sorted into vertical slices by x and then by y in each slice.
+template<typename Branch>
+void SortTileRecursive(std::vector<Branch>* branches, size_t max_children) {
+  size_t count = branches->size();
+  size_t nodes = (count + max_children - 1) / max_children;
+  size_t slices = static_cast<size_t>(std::ceil(std::sqrt(nodes)));
+  size_t slice_size = slices * max_children;
+  std::sort(branches->begin(), branches->end(),
+            [](const Branch& a, const Branch& b) {
+              return a.bounds.CenterPoint().x() < b.bounds.CenterPoint().x();
+            });
+  for (size_t i = 0; i < count; i += slice_size) {
+    std::sort(branches->begin() + i,
+              branches->begin() + std::min(i + slice_size, count),
+              [](const Branch& a, const Branch& b) {
+                return a.bounds.CenterPoint().y() < b.bounds.CenterPoint().y();
+              });
+  }
+}
+
+// Same with RectF::Contains but includes the right and bottom edges, so
+// points on the edges of adjacent nodes are not missed.
+inline bool ContainsInclusive(const RectF& rect, const PointF& point) {
+  return point.x() >= rect.x() && point.x() <= rect.right() &&
+         point.y() >= rect.y() && point.y() <= rect.bottom();
+}
+
+inline float GetArea(const RectF& rect) {
+  return rect.width() * rect.height();
+}
+
+}  // namespace
+
+RTree::RTree() {}
+
+RTree::~RTree() {}
+
+void RTree::Build(const std::vector<RectF>& rects) {
+  Clear();
+  std::vector<Branch> branches;
+  branches.reserve(rects.size());
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (!rects[i].IsEmpty())
+      branches.push_back({rects[i], i});
+  }
+  if (branches.empty())
+    return;
+
+  // Pack the tree level by level from the leaves.
+  bool is_leaf = true;
+  while (true) {
+    SortTileRecursive(&branches, kMaxChildren);
+    std::vector<Branch> parents;
+    parents.reserve((branches.size() + kMaxChildren - 1) / kMaxChildren);
+    for (size_t i = 0; i < branches.size(); i += kMaxChildren) {
+      Node node;
+      node.is_leaf = is_leaf;
+      node.num_children = std::min(kMaxChildren, branches.size() - i);
+      RectF bounds;
+      for (size_t j = 0; j < node.num_children; ++j) {
+        node.children[j] = branches[i + j];
+        bounds.Union(branches[i + j].bounds);
+      }
+      parents.push_back({bounds, nodes_.size()});
+      nodes_.push_back(node);
+    }
+    if (parents.size() == 1) {
+      root_ = parents[0].index;
+      return;
+    }
+    branches.swap(parents);
+    is_leaf = false;
+  }
+}
+
+void RTree::Clear() {
+  nodes_.clear();
+  free_nodes_.clear();
+  root_ = 0;
+}
+
+void RTree::Insert(size_t index, const RectF& rect) {
+  if (rect.IsEmpty())
+    return;
+  Branch entry = {rect, index};
+  if (empty()) {
+    root_ = AllocateNode(true);
+    nodes_[root_].children[0] = entry;
+    nodes_[root_].num_children = 1;
+    return;
+  }
+  Branch split;
+  if (InsertImpl(root_, entry, &split)) {
+    // Grow the tree by one level.
+    Branch old_root = {GetNodeBounds(root_), root_};
+    root_ = AllocateNode(false);
+    Node& node = nodes_[root_];
+    node.children[0] = old_root;
+    node.children[1] = split;
+    node.num_children = 2;
+  }
+}
+
+bool RTree::Remove(size_t index, const RectF& rect) {
+  if (empty() || rect.IsEmpty() || !RemoveImpl(root_, index, rect))
+    return false;
+  // Shrink the tree when root has only one child.
+  while (!nodes_[root_].is_leaf && nodes_[root_].num_children == 1) {
+    size_t child = nodes_[root_].children[0].index;
+    FreeNode(root_);
+    root_ = child;
+  }
+  if (nodes_[root_].num_children == 0)
+    Clear();
+  return true;
+}
+
+void RTree::Search(const RectF& query, std::vector<size_t>* results) const {
+  SearchImpl([&query](const RectF& rect) { return rect.Intersects(query); },
+             results);
+}
+
+void RTree::SearchPoint(const PointF& point,
+                        std::vector<size_t>* results) const {
+  SearchImpl([&point](const RectF& rect) {
+    return ContainsInclusive(rect, point);
+  }, results);
+}
+
+RectF RTree::GetBounds() const {
+  if (empty())
+    return RectF();
+  return GetNodeBounds(root_);
+}
+
+bool RTree::InsertImpl(size_t node_index, const Branch& entry,
+                       Branch* split) {
+  Branch to_add = entry;
+  if (!nodes_[node_index].is_leaf) {
+    // Choose the child that needs least enlargement to include the entry.
+    const Node& node = nodes_[node_index];
+    size_t best = 0;
+    float best_enlargement = 0;
+    float best_area = 0;
+    for (size_t i = 0; i < node.num_children; ++i) {
+      const RectF& bounds = node.children[i].bounds;
+      float area = GetArea(bounds);
+      float enlargement = GetArea(UnionRects(bounds, entry.bounds)) - area;
+      if (i == 0 || enlargement < best_enlargement ||
+          (enlargement == best_enlargement && area < best_area)) {
+        best = i;
+        best_enlargement = enlargement;
+        best_area = area;
+      }
+    }
+    size_t child = node.children[best].index;
+    Branch child_split;
+    bool child_was_split = InsertImpl(child, entry, &child_split);
+    // The |nodes_| may have been reallocated.
+    nodes_[node_index].children[best].bounds = GetNodeBounds(child);
+    if (!child_was_split)
+      return false;
+    to_add = child_split;
+  }
+  Node& node = nodes_[node_index];
+  if (node.num_children < kMaxChildren) {
+    node.children[node.num_children++] = to_add;
+    return false;
+  }
+  SplitNode(node_index, to_add, split);
+  return true;
+}
+
+void RTree::SplitNode(size_t node_index, const Branch& extra, Branch* split) {
+  std::vector<Branch> branches(nodes_[node_index].children,
+                               nodes_[node_index].children + kMaxChildren);
+  branches.push_back(extra);
+  // Split along the axis where the centers spread more.
+  PointF min = branches[0].bounds.CenterPoint();
+  PointF max = min;
+  for (const Branch& branch : branches) {
+    PointF center = branch.bounds.CenterPoint();
+    min.SetToMin(center);
+    max.SetToMax(center);
+  }
+  if (max.x() - min.x() >= max.y() - min.y()) {
+    std::sort(branches.begin(), branches.end(),
+              [](const Branch& a, const Branch& b) {
+                return a.bounds.CenterPoint().x() < b.bounds.CenterPoint().x();
+              });
+  } else {
+    std::sort(branches.begin(), branches.end(),
+              [](const Branch& a, const Branch& b) {
+                return a.bounds.CenterPoint().y() < b.bounds.CenterPoint().y();
+              });
+  }
+  size_t sibling = AllocateNode(nodes_[node_index].is_leaf);
+  Node& node = nodes_[node_index];
+  Node& other = nodes_[sibling];
+  size_t half = branches.size() / 2;
+  node.num_children = half;
+  std::copy(branches.begin(), branches.begin() + half, node.children);
+  other.num_children = branches.size() - half;
+  std::copy(branches.begin() + half, branches.end(), other.children);
+  *split = {GetNodeBounds(sibling), sibling};
+}
+
+bool RTree::RemoveImpl(size_t node_index, size_t index, const RectF& rect) {
+  // Removing never allocates nodes, so the reference is stable.
+  Node& node = nodes_[node_index];
+  for (size_t i = 0; i < node.num_children; ++i) {
+    Branch& branch = node.children[i];
+    if (node.is_leaf) {
+      if (branch.index != index)
+        continue;
+    } else {
+      // The bounds are computed with floats and may not exactly contain the
+      // rect, so test intersection instead.
+      if (!branch.bounds.Intersects(rect) ||
+          !RemoveImpl(branch.index, index, rect))
+        continue;
+      // Underfull nodes are kept, only empty ones are removed.
+      if (nodes_[branch.index].num_children > 0) {
+        branch.bounds = GetNodeBounds(branch.index);
+        return true;
+      }
+      FreeNode(branch.index);
+    }
+    node.children[i] = node.children[--node.num_children];
+    return true;
+  }
+  return false;
+}
+
+size_t RTree::AllocateNode(bool is_leaf) {
+  size_t index;
+  if (free_nodes_.empty()) {
+    index = nodes_.size();
+    nodes_.emplace_back();
+  } else {
+    index = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+  nodes_[index].is_leaf = is_leaf;
+  nodes_[index].num_children = 0;
+  return index;
+}
+
+void RTree::FreeNode(size_t node) {
+  free_nodes_.push_back(node);
+}
+
+RectF RTree::GetNodeBounds(size_t node_index) const {
+  const Node& node = nodes_[node_index];
+  RectF bounds;
+  for (size_t i = 0; i < node.num_children; ++i)
+    bounds.Union(node.children[i].bounds);
+  return bounds;
+}
+
+template<typename Predicate>
+void RTree::SearchImpl(const Predicate& intersects,
+                       std::vector<size_t>* results) const {
+  if (empty())
+    return;
+  std::vector<size_t> stack(1, root_);
+  while (!stack.empty()) {
+    const Node& node = nodes_[stack.back()];
+    stack.pop_back();
+    for (size_t i = 0; i < node.num_children; ++i) {
+      const Branch& branch = node.children[i];
+      if (!intersects(branch.bounds))
+        continue;
+      if (node.is_leaf)
+        results->push_back(branch.index);
+      else
+        stack.push_back(branch.index);
+    }
+  }
+}
+
+}  // namespace nu
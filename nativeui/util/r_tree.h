@@ -0,0 +1,90 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_R_TREE_H_
+#define NATIVEUI_UTIL_R_TREE_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+
+namespace nu {
+
+// An R-tree answering which rects intersect a rect or contain a point in
+// O(log n).
+//
+// The tree is packed with the Sort-Tile-Recursive algorithm by Build, which
+// gives the best queries, and single rects can be updated with Insert and
+// Remove in O(log n) afterwards.
+class NATIVEUI_EXPORT RTree {
+ public:
+  RTree();
+  ~RTree();
+
+  // Build the tree from |rects|, the search results are indices into |rects|.
+  // Empty rects are never found.
+  void Build(const std::vector<RectF>& rects);
+  void Clear();
+
+  // Add |rect| with |index|, empty rects are ignored.
+  void Insert(size_t index, const RectF& rect);
+
+  // Remove the rect with |index|, the |rect| must be the one inserted, and is
+  // used for finding the leaf. Return false if it is not found.
+  bool Remove(size_t index, const RectF& rect);
+
+  // Append the indices of rects intersecting |query| to |results|, the order
+  // of results is undefined.
+  void Search(const RectF& query, std::vector<size_t>* results) const;
+
+  // Append the indices of rects containing |point| to |results|.
+  void SearchPoint(const PointF& point, std::vector<size_t>* results) const;
+
+  // The union of all rects in the tree.
+  RectF GetBounds() const;
+
+  bool empty() const { return nodes_.empty(); }
+
+ private:
+  static const size_t kMaxChildren = 8;
+
+  struct Branch {
+    RectF bounds;
+    // Index of child node, or the index of rect for leaf nodes.
+    size_t index;
+  };
+
+  struct Node {
+    bool is_leaf;
+    size_t num_children;
+    Branch children[kMaxChildren];
+  };
+
+  template<typename Predicate>
+  void SearchImpl(const Predicate& intersects,
+                  std::vector<size_t>* results) const;
+
+  // Insert |entry| under |node|, return true if |node| was split and the new
+  // sibling is written to |split|.
+  bool InsertImpl(size_t node, const Branch& entry, Branch* split);
+  void SplitNode(size_t node, const Branch& extra, Branch* split);
+  bool RemoveImpl(size_t node, size_t index, const RectF& rect);
+
+  size_t AllocateNode(bool is_leaf);
+  void FreeNode(size_t node);
+  RectF GetNodeBounds(size_t node) const;
+
+  std::vector<Node> nodes_;
+  size_t root_ = 0;
+
+  // Nodes that became empty after removals, reused by insertions.
+  std::vector<size_t> free_nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(RTree);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_R_TREE_H_
@@ -0,0 +1,114 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "nativeui/util/r_tree.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(RTreeTest, Empty) {
+  nu::RTree tree;
+  std::vector<size_t> results;
+  tree.Search(nu::RectF(0, 0, 100, 100), &results);
+  EXPECT_TRUE(results.empty());
+  EXPECT_TRUE(tree.empty());
+  tree.Build({nu::RectF(), nu::RectF(10, 10, 0, 0)});
+  EXPECT_TRUE(tree.empty());
+}
+
+TEST(RTreeTest, SearchGrid) {
+  // A 100x100 grid of 10x10 cells.
+  std::vector<nu::RectF> rects;
+  for (int y = 0; y < 100; ++y)
+    for (int x = 0; x < 100; ++x)
+      rects.emplace_back(x * 10, y * 10, 10, 10);
+  nu::RTree tree;
+  tree.Build(rects);
+  EXPECT_EQ(tree.GetBounds(), nu::RectF(0, 0, 1000, 1000));
+
+  std::vector<size_t> results;
+  tree.Search(nu::RectF(15, 15, 10, 10), &results);
+  std::sort(results.begin(), results.end());
+  EXPECT_EQ(results, std::vector<size_t>({101, 102, 201, 202}));
+
+  results.clear();
+  tree.SearchPoint(nu::PointF(555, 333), &results);
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0], 3355u);
+
+  results.clear();
+  tree.Search(nu::RectF(2000, 2000, 10, 10), &results);
+  EXPECT_TRUE(results.empty());
+}
+
+namespace {
+
+// Find the rects intersecting |query| without the tree.
+std::vector<size_t> SearchSlow(const std::vector<nu::RectF>& rects,
+                               const nu::RectF& query) {
+  std::vector<size_t> results;
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (!rects[i].IsEmpty() && rects[i].Intersects(query))
+      results.push_back(i);
+  }
+  return results;
+}
+
+}  // namespace
+
+TEST(RTreeTest, InsertIntoEmpty) {
+  nu::RTree tree;
+  std::vector<nu::RectF> rects;
+  for (int i = 0; i < 100; ++i) {
+    rects.emplace_back(i * 10, (i % 7) * 10, 5, 5);
+    tree.Insert(i, rects.back());
+  }
+  tree.Insert(100, nu::RectF());
+  EXPECT_EQ(tree.GetBounds(), nu::RectF(0, 0, 995, 65));
+  nu::RectF query(95, 0, 300, 30);
+  std::vector<size_t> results;
+  tree.Search(query, &results);
+  std::sort(results.begin(), results.end());
+  EXPECT_EQ(results, SearchSlow(rects, query));
+}
+
+TEST(RTreeTest, MoveRects) {
+  std::vector<nu::RectF> rects;
+  for (int y = 0; y < 30; ++y)
+    for (int x = 0; x < 30; ++x)
+      rects.emplace_back(x * 10, y * 10, 10, 10);
+  nu::RTree tree;
+  tree.Build(rects);
+  // Move every third rect to somewhere else, like dragging items.
+  for (size_t i = 0; i < rects.size(); i += 3) {
+    ASSERT_TRUE(tree.Remove(i, rects[i]));
+    rects[i] = nu::RectF((i * 37) % 500, (i * 53) % 500, 15, 15);
+    tree.Insert(i, rects[i]);
+  }
+  EXPECT_FALSE(tree.Remove(1, nu::RectF(1000, 1000, 10, 10)));
+  for (const nu::RectF& query : {nu::RectF(0, 0, 50, 50),
+                                 nu::RectF(120, 80, 200, 30),
+                                 nu::RectF(400, 400, 100, 100)}) {
+    std::vector<size_t> results;
+    tree.Search(query, &results);
+    std::sort(results.begin(), results.end());
+    EXPECT_EQ(results, SearchSlow(rects, query));
+  }
+}
+
+TEST(RTreeTest, RemoveAll) {
+  std::vector<nu::RectF> rects;
+  for (int i = 0; i < 50; ++i)
+    rects.emplace_back(i * 10, 0, 10, 10);
+  nu::RTree tree;
+  tree.Build(rects);
+  for (size_t i = 0; i < rects.size(); ++i)
+    EXPECT_TRUE(tree.Remove(i, rects[i]));
+  EXPECT_TRUE(tree.empty());
+  tree.Insert(7, nu::RectF(0, 0, 10, 10));
+  std::vector<size_t> results;
+  tree.SearchPoint(nu::PointF(5, 5), &results);
+  EXPECT_EQ(results, std::vector<size_t>({7}));
+}
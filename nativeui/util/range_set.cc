@@ -0,0 +1,161 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/range_set.h"
+
+#include <algorithm>
+
+namespace nu {
+
+RangeSet::RangeSet() {}
+
+RangeSet::~RangeSet() {}
+
+void RangeSet::Add(const Range& range, Ranges* added) {
+  if (range.empty())
+    return;
+  // Adjacent ranges are merged, so start from the one that ends at |start|.
+  auto begin = std::lower_bound(
+      ranges_.begin(), ranges_.end(), range.start,
+      [](const Range& r, uint32_t index) { return r.end < index; });
+  Range merged = range;
+  uint32_t gap = range.start;
+  auto it = begin;
+  for (; it != ranges_.end() && it->start <= range.end; ++it) {
+    if (added && it->start > gap)
+      added->emplace_back(gap, it->start);
+    gap = std::max(gap, it->end);
+    merged.start = std::min(merged.start, it->start);
+    merged.end = std::max(merged.end, it->end);
+  }
+  if (added && gap < range.end)
+    added->emplace_back(gap, range.end);
+  // Replace the merged ranges with one range.
+  if (begin == it) {
+    ranges_.insert(begin, merged);
+  } else {
+    *begin = merged;
+    ranges_.erase(begin + 1, it);
+  }
+}
+
+void RangeSet::Remove(const Range& range, Ranges* removed) {
+  if (range.empty())
+    return;
+  auto begin = UpperBound(range.start);
+  auto it = begin;
+  Ranges remains;
+  for (; it != ranges_.end() && it->start < range.end; ++it) {
+    if (removed) {
+      removed->emplace_back(std::max(it->start, range.start),
+                            std::min(it->end, range.end));
+    }
+    if (it->start < range.start)
+      remains.emplace_back(it->start, range.start);
+    if (it->end > range.end)
+      remains.emplace_back(range.end, it->end);
+  }
+  it = ranges_.erase(begin, it);
+  ranges_.insert(it, remains.begin(), remains.end());
+}
+
+void RangeSet::Toggle(const Range& range, Ranges* added, Ranges* removed) {
+  Ranges to_remove;
+  Remove(range, &to_remove);
+  // The gaps between removed parts are added.
+  uint32_t gap = range.start;
+  for (const Range& r : to_remove) {
+    Add(Range(gap, r.start), added);
+    gap = r.end;
+  }
+  Add(Range(gap, range.end), added);
+  if (removed)
+    removed->insert(removed->end(), to_remove.begin(), to_remove.end());
+}
+
+void RangeSet::Clear(Ranges* removed) {
+  if (removed)
+    removed->insert(removed->end(), ranges_.begin(), ranges_.end());
+  ranges_.clear();
+}
+
+void RangeSet::Invert(uint32_t size, Ranges* added, Ranges* removed) {
+  Remove(Range(size, UINT32_MAX), removed);
+  Ranges inverted;
+  uint32_t gap = 0;
+  for (const Range& r : ranges_) {
+    if (r.start > gap)
+      inverted.emplace_back(gap, r.start);
+    gap = r.end;
+  }
+  if (gap < size)
+    inverted.emplace_back(gap, size);
+  if (added)
+    added->insert(added->end(), inverted.begin(), inverted.end());
+  Clear(removed);
+  ranges_.swap(inverted);
+}
+
+void RangeSet::InsertAt(uint32_t index, uint32_t count) {
+  auto it = UpperBound(index);
+  if (it == ranges_.end())
+    return;
+  // Split the range containing |index|.
+  if (it->start < index) {
+    Range right(index, it->end);
+    it->end = index;
+    it = ranges_.insert(it + 1, right);
+  }
+  for (; it != ranges_.end(); ++it) {
+    it->start += count;
+    it->end += count;
+  }
+}
+
+bool RangeSet::RemoveAt(uint32_t index) {
+  auto it = UpperBound(index);
+  if (it == ranges_.end())
+    return false;
+  bool contained = it->start <= index;
+  if (contained) {
+    it->end--;
+    if (it->empty())
+      it = ranges_.erase(it);
+    else
+      ++it;
+  }
+  for (auto next = it; next != ranges_.end(); ++next) {
+    next->start--;
+    next->end--;
+  }
+  // Removing a gap of one item joins two ranges.
+  if (!contained && it != ranges_.begin() && it != ranges_.end() &&
+      (it - 1)->end == it->start) {
+    (it - 1)->end = it->end;
+    ranges_.erase(it);
+  }
+  return contained;
+}
+
+bool RangeSet::Contains(uint32_t index) const {
+  auto it = std::upper_bound(
+      ranges_.begin(), ranges_.end(), index,
+      [](uint32_t index, const Range& r) { return index < r.end; });
+  return it != ranges_.end() && it->start <= index;
+}
+
+uint32_t RangeSet::Size() const {
+  uint32_t size = 0;
+  for (const Range& r : ranges_)
+    size += r.length();
+  return size;
+}
+
+RangeSet::Ranges::iterator RangeSet::UpperBound(uint32_t index) {
+  return std::upper_bound(
+      ranges_.begin(), ranges_.end(), index,
+      [](uint32_t index, const Range& r) { return index < r.end; });
+}
+
+}  // namespace nu
@@ -0,0 +1,77 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_RANGE_SET_H_
+#define NATIVEUI_UTIL_RANGE_SET_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Half-open range of indices, [start, end).
+struct NATIVEUI_EXPORT Range {
+  Range() = default;
+  Range(uint32_t start, uint32_t end) : start(start), end(end) {}
+
+  uint32_t length() const { return end - start; }
+  bool empty() const { return start >= end; }
+
+  bool operator==(const Range& other) const {
+    return start == other.start && end == other.end;
+  }
+
+  uint32_t start = 0;
+  uint32_t end = 0;
+};
+
+// A set of indices stored as sorted, disjoint and non-adjacent ranges, so
+// selecting millions of consecutive items only takes one range.
+//
+// The modifications report the changed parts in |added| and |removed|, which
+// can be null when the caller is not interested.
+class NATIVEUI_EXPORT RangeSet {
+ public:
+  using Ranges = std::vector<Range>;
+
+  RangeSet();
+  ~RangeSet();
+
+  void Add(const Range& range, Ranges* added = nullptr);
+  void Remove(const Range& range, Ranges* removed = nullptr);
+  void Toggle(const Range& range, Ranges* added, Ranges* removed);
+  void Clear(Ranges* removed = nullptr);
+
+  // Replace the set with the indices in [0, size) that are not in the set.
+  void Invert(uint32_t size, Ranges* added, Ranges* removed);
+
+  // Move the indices after |index| to make room for |count| new items, the
+  // new items are not in the set.
+  void InsertAt(uint32_t index, uint32_t count = 1);
+
+  // Remove the item at |index| and move the indices after it, return whether
+  // the item was in the set.
+  bool RemoveAt(uint32_t index);
+
+  bool Contains(uint32_t index) const;
+
+  // Return the number of indices in the set.
+  uint32_t Size() const;
+
+  const Ranges& ranges() const { return ranges_; }
+  bool empty() const { return ranges_.empty(); }
+
+ private:
+  // Return the first range that ends after |index|.
+  Ranges::iterator UpperBound(uint32_t index);
+
+  Ranges ranges_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_RANGE_SET_H_
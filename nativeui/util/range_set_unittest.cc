@@ -0,0 +1,66 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/range_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using Ranges = nu::RangeSet::Ranges;
+
+TEST(RangeSetTest, AddMergesRanges) {
+  nu::RangeSet set;
+  Ranges added;
+  set.Add(nu::Range(0, 10), &added);
+  set.Add(nu::Range(20, 30), &added);
+  EXPECT_EQ(added, Ranges({{0, 10}, {20, 30}}));
+  added.clear();
+  set.Add(nu::Range(5, 25), &added);
+  EXPECT_EQ(added, Ranges({{10, 20}}));
+  EXPECT_EQ(set.ranges(), Ranges({{0, 30}}));
+  // Adjacent ranges are merged too.
+  set.Add(nu::Range(30, 31));
+  EXPECT_EQ(set.ranges(), Ranges({{0, 31}}));
+  EXPECT_EQ(set.Size(), 31u);
+}
+
+TEST(RangeSetTest, RemoveSplitsRanges) {
+  nu::RangeSet set;
+  set.Add(nu::Range(0, 1000000));
+  Ranges removed;
+  set.Remove(nu::Range(10, 20), &removed);
+  EXPECT_EQ(removed, Ranges({{10, 20}}));
+  EXPECT_EQ(set.ranges(), Ranges({{0, 10}, {20, 1000000}}));
+  EXPECT_TRUE(set.Contains(9));
+  EXPECT_FALSE(set.Contains(10));
+  EXPECT_TRUE(set.Contains(20));
+  EXPECT_FALSE(set.Contains(1000000));
+}
+
+TEST(RangeSetTest, ToggleAndInvert) {
+  nu::RangeSet set;
+  set.Add(nu::Range(0, 10));
+  Ranges added, removed;
+  set.Toggle(nu::Range(5, 15), &added, &removed);
+  EXPECT_EQ(added, Ranges({{10, 15}}));
+  EXPECT_EQ(removed, Ranges({{5, 10}}));
+  EXPECT_EQ(set.ranges(), Ranges({{0, 5}, {10, 15}}));
+  added.clear();
+  removed.clear();
+  set.Invert(20, &added, &removed);
+  EXPECT_EQ(added, Ranges({{5, 10}, {15, 20}}));
+  EXPECT_EQ(removed, Ranges({{0, 5}, {10, 15}}));
+}
+
+TEST(RangeSetTest, InsertAndRemoveItems) {
+  nu::RangeSet set;
+  set.Add(nu::Range(0, 5));
+  set.Add(nu::Range(6, 10));
+  // Inserted items are not selected.
+  set.InsertAt(2, 3);
+  EXPECT_EQ(set.ranges(), Ranges({{0, 2}, {5, 8}, {9, 13}}));
+  EXPECT_TRUE(set.RemoveAt(0));
+  EXPECT_EQ(set.ranges(), Ranges({{0, 1}, {4, 7}, {8, 12}}));
+  // Removing the gap between ranges joins them.
+  EXPECT_FALSE(set.RemoveAt(7));
+  EXPECT_EQ(set.ranges(), Ranges({{0, 1}, {4, 11}}));
+}
@@ -0,0 +1,89 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/skyline_packer.h"
+
+#include <algorithm>
+
+namespace nu {
+
+SkylinePacker::SkylinePacker(const Size& size) : size_(size) {
+  Reset();
+}
+
+SkylinePacker::~SkylinePacker() {}
+
+bool SkylinePacker::Pack(const Size& size, Rect* rect) {
+  if (size.IsEmpty())
+    return false;
+  // Find the place where the rectangle's bottom is lowest, the leftmost one
+  // wins on ties.
+  size_t best_index = 0;
+  int best_y = -1;
+  for (size_t i = 0; i < skyline_.size(); ++i) {
+    int y = Fit(i, size);
+    if (y >= 0 && (best_y < 0 || y < best_y)) {
+      best_index = i;
+      best_y = y;
+    }
+  }
+  if (best_y < 0)
+    return false;
+  *rect = Rect(skyline_[best_index].x, best_y, size.width(), size.height());
+  AddRect(best_index, *rect);
+  return true;
+}
+
+void SkylinePacker::Reset() {
+  skyline_.clear();
+  if (!size_.IsEmpty())
+    skyline_.push_back({0, 0, size_.width()});
+}
+
+int SkylinePacker::Fit(size_t index, const Size& size) const {
+  int x = skyline_[index].x;
+  if (x + size.width() > size_.width())
+    return -1;
+  // The segments cover the whole width, so the loop ends before running out
+  // of segments.
+  int y = 0;
+  int remaining = size.width();
+  for (size_t i = index; remaining > 0; ++i) {
+    y = std::max(y, skyline_[i].y);
+    if (y + size.height() > size_.height())
+      return -1;
+    remaining -= skyline_[i].width;
+  }
+  return y;
+}
+
+void SkylinePacker::AddRect(size_t index, const Rect& rect) {
+  skyline_.insert(skyline_.begin() + index,
+                  {rect.x(), rect.bottom(), rect.width()});
+  // Shrink or remove the segments covered by the new one.
+  size_t i = index + 1;
+  while (i < skyline_.size()) {
+    int overlap = skyline_[i - 1].x + skyline_[i - 1].width - skyline_[i].x;
+    if (overlap <= 0)
+      break;
+    if (overlap < skyline_[i].width) {
+      skyline_[i].x += overlap;
+      skyline_[i].width -= overlap;
+      break;
+    }
+    skyline_.erase(skyline_.begin() + i);
+  }
+  // Merge neighbors of the same height.
+  i = 0;
+  while (i + 1 < skyline_.size()) {
+    if (skyline_[i].y == skyline_[i + 1].y) {
+      skyline_[i].width += skyline_[i + 1].width;
+      skyline_.erase(skyline_.begin() + i + 1);
+    } else {
+      ++i;
+    }
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,53 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_SKYLINE_PACKER_H_
+#define NATIVEUI_UTIL_SKYLINE_PACKER_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "nativeui/gfx/geometry/rect.h"
+
+namespace nu {
+
+// Packs rectangles into a fixed area with the skyline bottom-left algorithm:
+// the top edges of packed rectangles are kept as a list of horizontal
+// segments, and each new rectangle is put at the place with lowest top.
+class NATIVEUI_EXPORT SkylinePacker {
+ public:
+  explicit SkylinePacker(const Size& size);
+  ~SkylinePacker();
+
+  // Find a place for rectangle of |size|, return false if there is no space.
+  bool Pack(const Size& size, Rect* rect);
+
+  // Forget all the packed rectangles.
+  void Reset();
+
+  const Size& size() const { return size_; }
+
+ private:
+  struct Segment {
+    int x;
+    int y;
+    int width;
+  };
+
+  // Return the top of rectangle of |size| placed at the start of the segment
+  // at |index|, or -1 if it does not fit.
+  int Fit(size_t index, const Size& size) const;
+
+  // Raise the skyline under the |rect| placed at the segment at |index|.
+  void AddRect(size_t index, const Rect& rect);
+
+  Size size_;
+  std::vector<Segment> skyline_;
+
+  DISALLOW_COPY_AND_ASSIGN(SkylinePacker);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_SKYLINE_PACKER_H_
@@ -0,0 +1,48 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/skyline_packer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(SkylinePackerTest, PackInRows) {
+  nu::SkylinePacker packer(nu::Size(10, 10));
+  nu::Rect rect;
+  ASSERT_TRUE(packer.Pack(nu::Size(4, 2), &rect));
+  EXPECT_EQ(rect, nu::Rect(0, 0, 4, 2));
+  ASSERT_TRUE(packer.Pack(nu::Size(4, 3), &rect));
+  EXPECT_EQ(rect, nu::Rect(4, 0, 4, 3));
+  // Does not fit in the remaining width of first row.
+  ASSERT_TRUE(packer.Pack(nu::Size(3, 1), &rect));
+  EXPECT_EQ(rect, nu::Rect(0, 2, 3, 1));
+  // The lowest place is preferred.
+  ASSERT_TRUE(packer.Pack(nu::Size(2, 2), &rect));
+  EXPECT_EQ(rect, nu::Rect(8, 0, 2, 2));
+}
+
+TEST(SkylinePackerTest, SpanSegments) {
+  nu::SkylinePacker packer(nu::Size(10, 10));
+  nu::Rect rect;
+  ASSERT_TRUE(packer.Pack(nu::Size(3, 1), &rect));
+  ASSERT_TRUE(packer.Pack(nu::Size(3, 4), &rect));
+  ASSERT_TRUE(packer.Pack(nu::Size(4, 2), &rect));
+  // Placed on top of the highest segment under it.
+  ASSERT_TRUE(packer.Pack(nu::Size(10, 1), &rect));
+  EXPECT_EQ(rect, nu::Rect(0, 4, 10, 1));
+  ASSERT_TRUE(packer.Pack(nu::Size(1, 1), &rect));
+  EXPECT_EQ(rect, nu::Rect(0, 5, 1, 1));
+}
+
+TEST(SkylinePackerTest, Full) {
+  nu::SkylinePacker packer(nu::Size(4, 4));
+  nu::Rect rect;
+  EXPECT_FALSE(packer.Pack(nu::Size(5, 1), &rect));
+  EXPECT_FALSE(packer.Pack(nu::Size(1, 5), &rect));
+  EXPECT_FALSE(packer.Pack(nu::Size(), &rect));
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(packer.Pack(nu::Size(2, 2), &rect));
+  }
+  EXPECT_FALSE(packer.Pack(nu::Size(1, 1), &rect));
+  packer.Reset();
+  EXPECT_TRUE(packer.Pack(nu::Size(4, 4), &rect));
+}
@@ -27,6 +27,9 @@ std::string ParseName(const std::string& name) {
   return parsed;
 }
 
+// Rough size of a yoga node with its config, which are opaque types.
+const int64_t kYogaNodeSize = 1024;
+
 }  // namespace
 
 // static
@@ -37,6 +40,8 @@ View::View() : view_(nullptr) {
   yoga_config_ = YGConfigNew();
   YGConfigCopy(yoga_config_, State::GetCurrent()->yoga_config());
   node_ = YGNodeNewWithConfig(yoga_config_);
+  if (is_memory_tracked())
+    RecordNativeMemory("YogaNode", 1, kYogaNodeSize);
 }
 
 View::~View() {
@@ -45,12 +50,22 @@ View::~View() {
   // Free yoga config and node.
   YGNodeFree(node_);
   YGConfigFree(yoga_config_);
+  if (is_memory_tracked())
+    RecordNativeMemory("YogaNode", -1, -kYogaNodeSize);
 }
 
 const char* View::GetClassName() const {
   return kClassName;
 }
 
+const char* View::GetMemoryClassName() const {
+  return GetClassName();
+}
+
+size_t View::EstimateMemoryUsage() const {
+  return sizeof(View);
+}
+
 void View::SetVisible(bool visible) {
   if (visible == IsVisible())
     return;
@@ -5,9 +5,11 @@
 #ifndef NATIVEUI_VIEW_H_
 #define NATIVEUI_VIEW_H_
 
+#include <functional>
 #include <string>
 
 #include "base/memory/ref_counted.h"
+#include "nativeui/memory_dump.h"
 #include "nativeui/gfx/color.h"
 #include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/geometry/size_f.h"
@@ -19,13 +21,15 @@ typedef struct YGConfig *YGConfigRef;
 
 namespace nu {
 
+class Canvas;
 class Font;
 class Window;
 struct MouseEvent;
 struct KeyEvent;
 
 // The base class for all kinds of views.
-class NATIVEUI_EXPORT View : public base::RefCounted<View> {
+class NATIVEUI_EXPORT View : public base::RefCounted<View>,
+                              public MemoryTracked {
  public:
   // The view class name.
   static const char kClassName[];
@@ -84,6 +88,19 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   void ReleaseCapture();
   bool HasCapture() const;
 
+#if defined(OS_LINUX)
+  // Render the view and its children into a new canvas of |scale_factor|.
+  // The returned canvas is not referenced.
+  Canvas* CaptureToCanvas(float scale_factor);
+
+  // Capture the view after it is painted in the next frame. The callback
+  // receives null immediately if the view is not drawable, or later if the
+  // view is destroyed before the frame is painted.
+  using CaptureCallback = std::function<void(Canvas*)>;
+  void CaptureToCanvasAsync(float scale_factor,
+                            const CaptureCallback& callback);
+#endif
+
   // Dragging the view would move the window.
   void SetMouseDownCanMoveWindow(bool yes);
   bool IsMouseDownCanMoveWindow() const;
@@ -145,6 +162,10 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // Internal: Notify that view's size has changed.
   virtual void OnSizeChanged();
 
+  // MemoryTracked:
+  const char* GetMemoryClassName() const override;
+  size_t EstimateMemoryUsage() const override;
+
   // Internal: Get the CSS node of the view.
   YGNodeRef node() const { return node_; }
 
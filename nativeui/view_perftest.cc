@@ -0,0 +1,105 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_harness.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ViewPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentSize(nu::SizeF(800, 600));
+  }
+
+  // Create a tree with |rows| containers, each has |columns| labels.
+  scoped_refptr<nu::Container> CreateTree(int rows, int columns) {
+    scoped_refptr<nu::Container> root(new nu::Container);
+    for (int i = 0; i < rows; ++i) {
+      nu::Container* row = new nu::Container;
+      row->SetStyle("flex-direction", "row", "flex", 1);
+      for (int j = 0; j < columns; ++j) {
+        nu::Label* label = new nu::Label("label");
+        label->SetStyle("flex", 1);
+        row->AddChildView(label);
+      }
+      root->AddChildView(row);
+    }
+    return root;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+};
+
+TEST_F(ViewPerfTest, BuildTree) {
+  nu::RunPerfTest("View.BuildTree.1000", 1000, [&]() {
+    CreateTree(100, 10);
+  });
+}
+
+TEST_F(ViewPerfTest, LayoutTree) {
+  scoped_refptr<nu::Container> root = CreateTree(100, 10);
+  window_->SetContentView(root.get());
+  float width = 800;
+  nu::RunPerfTest("View.LayoutTree.1000", 1000, [&]() {
+    // Change the size to make sure the layout is not cached.
+    width = width == 800 ? 801 : 800;
+    window_->SetContentSize(nu::SizeF(width, 600));
+  });
+}
+
+TEST_F(ViewPerfTest, SetStyle) {
+  scoped_refptr<nu::Container> root = CreateTree(10, 10);
+  window_->SetContentView(root.get());
+  nu::View* label = static_cast<nu::Container*>(root->ChildAt(0))->ChildAt(0);
+  nu::RunPerfTest("View.SetStyle.100", 100, [&]() {
+    for (int i = 0; i < 100; ++i)
+      label->SetStyle("margin", i % 2 ? 1 : 2);
+  });
+}
+
+TEST_F(ViewPerfTest, SetStylePropertyWithoutLayout) {
+  scoped_refptr<nu::Label> label(new nu::Label("label"));
+  nu::RunPerfTest("View.SetStyleProperty.1000", 1000, [&]() {
+    for (int i = 0; i < 1000; ++i) {
+      label->SetStyleProperty("width", i % 2 ? 10.f : 20.f);
+      label->SetStyleProperty("align-items", i % 2 ? "center" : "stretch");
+    }
+  });
+}
+
+// Time spent on showing a window with a large form, which includes creating
+// the native windows of the views.
+TEST_F(ViewPerfTest, OpenLargeForm) {
+  scoped_refptr<nu::Window> window;
+  scoped_refptr<nu::Container> root;
+  nu::RunPerfTest("View.OpenLargeForm.3000", 3000, [&]() {
+    window->SetContentView(root.get());
+    window->SetVisible(true);
+  }, [&]() {
+    if (window)
+      window->Close();
+    window = new nu::Window(nu::Window::Options());
+    window->SetContentSize(nu::SizeF(800, 600));
+    root = CreateTree(300, 10);
+  });
+  window->Close();
+}
+
+TEST_F(ViewPerfTest, HitTestItems) {
+  scoped_refptr<nu::Container> container(new nu::Container);
+  for (int y = 0; y < 100; ++y) {
+    for (int x = 0; x < 100; ++x) {
+      nu::SceneItem* item = new nu::SceneItem;
+      item->SetBounds(nu::RectF(x * 10, y * 10, 8, 8));
+      container->AddItem(item);
+    }
+  }
+  nu::RunPerfTest("Container.GetItemAt.10000Items", 1000, [&]() {
+    for (int i = 0; i < 1000; ++i)
+      container->GetItemAt(nu::PointF(i % 1000, i % 997));
+  });
+}
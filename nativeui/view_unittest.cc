@@ -59,3 +59,65 @@ TEST_F(ViewTest, OnSizeChanged) {
   window->SetContentSize(nu::SizeF(100, 100));
   EXPECT_TRUE(changed);
 }
+
+#if defined(OS_LINUX)
+TEST_F(ViewTest, CaptureToCanvas) {
+  view_->SetBounds(nu::RectF(0, 0, 100, 50));
+  scoped_refptr<nu::Canvas> canvas = view_->CaptureToCanvas(2.f);
+  EXPECT_EQ(canvas->GetSize(), nu::SizeF(100, 50));
+  EXPECT_EQ(canvas->GetScaleFactor(), 2.f);
+}
+
+TEST_F(ViewTest, CaptureToCanvasAsync) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentView(view_.get());
+  window->SetContentSize(nu::SizeF(100, 50));
+  window->SetVisible(true);
+  view_->CaptureToCanvasAsync(1.f, [](nu::Canvas* canvas) {
+    ASSERT_TRUE(canvas);
+    EXPECT_EQ(canvas->GetSize(), nu::SizeF(100, 50));
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_F(ViewTest, CaptureToCanvasAsyncNotDrawable) {
+  bool called = false;
+  view_->CaptureToCanvasAsync(1.f, [&called](nu::Canvas* canvas) {
+    EXPECT_FALSE(canvas);
+    called = true;
+  });
+  EXPECT_TRUE(called);
+}
+
+TEST_F(ViewTest, CaptureToCanvasAsyncDestroyed) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentView(view_.get());
+  window->SetVisible(true);
+  view_->CaptureToCanvasAsync(1.f, [](nu::Canvas* canvas) {
+    EXPECT_FALSE(canvas);
+    nu::MessageLoop::Quit();
+  });
+  view_ = nullptr;
+  window = nullptr;
+  nu::MessageLoop::Run();
+}
+
+TEST_F(ViewTest, CaptureToCanvasAsyncRemoved) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  scoped_refptr<nu::Container> container(new nu::Container);
+  window->SetContentView(container.get());
+  container->AddChildView(view_.get());
+  window->SetVisible(true);
+  bool called = false;
+  view_->CaptureToCanvasAsync(1.f, [&called](nu::Canvas* canvas) {
+    EXPECT_FALSE(canvas);
+    called = true;
+    nu::MessageLoop::Quit();
+  });
+  // The view stays alive but is no longer in the window.
+  container->RemoveChildView(view_.get());
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(called);
+}
+#endif
@@ -186,13 +186,15 @@ class ContainerAdapter : public ContainerImpl,
   }
 
   void OnDraw(PainterWin* painter, const Rect& dirty) override {
-    if (container_->on_draw.IsEmpty())
+    if (container_->on_draw.IsEmpty() && container_->ItemCount() == 0)
       return;
     painter->Save();
     painter->ClipRectPixel(Rect(size_allocation().size()));
     float scale_factor = container_->GetNative()->scale_factor();
+    RectF dirty_dip = ScaleRect(RectF(dirty), 1.0f / scale_factor);
     container_->on_draw.Emit(container_, static_cast<Painter*>(painter),
-                             ScaleRect(RectF(dirty), 1.0f / scale_factor));
+                             dirty_dip);
+    container_->DrawItems(static_cast<Painter*>(painter), dirty_dip);
     painter->Restore();
   }
 
@@ -25,7 +25,24 @@ void DispatchCommandToItem(MenuBase* menu, int command) {
   }
 }
 
+void DispatchWillOpenToMenu(HMENU hmenu) {
+  MENUINFO mi = {0};
+  mi.cbSize = sizeof(mi);
+  mi.fMask = MIM_MENUDATA;
+  if (!GetMenuInfo(hmenu, &mi) || !mi.dwMenuData)
+    return;
+  MenuBase* menu = reinterpret_cast<MenuBase*>(mi.dwMenuData);
+  menu->on_will_open.Emit(menu);
+}
+
 void MenuBase::PlatformInit() {
+  // Store the pointer in menu so we can find the MenuBase from HMENU when
+  // receiving WM_INITMENUPOPUP.
+  MENUINFO mi = {0};
+  mi.cbSize = sizeof(mi);
+  mi.fMask = MIM_MENUDATA;
+  mi.dwMenuData = reinterpret_cast<ULONG_PTR>(this);
+  SetMenuInfo(menu_, &mi);
 }
 
 void MenuBase::PlatformDestroy() {
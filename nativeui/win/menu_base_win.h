@@ -13,6 +13,9 @@ namespace nu {
 // the click event for it.
 void DispatchCommandToItem(nu::MenuBase* menu, int command);
 
+// Find the MenuBase that owns |hmenu| and emit the on_will_open event for it.
+void DispatchWillOpenToMenu(HMENU hmenu);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_WIN_MENU_BASE_WIN_H_
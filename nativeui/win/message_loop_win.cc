@@ -46,6 +46,12 @@ UINT_PTR MessageLoop::SetTimeout(int ms, const Task& task) {
   return event;
 }
 
+// static
+UINT_PTR MessageLoop::SetIdleTimeout(const Task& task) {
+  // WM_TIMER is only generated when the message queue is empty.
+  return SetTimeout(USER_TIMER_MINIMUM, task);
+}
+
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
   ::KillTimer(NULL, id);
@@ -153,6 +153,7 @@ class TabImpl : public ContainerImpl,
     selected_item_->SetSelected(true);
     tab->PageAt(selected_item_index_)->SetVisible(true);
     Layout();
+    tab->OnPageSelected(selected_item_index_);
     tab->on_selected_page_change.Emit(tab);
   }
 
@@ -303,6 +304,10 @@ void Tab::PlatformRemovePage(int index, View* view) {
   tab->RemovePageAt(index);
 }
 
+void Tab::PlatformUnloadPage(View* view) {
+  // Views are windowless, there are no native resources to release.
+}
+
 void Tab::SelectPageAt(int index) {
   auto* tab = static_cast<TabImpl*>(GetNative());
   tab->SelectItemAt(index);
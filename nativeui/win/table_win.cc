@@ -196,7 +196,8 @@ LRESULT TableImpl::OnCustomDraw(NMLVCUSTOMDRAW* nm, int row) {
   // Draw custom type cells.
   for (int i = 0; i < GetColumnCount(); ++i) {
     const auto& options = columns_[i];
-    if (options.type != Table::ColumnType::Custom || !options.on_draw)
+    if (options.type != Table::ColumnType::Custom ||
+        !options.HasDrawHandler())
       continue;
     const base::Value* value = model->GetValue(options.column, row);
     // Calculate the rect of each cell.
@@ -210,9 +211,9 @@ LRESULT TableImpl::OnCustomDraw(NMLVCUSTOMDRAW* nm, int row) {
     PainterWin painter(nm->nmcd.hdc, scale_factor());
     painter.TranslatePixel(rect.OffsetFromOrigin());
     painter.ClipRectPixel(Rect(rect.size()));
-    options.on_draw(&painter,
-                    RectF(ScaleSize(SizeF(rect.size()), 1.f / scale_factor())),
-                    value ? value->Clone() : base::Value());
+    options.Draw(&painter,
+                 RectF(ScaleSize(SizeF(rect.size()), 1.f / scale_factor())),
+                 TableCell::FromValue(value));
   }
   return CDRF_SKIPDEFAULT;
 }
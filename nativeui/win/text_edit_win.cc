@@ -89,6 +89,12 @@ void TextEdit::SetText(const std::string& text) {
   static_cast<EditView*>(GetNative())->SetText(text);
 }
 
+size_t TextEdit::EstimateMemoryUsage() const {
+  // The text buffer is usually much larger than the view itself.
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  return sizeof(TextEdit) + ::GetWindowTextLengthW(hwnd) * sizeof(wchar_t);
+}
+
 std::string TextEdit::GetText() const {
   return static_cast<EditView*>(GetNative())->GetText();
 }
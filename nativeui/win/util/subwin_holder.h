@@ -21,6 +21,7 @@ class SubwinHolder : public Win32Window {
   CR_BEGIN_MSG_MAP_EX(SubwinHolder, Win32Window)
     CR_MSG_WM_COMMAND(OnCommand)
     CR_MSG_WM_NOTIFY(OnNotify)
+    CR_MSG_WM_INITMENUPOPUP(OnInitMenuPopup)
     CR_MSG_WM_CTLCOLOREDIT(OnCtlColorStatic)
     CR_MSG_WM_CTLCOLORSTATIC(OnCtlColorStatic)
     CR_MSG_WM_HSCROLL(OnHScroll)
@@ -31,6 +32,9 @@ class SubwinHolder : public Win32Window {
   // We need to redirect the messages just like the toplevel window.
   void OnCommand(UINT code, int command, HWND window);
   LRESULT OnNotify(int id, LPNMHDR pnmh);
+
+  // Popup menus use this window as owner.
+  void OnInitMenuPopup(HMENU menu, UINT index, BOOL is_system_menu);
   HBRUSH OnCtlColorStatic(HDC dc, HWND window);
   void OnHScroll(UINT code, UINT pos, HWND window);
 };
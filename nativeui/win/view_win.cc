@@ -4,6 +4,7 @@
 
 #include "nativeui/win/view_win.h"
 
+#include "nativeui/container.h"
 #include "nativeui/events/event.h"
 #include "nativeui/events/win/event_win.h"
 #include "nativeui/gfx/geometry/rect_conversions.h"
@@ -14,6 +15,16 @@
 
 namespace nu {
 
+namespace {
+
+// Give the lightweight items of |view| a chance to handle the |event|.
+bool DispatchMouseEventToItems(View* view, const MouseEvent& event) {
+  return view->IsContainer() &&
+         static_cast<Container*>(view)->DispatchMouseEventToItems(event);
+}
+
+}  // namespace
+
 ViewImpl::ViewImpl(ControlType type, View* delegate)
     : type_(type),
       font_(App::GetCurrent()->GetDefaultFont()),
@@ -139,24 +150,30 @@ void ViewImpl::Draw(PainterWin* painter, const Rect& dirty) {
 }
 
 void ViewImpl::OnMouseMove(NativeEvent event) {
-  if (!delegate() || delegate()->on_mouse_move.IsEmpty())
+  if (!delegate())
     return;
   event->w_param = 0;
-  delegate()->on_mouse_move.Emit(delegate(), MouseEvent(event, this));
+  MouseEvent client_event(event, this);
+  DispatchMouseEventToItems(delegate(), client_event);
+  delegate()->on_mouse_move.Emit(delegate(), client_event);
 }
 
 void ViewImpl::OnMouseEnter(NativeEvent event) {
-  if (!delegate() || delegate()->on_mouse_enter.IsEmpty())
+  if (!delegate())
     return;
   event->w_param = 1;
-  delegate()->on_mouse_enter.Emit(delegate(), MouseEvent(event, this));
+  MouseEvent client_event(event, this);
+  DispatchMouseEventToItems(delegate(), client_event);
+  delegate()->on_mouse_enter.Emit(delegate(), client_event);
 }
 
 void ViewImpl::OnMouseLeave(NativeEvent event) {
-  if (!delegate() || delegate()->on_mouse_leave.IsEmpty())
+  if (!delegate())
     return;
   event->w_param = 2;
-  delegate()->on_mouse_leave.Emit(delegate(), MouseEvent(event, this));
+  MouseEvent client_event(event, this);
+  DispatchMouseEventToItems(delegate(), client_event);
+  delegate()->on_mouse_leave.Emit(delegate(), client_event);
 }
 
 bool ViewImpl::OnMouseClick(NativeEvent event) {
@@ -176,6 +193,8 @@ bool ViewImpl::OnMouseClick(NativeEvent event) {
   if (!delegate())
     return false;
   MouseEvent client_event(event, this);
+  if (DispatchMouseEventToItems(delegate(), client_event))
+    return true;
   if (client_event.type == EventType::MouseDown &&
       delegate()->on_mouse_down.Emit(delegate(), client_event))
     return true;
@@ -248,6 +248,14 @@ LRESULT WindowImpl::OnNotify(int id, LPNMHDR pnmh) {
   return control->OnNotify(id, pnmh);
 }
 
+void WindowImpl::OnInitMenuPopup(HMENU menu, UINT index, BOOL is_system_menu) {
+  if (is_system_menu) {
+    SetMsgHandled(false);
+    return;
+  }
+  DispatchWillOpenToMenu(menu);
+}
+
 void WindowImpl::OnSize(UINT param, const Size& size) {
   if (!delegate_->GetContentView())
     return;
@@ -255,6 +263,11 @@ void WindowImpl::OnSize(UINT param, const Size& size) {
   RedrawWindow(hwnd(), NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
 }
 
+void WindowImpl::OnExitSizeMove() {
+  delegate_->on_resize_end.Emit(delegate_);
+  SetMsgHandled(false);
+}
+
 void WindowImpl::OnFocus(HWND old) {
   delegate_->on_focus.Emit(delegate_);
   SetMsgHandled(false);
@@ -56,7 +56,9 @@ class WindowImpl : public Win32Window {
     CR_MSG_WM_CLOSE(OnClose)
     CR_MSG_WM_COMMAND(OnCommand)
     CR_MSG_WM_NOTIFY(OnNotify)
+    CR_MSG_WM_INITMENUPOPUP(OnInitMenuPopup)
     CR_MSG_WM_SIZE(OnSize)
+    CR_MSG_WM_EXITSIZEMOVE(OnExitSizeMove)
     CR_MSG_WM_SETFOCUS(OnFocus)
     CR_MSG_WM_KILLFOCUS(OnBlur)
     CR_MESSAGE_HANDLER_EX(WM_DPICHANGED, OnDPIChanged)
@@ -88,7 +90,9 @@ class WindowImpl : public Win32Window {
   void OnClose();
   void OnCommand(UINT code, int command, HWND window);
   LRESULT OnNotify(int id, LPNMHDR pnmh);
+  void OnInitMenuPopup(HMENU menu, UINT index, BOOL is_system_menu);
   void OnSize(UINT param, const Size& size);
+  void OnExitSizeMove();
   void OnFocus(HWND old);
   void OnBlur(HWND old);
   LRESULT OnDPIChanged(UINT msg, WPARAM w_param, LPARAM l_param);
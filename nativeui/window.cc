@@ -14,6 +14,14 @@
 
 namespace nu {
 
+#if defined(OS_LINUX)
+Window::FrameStats::FrameStats() = default;
+
+Window::FrameStats::FrameStats(const FrameStats& other) = default;
+
+Window::FrameStats::~FrameStats() = default;
+#endif
+
 Window::Window(const Options& options)
     : has_frame_(options.frame),
       transparent_(options.transparent),
@@ -47,6 +47,33 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
 #endif
   };
 
+#if defined(OS_LINUX)
+  // Frame timings collected by the window, durations are in milliseconds.
+  struct FrameStats {
+    FrameStats();
+    FrameStats(const FrameStats& other);
+    ~FrameStats();
+
+    // Number of frames painted.
+    int frame_count = 0;
+    // Number of display refreshes that were missed between frames.
+    int dropped_frames = 0;
+    // Average frames per second.
+    float fps = 0;
+    // The N-th element counts the frames that took N+1 refresh intervals.
+    std::vector<int> frame_interval_histogram;
+    float average_paint_duration = 0;
+    float max_paint_duration = 0;
+    float average_layout_duration = 0;
+    float max_layout_duration = 0;
+    // The slowest on_draw handler in recent frames, the view is identified by
+    // its class name and bounds in window so it is not kept alive.
+    std::string slowest_draw_class_name;
+    RectF slowest_draw_bounds;
+    float slowest_draw_duration = 0;
+  };
+#endif
+
   explicit Window(const Options& options);
 
   void Close();
@@ -113,6 +140,28 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   MenuBar* GetMenuBar() const { return menu_bar_.get(); }
 #endif
 
+#if defined(OS_LINUX)
+  // Coalesce the layout of content view to at most once per frame when the
+  // window is being resized.
+  void SetResizeThrottled(bool throttled);
+  bool IsResizeThrottled() const;
+  // Return how many layout passes have been skipped by the throttling.
+  int GetSkippedLayoutCount() const;
+
+  // Collect frame timings of the window.
+  void SetFrameStatsEnabled(bool enabled);
+  bool IsFrameStatsEnabled() const;
+  FrameStats GetFrameStats() const;
+  void ResetFrameStats();
+  // Draw the frame stats on top of the window content.
+  void SetFrameStatsOverlayVisible(bool visible);
+  bool IsFrameStatsOverlayVisible() const;
+
+  // Internal: Called when the size of content view is changed, return true if
+  // the layout should be deferred to next frame.
+  bool ShouldDeferContentLayout();
+#endif
+
   Window* GetParentWindow() const { return parent_; }
   void AddChildWindow(Window* child);
   void RemoveChildWindow(Window* child);
@@ -131,6 +180,7 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   Signal<void(Window*)> on_close;
   Signal<void(Window*)> on_focus;
   Signal<void(Window*)> on_blur;
+  Signal<void(Window*)> on_resize_end;
 
   // Delegate methods.
   std::function<bool(Window*)> should_close;
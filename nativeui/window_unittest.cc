@@ -129,6 +129,22 @@ TEST_F(WindowTest, TransparentWindowResizable) {
   EXPECT_EQ(window_->GetContentSize(), size);
 }
 
+TEST_F(WindowTest, OnResizeEndNotEmittedForProgrammaticResize) {
+  window_->SetVisible(true);
+  bool resize_ended = false;
+  window_->on_resize_end.Connect([&resize_ended](nu::Window*) {
+    resize_ended = true;
+  });
+  window_->SetContentSize(nu::SizeF(200, 300));
+  window_->SetBounds(nu::RectF(10, 10, 300, 200));
+  // Wait longer than the delay used for detecting the end of resizing.
+  nu::MessageLoop::PostDelayedTask(500, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(resize_ended);
+}
+
 TEST_F(WindowTest, ChildWindow) {
   EXPECT_TRUE(window_->GetChildWindows().empty());
   scoped_refptr<nu::Window> child = new nu::Window(nu::Window::Options());
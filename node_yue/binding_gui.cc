@@ -20,6 +20,101 @@ namespace {
 bool is_electron = false;
 bool is_yode = false;
 
+// Fast versions of the hot methods, which receive the native object and only
+// primitive arguments, see vb::FastMethod. They are called by V8 without
+// entering JavaScript context, and must not call into JavaScript or allocate
+// JavaScript objects.
+namespace fast {
+
+template<typename T, void (T::*method)()>
+struct Call {
+  static void Run(T* self) {
+    (self->*method)();
+  }
+};
+
+template<typename T, bool (T::*method)() const>
+struct Get {
+  static bool Run(T* self) {
+    return (self->*method)();
+  }
+};
+
+template<typename T, void (T::*method)(bool)>
+struct Set {
+  static void Run(T* self, bool value) {
+    (self->*method)(value);
+  }
+};
+
+template<void (nu::Painter::*method)(const nu::PointF&)>
+struct CallWithPoint {
+  static void Run(nu::Painter* painter, double x, double y) {
+    (painter->*method)(nu::PointF(x, y));
+  }
+};
+
+template<void (nu::Painter::*method)(const nu::Vector2dF&)>
+struct CallWithVector {
+  static void Run(nu::Painter* painter, double x, double y) {
+    (painter->*method)(nu::Vector2dF(x, y));
+  }
+};
+
+template<void (nu::Painter::*method)(const nu::RectF&)>
+struct CallWithRect {
+  static void Run(nu::Painter* painter,
+                  double x, double y, double width, double height) {
+    (painter->*method)(nu::RectF(x, y, width, height));
+  }
+};
+
+template<void (nu::Painter::*method)(nu::Color)>
+struct CallWithColor {
+  static void Run(nu::Painter* painter, uint32_t color) {
+    (painter->*method)(nu::Color(color));
+  }
+};
+
+struct BezierCurveTo {
+  static void Run(nu::Painter* painter,
+                  double cp1x, double cp1y, double cp2x, double cp2y,
+                  double x, double y) {
+    painter->BezierCurveTo(nu::PointF(cp1x, cp1y), nu::PointF(cp2x, cp2y),
+                           nu::PointF(x, y));
+  }
+};
+
+struct Arc {
+  static void Run(nu::Painter* painter,
+                  double x, double y, double radius, double sa, double ea) {
+    painter->Arc(nu::PointF(x, y), radius, sa, ea);
+  }
+};
+
+struct Rotate {
+  static void Run(nu::Painter* painter, double angle) {
+    painter->Rotate(angle);
+  }
+};
+
+struct SetLineWidth {
+  static void Run(nu::Painter* painter, double width) {
+    painter->SetLineWidth(width);
+  }
+};
+
+}  // namespace fast
+
+// Return the memory of |buffer|.
+char* GetArrayBufferData(v8::Local<v8::ArrayBuffer> buffer) {
+#if V8_MAJOR_VERSION >= 8
+  return static_cast<char*>(buffer->GetBackingStore()->Data());
+#else
+  return static_cast<char*>(buffer->GetContents().Data());
+#endif
+}
+
 }  // namespace
 
 namespace vb {
@@ -250,6 +345,9 @@ struct Type<nu::App> {
         RefMethod(&nu::App::SetApplicationMenu, RefType::Reset, "appMenu"),
         "setDockBadgeLabel", &nu::App::SetDockBadgeLabel,
         "getDockBadgeLabel", &nu::App::GetDockBadgeLabel,
+#endif
+#if defined(OS_LINUX)
+        "warmupFonts", &nu::App::WarmupFonts,
 #endif
         "getColor", &nu::App::GetColor,
         "getDefaultFont", &nu::App::GetDefaultFont);
@@ -438,7 +536,9 @@ struct Type<nu::Image> {
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
         "createFromPath", &CreateOnHeap<nu::Image, const base::FilePath&>,
-        "createFromBuffer", &CreateOnHeap<nu::Image, const nu::Buffer&, float>);
+        "createFromBuffer", &CreateOnHeap<nu::Image, const nu::Buffer&, float>,
+        "createFromAsar", &nu::Image::CreateFromAsar,
+        "createFromEncryptedAsar", &nu::Image::CreateFromEncryptedAsar);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
@@ -448,6 +548,59 @@ struct Type<nu::Image> {
   }
 };
 
+template<>
+struct Type<nu::ImageSet> {
+  static constexpr const char* name = "yue.ImageSet";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::ImageSet>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "addFile", &nu::ImageSet::AddFile,
+        "addAsarEntry", &nu::ImageSet::AddAsarEntry,
+        "getImageForScale", &nu::ImageSet::GetImageForScale,
+        "getImage", &nu::ImageSet::GetImage,
+        "getSize", &nu::ImageSet::GetSize,
+        "getScaleFactors", &nu::ImageSet::GetScaleFactors);
+  }
+};
+
+template<>
+struct Type<nu::ImageAtlas> {
+  static constexpr const char* name = "yue.ImageAtlas";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::ImageAtlas, const nu::SizeF&, float>,
+        "createForMainScreen", &CreateOnHeap<nu::ImageAtlas, const nu::SizeF&>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "addImage", &nu::ImageAtlas::AddImage,
+        "getCanvas", &nu::ImageAtlas::GetCanvas,
+        "getSize", &nu::ImageAtlas::GetSize,
+        "getScaleFactor", &nu::ImageAtlas::GetScaleFactor);
+  }
+};
+
+template<>
+struct Type<nu::AtlasImage> {
+  static constexpr const char* name = "yue.AtlasImage";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "getAtlas", &nu::AtlasImage::GetAtlas,
+        "getRect", &nu::AtlasImage::GetRect,
+        "getSize", &nu::AtlasImage::GetSize);
+  }
+};
+
 template<>
 struct Type<nu::TextAlign> {
   static constexpr const char* name = "yue.TextAlign";
@@ -499,42 +652,223 @@ struct Type<nu::TextMetrics> {
   }
 };
 
+template<>
+struct Type<nu::AttributedText> {
+  static constexpr const char* name = "yue.AttributedText";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &Create);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setText", &nu::AttributedText::SetText,
+        "getText", &nu::AttributedText::GetText,
+        "setFont", &nu::AttributedText::SetFont,
+        "setColor", &nu::AttributedText::SetColor,
+        "setAlign", &nu::AttributedText::SetAlign,
+        "setValign", &nu::AttributedText::SetValign,
+        "setFontFor", &SetFontFor,
+        "setColorFor", &SetColorFor,
+        "clearStyles", &nu::AttributedText::ClearStyles,
+        "setWrapWidth", &nu::AttributedText::SetWrapWidth,
+        "getWrapWidth", &nu::AttributedText::GetWrapWidth,
+        "getMetrics", &nu::AttributedText::GetMetrics);
+  }
+  static nu::AttributedText* Create(Arguments* args, const std::string& text) {
+    nu::TextAttributes attributes;
+    args->GetNext(&attributes);
+    return new nu::AttributedText(text, attributes);
+  }
+  // The ranges are UTF-16 code units, like the indices of JavaScript strings.
+  static void SetFontFor(nu::AttributedText* text, nu::Font* font,
+                         int start, int end) {
+    const std::string& str = text->GetText();
+    text->SetFontFor(font, ToUTF8Offset(str, start), ToUTF8Offset(str, end));
+  }
+  static void SetColorFor(nu::AttributedText* text, nu::Color color,
+                          int start, int end) {
+    const std::string& str = text->GetText();
+    text->SetColorFor(color, ToUTF8Offset(str, start), ToUTF8Offset(str, end));
+  }
+  // Convert the |offset| in UTF-16 code units of |str| to byte offset.
+  static int ToUTF8Offset(const std::string& str, int offset) {
+    size_t i = 0;
+    for (int units = 0; i < str.size() && units < offset; ++units) {
+      unsigned char c = static_cast<unsigned char>(str[i]);
+      if (c >= 0xF0) {
+        // Characters out of BMP are surrogate pairs in UTF-16, an offset
+        // in the middle of a pair is moved to after the character.
+        i += 4;
+        ++units;
+      } else if (c >= 0xE0) {
+        i += 3;
+      } else if (c >= 0xC0) {
+        i += 2;
+      } else {
+        i += 1;
+      }
+    }
+    return static_cast<int>(std::min(i, str.size()));
+  }
+};
+
+template<>
+struct Type<nu::TextRun> {
+  static constexpr const char* name = "yue.TextRun";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::TextRun* out) {
+    if (!value->IsObject())
+      return false;
+    v8::Local<v8::Object> obj = value.As<v8::Object>();
+    nu::AttributedText* text;
+    if (!Get(context, obj, "text", &text) ||
+        !Get(context, obj, "rect", &out->rect))
+      return false;
+    out->text = text;
+    return true;
+  }
+};
+
+template<>
+struct Type<nu::PainterCommand> {
+  static constexpr const char* name = "yue.PainterCommand";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   nu::PainterCommand command) {
+    return vb::ToV8(context, static_cast<int>(command));
+  }
+};
+
 template<>
 struct Type<nu::Painter> {
   static constexpr const char* name = "yue.Painter";
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
+    auto commands = v8::Object::New(context->GetIsolate());
+    Set(context, commands,
+        "save", nu::PainterCommand::Save,
+        "restore", nu::PainterCommand::Restore,
+        "beginPath", nu::PainterCommand::BeginPath,
+        "closePath", nu::PainterCommand::ClosePath,
+        "moveTo", nu::PainterCommand::MoveTo,
+        "lineTo", nu::PainterCommand::LineTo,
+        "bezierCurveTo", nu::PainterCommand::BezierCurveTo,
+        "arc", nu::PainterCommand::Arc,
+        "rect", nu::PainterCommand::Rect,
+        "clip", nu::PainterCommand::Clip,
+        "clipRect", nu::PainterCommand::ClipRect,
+        "translate", nu::PainterCommand::Translate,
+        "rotate", nu::PainterCommand::Rotate,
+        "scale", nu::PainterCommand::Scale,
+        "setColor", nu::PainterCommand::SetColor,
+        "setStrokeColor", nu::PainterCommand::SetStrokeColor,
+        "setFillColor", nu::PainterCommand::SetFillColor,
+        "setLineWidth", nu::PainterCommand::SetLineWidth,
+        "stroke", nu::PainterCommand::Stroke,
+        "fill", nu::PainterCommand::Fill,
+        "strokeRect", nu::PainterCommand::StrokeRect,
+        "fillRect", nu::PainterCommand::FillRect);
+    Set(context, constructor,
+        "commands", commands,
+        "packCommands", &PackCommands);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
-        "save", &nu::Painter::Save,
-        "restore", &nu::Painter::Restore,
-        "beginPath", &nu::Painter::BeginPath,
-        "closePath", &nu::Painter::ClosePath,
-        "moveTo", &nu::Painter::MoveTo,
-        "lineTo", &nu::Painter::LineTo,
-        "bezierCurveTo", &nu::Painter::BezierCurveTo,
-        "arc", &nu::Painter::Arc,
-        "rect", &nu::Painter::Rect,
-        "clip", &nu::Painter::Clip,
-        "clipRect", &nu::Painter::ClipRect,
-        "translate", &nu::Painter::Translate,
-        "rotate", &nu::Painter::Rotate,
-        "scale", &nu::Painter::Scale,
-        "setColor", &nu::Painter::SetColor,
-        "setStrokeColor", &nu::Painter::SetStrokeColor,
-        "setFillColor", &nu::Painter::SetFillColor,
-        "setLineWidth", &nu::Painter::SetLineWidth,
-        "stroke", &nu::Painter::Stroke,
-        "fill", &nu::Painter::Fill,
-        "strokeRect", &nu::Painter::StrokeRect,
-        "fillRect", &nu::Painter::FillRect,
+        "save", vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::Save>>(
+            &nu::Painter::Save),
+        "restore",
+        vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::Restore>>(
+            &nu::Painter::Restore),
+        "beginPath",
+        vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::BeginPath>>(
+            &nu::Painter::BeginPath),
+        "closePath",
+        vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::ClosePath>>(
+            &nu::Painter::ClosePath),
+        "moveTo", vb::FastMethod<fast::CallWithPoint<&nu::Painter::MoveTo>>(
+            &nu::Painter::MoveTo),
+        "lineTo", vb::FastMethod<fast::CallWithPoint<&nu::Painter::LineTo>>(
+            &nu::Painter::LineTo),
+        "bezierCurveTo", vb::FastMethod<fast::BezierCurveTo>(
+            &nu::Painter::BezierCurveTo),
+        "arc", vb::FastMethod<fast::Arc>(&nu::Painter::Arc),
+        "rect", vb::FastMethod<fast::CallWithRect<&nu::Painter::Rect>>(
+            &nu::Painter::Rect),
+        "clip", vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::Clip>>(
+            &nu::Painter::Clip),
+        "clipRect", vb::FastMethod<fast::CallWithRect<&nu::Painter::ClipRect>>(
+            &nu::Painter::ClipRect),
+        "translate",
+        vb::FastMethod<fast::CallWithVector<&nu::Painter::Translate>>(
+            &nu::Painter::Translate),
+        "rotate", vb::FastMethod<fast::Rotate>(&nu::Painter::Rotate),
+        "scale", vb::FastMethod<fast::CallWithVector<&nu::Painter::Scale>>(
+            &nu::Painter::Scale),
+        "setColor", vb::FastMethod<fast::CallWithColor<&nu::Painter::SetColor>>(
+            &nu::Painter::SetColor),
+        "setStrokeColor",
+        vb::FastMethod<fast::CallWithColor<&nu::Painter::SetStrokeColor>>(
+            &nu::Painter::SetStrokeColor),
+        "setFillColor",
+        vb::FastMethod<fast::CallWithColor<&nu::Painter::SetFillColor>>(
+            &nu::Painter::SetFillColor),
+        "setLineWidth", vb::FastMethod<fast::SetLineWidth>(
+            &nu::Painter::SetLineWidth),
+        "stroke", vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::Stroke>>(
+            &nu::Painter::Stroke),
+        "fill", vb::FastMethod<fast::Call<nu::Painter, &nu::Painter::Fill>>(
+            &nu::Painter::Fill),
+        "strokeRect",
+        vb::FastMethod<fast::CallWithRect<&nu::Painter::StrokeRect>>(
+            &nu::Painter::StrokeRect),
+        "fillRect", vb::FastMethod<fast::CallWithRect<&nu::Painter::FillRect>>(
+            &nu::Painter::FillRect),
         "measureText", &nu::Painter::MeasureText,
         "drawText", &nu::Painter::DrawText,
+        "drawAttributedText", &nu::Painter::DrawAttributedText,
+        "drawTextBatch", &nu::Painter::DrawTextBatch,
         "drawCanvas", &nu::Painter::DrawCanvas,
         "drawCanvasFromRect", &nu::Painter::DrawCanvasFromRect,
-        "drawImage", &nu::Painter::DrawImage);
+        "drawImage", &nu::Painter::DrawImage,
+        "drawImageSet", &nu::Painter::DrawImageSet,
+        "drawAtlasImage", &nu::Painter::DrawAtlasImage,
+        "executeCommands", &ExecuteCommands);
+  }
+  // Pack an array of numbers into a Float32Array that can be reused.
+  static v8::Local<v8::Object> PackCommands(v8::Local<v8::Context> context,
+                                            const std::vector<float>& array) {
+    size_t size = array.size() * sizeof(float);
+    v8::Local<v8::ArrayBuffer> buffer =
+        v8::ArrayBuffer::New(context->GetIsolate(), size);
+    memcpy(GetArrayBufferData(buffer), array.data(), size);
+    return v8::Float32Array::New(buffer, 0, array.size());
+  }
+  // Accept any typed array, a Buffer, an ArrayBuffer, or an array of numbers.
+  // The typed arrays are checked explicitly since node::Buffer::HasInstance
+  // only accepts Uint8Array on old versions of Node.
+  static void ExecuteCommands(Arguments* args, v8::Local<v8::Value> value) {
+    nu::Painter* painter;
+    if (!args->GetHolder(&painter))
+      return;
+    v8::Local<v8::Context> context = args->GetContext();
+    bool success = false;
+    std::vector<float> commands;
+    if (value->IsArrayBufferView()) {
+      v8::Local<v8::ArrayBufferView> view = value.As<v8::ArrayBufferView>();
+      success = painter->ExecuteCommands(nu::Buffer::Wrap(
+          GetArrayBufferData(view->Buffer()) + view->ByteOffset(),
+          view->ByteLength()));
+    } else if (value->IsArrayBuffer()) {
+      v8::Local<v8::ArrayBuffer> buffer = value.As<v8::ArrayBuffer>();
+      success = painter->ExecuteCommands(nu::Buffer::Wrap(
+          GetArrayBufferData(buffer), buffer->ByteLength()));
+    } else if (vb::FromV8(context, value, &commands))
+      success = painter->ExecuteCommands(nu::Buffer::Wrap(
+          commands.data(), commands.size() * sizeof(float)));
+    if (!success)
+      vb::ThrowError(args->isolate(), "Malformed painter commands");
   }
 };
 
@@ -711,6 +1045,17 @@ struct Type<nu::FileSaveDialog> {
   }
 };
 
+void ReadMenuItems(v8::Local<v8::Context> context,
+                   v8::Local<v8::Array> options,
+                   std::vector<scoped_refptr<nu::MenuItem>>* items);
+void ReadMenuItems(v8::Local<v8::Context> context,
+                   v8::Local<v8::Array> options,
+                   nu::MenuBase* menu);
+void StoreMenuItemRefs(v8::Local<v8::Context> context,
+                       v8::Local<v8::Object> object,
+                       nu::MenuBase* menu,
+                       RefType ref_type);
+
 template<>
 struct Type<nu::MenuBase> {
   static constexpr const char* name = "yue.MenuBase";
@@ -723,15 +1068,30 @@ struct Type<nu::MenuBase> {
         "append", RefMethod(&nu::MenuBase::Append, RefType::Ref),
         "insert", RefMethod(&nu::MenuBase::Insert, RefType::Ref),
         "remove", RefMethod(&nu::MenuBase::Remove, RefType::Deref),
+        "setItems", &SetItems,
         "itemCount", &nu::MenuBase::ItemCount,
         "itemAt", &nu::MenuBase::ItemAt);
+    SetProperty(context, templ,
+                "onWillOpen", &nu::MenuBase::on_will_open);
+  }
+  static void SetItems(Arguments* args, v8::Local<v8::Array> options) {
+    nu::MenuBase* menu;
+    if (!args->GetHolder(&menu))
+      return;
+    std::vector<scoped_refptr<nu::MenuItem>> items;
+    ReadMenuItems(args->GetContext(), options, &items);
+    std::vector<nu::MenuItem*> raw_items;
+    raw_items.reserve(items.size());
+    for (const auto& item : items)
+      raw_items.push_back(item.get());
+    // Keep the same references that append and remove would keep.
+    v8::Local<v8::Object> holder = args->info().Holder();
+    StoreMenuItemRefs(args->GetContext(), holder, menu, RefType::Deref);
+    menu->SetItems(raw_items);
+    StoreMenuItemRefs(args->GetContext(), holder, menu, RefType::Ref);
   }
 };
 
-void ReadMenuItems(v8::Local<v8::Context> context,
-                   v8::Local<v8::Array> options,
-                   nu::MenuBase* menu);
-
 template<>
 struct Type<nu::MenuBar> {
   using base = nu::MenuBase;
@@ -947,19 +1307,37 @@ struct Type<nu::MenuItem> {
 
 void ReadMenuItems(v8::Local<v8::Context> context,
                    v8::Local<v8::Array> arr,
-                   nu::MenuBase* menu) {
-  std::vector<v8::Local<v8::Object>> items;
-  if (vb::FromV8(context, arr, &items)) {
-    for (v8::Local<v8::Object> obj : items) {
+                   std::vector<scoped_refptr<nu::MenuItem>>* items) {
+  std::vector<v8::Local<v8::Object>> objects;
+  if (vb::FromV8(context, arr, &objects)) {
+    for (v8::Local<v8::Object> obj : objects) {
       // Create the item if an object is passed.
       nu::MenuItem* item;
       if (!vb::FromV8(context, obj, &item))
         item = Type<nu::MenuItem>::CreateRaw(context, obj);
-      menu->Append(item);
+      items->emplace_back(item);
     }
   }
 }
 
+void ReadMenuItems(v8::Local<v8::Context> context,
+                   v8::Local<v8::Array> arr,
+                   nu::MenuBase* menu) {
+  std::vector<scoped_refptr<nu::MenuItem>> items;
+  ReadMenuItems(context, arr, &items);
+  for (const auto& item : items)
+    menu->Append(item.get());
+}
+
+void StoreMenuItemRefs(v8::Local<v8::Context> context,
+                       v8::Local<v8::Object> object,
+                       nu::MenuBase* menu,
+                       RefType ref_type) {
+  for (int i = 0; i < menu->ItemCount(); ++i)
+    internal::StoreArg(context, object, ToV8(context, menu->ItemAt(i)),
+                       ref_type, nullptr);
+}
+
 template<>
 struct Type<nu::Tray> {
   static constexpr const char* name = "yue.Tray";
@@ -1075,6 +1453,48 @@ struct Type<nu::Window::Options> {
   }
 };
 
+template<>
+struct Type<nu::MemoryDump> {
+  static constexpr const char* name = "yue.MemoryDump";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::MemoryDump& dump) {
+    v8::Isolate* isolate = context->GetIsolate();
+    v8::Local<v8::Object> obj = v8::Object::New(isolate);
+    Set(context, obj,
+        "view", dump.view.get(),
+        "className", dump.class_name,
+        "selfBytes", v8::Number::New(isolate, dump.self_bytes),
+        "totalBytes", v8::Number::New(isolate, dump.total_bytes),
+        "viewCount", dump.view_count,
+        "children", dump.children);
+    return obj;
+  }
+};
+
+#if defined(OS_LINUX)
+template<>
+struct Type<nu::Window::FrameStats> {
+  static constexpr const char* name = "yue.Window.FrameStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::Window::FrameStats& stats) {
+    v8::Local<v8::Object> obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "frameCount", stats.frame_count,
+        "droppedFrames", stats.dropped_frames,
+        "fps", stats.fps,
+        "frameIntervalHistogram", stats.frame_interval_histogram,
+        "averagePaintDuration", stats.average_paint_duration,
+        "maxPaintDuration", stats.max_paint_duration,
+        "averageLayoutDuration", stats.average_layout_duration,
+        "maxLayoutDuration", stats.max_layout_duration,
+        "slowestDrawClassName", stats.slowest_draw_class_name,
+        "slowestDrawBounds", stats.slowest_draw_bounds,
+        "slowestDrawDuration", stats.slowest_draw_duration);
+    return obj;
+  }
+};
+#endif
+
 template<>
 struct Type<nu::Window> {
   static constexpr const char* name = "yue.Window";
@@ -1139,18 +1559,37 @@ struct Type<nu::Window> {
         "setMenuBar",
         RefMethod(&nu::Window::SetMenuBar, RefType::Reset, "menuBar"),
         "getMenuBar", &nu::Window::GetMenuBar,
+#endif
+#if defined(OS_LINUX)
+        "setResizeThrottled", &nu::Window::SetResizeThrottled,
+        "isResizeThrottled", &nu::Window::IsResizeThrottled,
+        "getSkippedLayoutCount", &nu::Window::GetSkippedLayoutCount,
+        "setFrameStatsEnabled", &nu::Window::SetFrameStatsEnabled,
+        "isFrameStatsEnabled", &nu::Window::IsFrameStatsEnabled,
+        "getFrameStats", &nu::Window::GetFrameStats,
+        "resetFrameStats", &nu::Window::ResetFrameStats,
+        "setFrameStatsOverlayVisible", &nu::Window::SetFrameStatsOverlayVisible,
+        "isFrameStatsOverlayVisible", &nu::Window::IsFrameStatsOverlayVisible,
 #endif
         "addChildWindow",
         RefMethod(&nu::Window::AddChildWindow, RefType::Ref),
         "removeChildView",
         RefMethod(&nu::Window::RemoveChildWindow, RefType::Deref),
-        "getChildWindows", &nu::Window::GetChildWindows);
+        "getChildWindows", &nu::Window::GetChildWindows,
+        "dumpMemory", &DumpMemory);
     SetProperty(context, templ,
                 "onClose", &nu::Window::on_close,
                 "onFocus", &nu::Window::on_focus,
                 "onBlur", &nu::Window::on_blur,
+                "onResizeEnd", &nu::Window::on_resize_end,
                 "shouldClose", &nu::Window::should_close);
   }
+  static nu::MemoryDump DumpMemory(Arguments* args) {
+    nu::Window* window;
+    if (!args->GetHolder(&window))
+      return nu::MemoryDump();
+    return nu::MemoryDump::FromWindow(window);
+  }
 };
 
 template<>
@@ -1169,17 +1608,30 @@ struct Type<nu::View> {
         "layout", &nu::View::Layout,
         "schedulePaint", &nu::View::SchedulePaint,
         "schedulePaintRect", &nu::View::SchedulePaintRect,
+        // Fast functions must not call into JavaScript, so setters that may
+        // emit events, like changing visibility, are not made fast.
         "setVisible", &nu::View::SetVisible,
-        "isVisible", &nu::View::IsVisible,
+        "isVisible", vb::FastMethod<fast::Get<nu::View, &nu::View::IsVisible>>(
+            &nu::View::IsVisible),
         "setEnabled", &nu::View::SetEnabled,
-        "isEnabled", &nu::View::IsEnabled,
+        "isEnabled", vb::FastMethod<fast::Get<nu::View, &nu::View::IsEnabled>>(
+            &nu::View::IsEnabled),
         "focus", &nu::View::Focus,
-        "hasFocus", &nu::View::HasFocus,
-        "setFocusable", &nu::View::SetFocusable,
-        "isFocusable", &nu::View::IsFocusable,
+        "hasFocus", vb::FastMethod<fast::Get<nu::View, &nu::View::HasFocus>>(
+            &nu::View::HasFocus),
+        "setFocusable",
+        vb::FastMethod<fast::Set<nu::View, &nu::View::SetFocusable>>(
+            &nu::View::SetFocusable),
+        "isFocusable",
+        vb::FastMethod<fast::Get<nu::View, &nu::View::IsFocusable>>(
+            &nu::View::IsFocusable),
         "setCapture", &nu::View::SetCapture,
         "releaseCapture", &nu::View::ReleaseCapture,
         "hasCapture", &nu::View::HasCapture,
+#if defined(OS_LINUX)
+        "captureToCanvas", &nu::View::CaptureToCanvas,
+        "captureToCanvasAsync", &nu::View::CaptureToCanvasAsync,
+#endif
         "setMouseDownCanMoveWindow", &nu::View::SetMouseDownCanMoveWindow,
         "isMouseDownCanMoveWindow", &nu::View::IsMouseDownCanMoveWindow,
         "setFont", &nu::View::SetFont,
@@ -1193,7 +1645,8 @@ struct Type<nu::View> {
         "wantsLayer", &nu::View::WantsLayer,
 #endif
         "getParent", &nu::View::GetParent,
-        "getWindow", &nu::View::GetWindow);
+        "getWindow", &nu::View::GetWindow,
+        "dumpMemory", &DumpMemory);
     SetProperty(context, templ,
                 "onMouseDown", &nu::View::on_mouse_down,
                 "onMouseUp", &nu::View::on_mouse_up,
@@ -1205,6 +1658,12 @@ struct Type<nu::View> {
                 "onSizeChanged", &nu::View::on_size_changed,
                 "onCaptureLost", &nu::View::on_capture_lost);
   }
+  static nu::MemoryDump DumpMemory(Arguments* args) {
+    nu::View* view;
+    if (!args->GetHolder(&view))
+      return nu::MemoryDump();
+    return nu::MemoryDump::FromView(view);
+  }
   static void SetStyle(
       Arguments* args,
       const std::map<std::string, v8::Local<v8::Value>>& styles) {
@@ -1239,6 +1698,36 @@ struct Type<nu::ComboBox> {
   }
 };
 
+template<>
+struct Type<nu::SceneItem> {
+  static constexpr const char* name = "yue.SceneItem";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::SceneItem>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setBounds", &nu::SceneItem::SetBounds,
+        "getBounds", &nu::SceneItem::GetBounds,
+        "setZIndex", &nu::SceneItem::SetZIndex,
+        "getZIndex", &nu::SceneItem::GetZIndex,
+        "setVisible", &nu::SceneItem::SetVisible,
+        "isVisible", &nu::SceneItem::IsVisible,
+        "schedulePaint", &nu::SceneItem::SchedulePaint,
+        "schedulePaintRect", &nu::SceneItem::SchedulePaintRect,
+        "getContainer", &nu::SceneItem::GetContainer);
+    SetProperty(context, templ,
+                "onDraw", &nu::SceneItem::on_draw,
+                "onMouseDown", &nu::SceneItem::on_mouse_down,
+                "onMouseUp", &nu::SceneItem::on_mouse_up,
+                "onMouseMove", &nu::SceneItem::on_mouse_move,
+                "onMouseEnter", &nu::SceneItem::on_mouse_enter,
+                "onMouseLeave", &nu::SceneItem::on_mouse_leave);
+  }
+};
+
 template<>
 struct Type<nu::Container> {
   using base = nu::View;
@@ -1263,7 +1752,13 @@ struct Type<nu::Container> {
         "removeChildView",
         RefMethod(&nu::Container::RemoveChildView, RefType::Deref),
         "childCount", &nu::Container::ChildCount,
-        "childAt", &nu::Container::ChildAt);
+        "childAt", &nu::Container::ChildAt,
+        "addItem", RefMethod(&nu::Container::AddItem, RefType::Ref),
+        "removeItem", RefMethod(&nu::Container::RemoveItem, RefType::Deref),
+        "itemCount", &nu::Container::ItemCount,
+        "itemAt", &nu::Container::ItemAt,
+        "getItemAt", &nu::Container::GetItemAt,
+        "getItemsInRect", &nu::Container::GetItemsInRect);
     SetProperty(context, templ,
                 "onDraw", &nu::Container::on_draw);
   }
@@ -1771,9 +2266,21 @@ struct Type<nu::Scroll> {
 #if !defined(OS_WIN)
         "setOverlayScrollbar", &nu::Scroll::SetOverlayScrollbar,
         "isOverlayScrollbar", &nu::Scroll::IsOverlayScrollbar,
+#endif
+#if defined(OS_LINUX)
+        "setVirtualContentMode", &nu::Scroll::SetVirtualContentMode,
+        "isVirtualContentMode", &nu::Scroll::IsVirtualContentMode,
+        "setVirtualContentSize", &nu::Scroll::SetVirtualContentSize,
+        "getVirtualContentSize", &nu::Scroll::GetVirtualContentSize,
+        "setScrollPosition", &nu::Scroll::SetScrollPosition,
+        "getScrollPosition", &nu::Scroll::GetScrollPosition,
 #endif
         "setScrollbarPolicy", &nu::Scroll::SetScrollbarPolicy,
         "getScrollbarPolicy", &nu::Scroll::GetScrollbarPolicy);
+#if defined(OS_LINUX)
+    SetProperty(context, templ,
+                "onDrawContent", &nu::Scroll::on_draw_content);
+#endif
   }
 };
 
@@ -1817,7 +2324,14 @@ struct Type<nu::Tab> {
         "pageAt", &nu::Tab::PageAt,
         "selectPageAt", &nu::Tab::SelectPageAt,
         "getSelectedPage", &nu::Tab::GetSelectedPage,
-        "getSelectedPageIndex", &nu::Tab::GetSelectedPageIndex);
+        "getSelectedPageIndex", &nu::Tab::GetSelectedPageIndex,
+        "addLazyPage", &nu::Tab::AddLazyPage,
+        "loadPageAt", &nu::Tab::LoadPageAt,
+        "isPageLoadedAt", &nu::Tab::IsPageLoadedAt,
+        "setPrefetchLazyPages", &nu::Tab::SetPrefetchLazyPages,
+        "isPrefetchLazyPages", &nu::Tab::IsPrefetchLazyPages,
+        "setUnloadHiddenPagesAfter", &nu::Tab::SetUnloadHiddenPagesAfter,
+        "getUnloadHiddenPagesAfter", &nu::Tab::GetUnloadHiddenPagesAfter);
     SetProperty(context, templ,
                 "onSelectedPageChange", &nu::Tab::on_selected_page_change);
   }
@@ -1899,6 +2413,30 @@ struct Type<nu::Table::ColumnType> {
   }
 };
 
+template<>
+struct Type<nu::TableCell> {
+  static constexpr const char* name = "yue.TableCell";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::TableCell& cell) {
+    switch (cell.type()) {
+      case nu::TableCell::Type::Integer:
+        return vb::ToV8(context, static_cast<double>(cell.GetInteger()));
+      case nu::TableCell::Type::Double:
+        return vb::ToV8(context, cell.GetDouble());
+      case nu::TableCell::Type::Boolean:
+        return vb::ToV8(context, cell.GetBool());
+      case nu::TableCell::Type::String:
+        return vb::ToV8(context, cell.GetString());
+      case nu::TableCell::Type::Image:
+        return vb::ToV8(context, cell.GetImage());
+      case nu::TableCell::Type::AtlasImage:
+        return vb::ToV8(context, cell.GetAtlasImage());
+      default:
+        return v8::Null(context->GetIsolate());
+    }
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnOptions> {
   static constexpr const char* name = "yue.Table.ColumnOptions";
@@ -1911,13 +2449,26 @@ struct Type<nu::Table::ColumnOptions> {
     Get(context, obj, "type", &out->type);
     v8::Local<v8::Value> on_draw_val;
     if (Get(context, obj, "onDraw", &on_draw_val))
-      WeakFunctionFromV8(context, on_draw_val, &out->on_draw);
+      WeakFunctionFromV8(context, on_draw_val, &out->on_draw_cell);
     Get(context, obj, "column", &out->column);
     Get(context, obj, "width", &out->width);
     return true;
   }
 };
 
+#if defined(OS_LINUX)
+template<>
+struct Type<nu::Range> {
+  static constexpr const char* name = "yue.Range";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::Range& value) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj, "start", value.start, "end", value.end);
+    return obj;
+  }
+};
+#endif
+
 template<>
 struct Type<nu::Table> {
   using base = nu::View;
@@ -1937,11 +2488,99 @@ struct Type<nu::Table> {
         "getColumnCount", &nu::Table::GetColumnCount,
         "setColumnsVisible", &nu::Table::SetColumnsVisible,
         "isColumnsVisible", &nu::Table::IsColumnsVisible,
+#if defined(OS_LINUX)
+        "setMultipleSelection", &nu::Table::SetMultipleSelection,
+        "isMultipleSelection", &nu::Table::IsMultipleSelection,
+        "selectRange", &nu::Table::SelectRange,
+        "deselectRange", &nu::Table::DeselectRange,
+        "toggleRange", &nu::Table::ToggleRange,
+        "selectAll", &nu::Table::SelectAll,
+        "deselectAll", &nu::Table::DeselectAll,
+        "invertSelection", &nu::Table::InvertSelection,
+        "isRowSelected", &nu::Table::IsRowSelected,
+        "getSelectedRanges", &nu::Table::GetSelectedRanges,
+#endif
         "setRowHeight", &nu::Table::SetRowHeight,
         "getRowHeight", &nu::Table::GetRowHeight);
+#if defined(OS_LINUX)
+    SetProperty(context, templ,
+                "onSelectionChange", &nu::Table::on_selection_change);
+#endif
   }
 };
 
+#if defined(OS_LINUX)
+template<>
+struct Type<nu::TreeModel> {
+  static constexpr const char* name = "yue.TreeModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "getChildCount", &nu::TreeModel::GetChildCount,
+        "getChildAt", &nu::TreeModel::GetChildAt,
+        "getParent", &nu::TreeModel::GetParent,
+        "hasChildren", &nu::TreeModel::HasChildren,
+        "setValue", &nu::TreeModel::SetValue,
+        "notifyChildrenChanged", &nu::TreeModel::NotifyChildrenChanged,
+        "notifyNodeChanged", &nu::TreeModel::NotifyNodeChanged);
+  }
+};
+
+template<>
+struct Type<nu::AbstractTreeModel> {
+  using base = nu::TreeModel;
+  static constexpr const char* name = "yue.AbstractTreeModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::AbstractTreeModel>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    SetProperty(context, templ,
+                "getChildCount", &nu::AbstractTreeModel::get_child_count,
+                "getChildAt", &nu::AbstractTreeModel::get_child_at,
+                "getParent", &nu::AbstractTreeModel::get_parent,
+                "hasChildren", &nu::AbstractTreeModel::has_children,
+                "getValue", &nu::AbstractTreeModel::get_value,
+                "setValue", &nu::AbstractTreeModel::set_value,
+                "loadChildren", &nu::AbstractTreeModel::load_children);
+  }
+};
+
+template<>
+struct Type<nu::Tree> {
+  using base = nu::View;
+  static constexpr const char* name = "yue.Tree";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::Tree>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setModel", RefMethod(&nu::Tree::SetModel, RefType::Reset, "model"),
+        "getModel", &nu::Tree::GetModel,
+        "addColumn", &nu::Tree::AddColumn,
+        "addColumnWithOptions",
+        RefMethod(&nu::Tree::AddColumnWithOptions, RefType::Ref, nullptr, 1),
+        "getColumnCount", &nu::Tree::GetColumnCount,
+        "setColumnsVisible", &nu::Tree::SetColumnsVisible,
+        "isColumnsVisible", &nu::Tree::IsColumnsVisible,
+        "expandNode", &nu::Tree::ExpandNode,
+        "collapseNode", &nu::Tree::CollapseNode,
+        "isNodeExpanded", &nu::Tree::IsNodeExpanded,
+        "selectNode", &nu::Tree::SelectNode,
+        "getSelectedNode", &nu::Tree::GetSelectedNode);
+    SetProperty(context, templ,
+                "onNodeExpand", &nu::Tree::on_node_expand,
+                "onNodeCollapse", &nu::Tree::on_node_collapse);
+  }
+};
+#endif
+
 template<>
 struct Type<nu::TextEdit> {
   using base = nu::View;
@@ -2107,6 +2746,19 @@ void MemoryPressureNotification(v8::Local<v8::Context> context, int level) {
       static_cast<v8::MemoryPressureLevel>(level));
 }
 
+v8::Local<v8::Object> GetMemoryUsage(v8::Local<v8::Context> context) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Object> result = v8::Object::New(isolate);
+  for (const auto& it : nu::GetMemoryUsage()) {
+    v8::Local<v8::Object> usage = v8::Object::New(isolate);
+    vb::Set(context, usage,
+            "count", it.second.count,
+            "bytes", v8::Number::New(isolate, it.second.bytes));
+    vb::Set(context, result, it.first, usage);
+  }
+  return result;
+}
+
 void Initialize(v8::Local<v8::Object> exports) {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::Local<v8::Context> context = isolate->GetCurrentContext();
@@ -2136,9 +2788,13 @@ void Initialize(v8::Local<v8::Object> exports) {
           // Classes.
           "App",               vb::Constructor<nu::App>(),
           "Font",              vb::Constructor<nu::Font>(),
+          "AttributedText",    vb::Constructor<nu::AttributedText>(),
           "Canvas",            vb::Constructor<nu::Canvas>(),
           "Color",             vb::Constructor<nu::Color>(),
           "Image",             vb::Constructor<nu::Image>(),
+          "ImageSet",          vb::Constructor<nu::ImageSet>(),
+          "ImageAtlas",        vb::Constructor<nu::ImageAtlas>(),
+          "AtlasImage",        vb::Constructor<nu::AtlasImage>(),
           "Painter",           vb::Constructor<nu::Painter>(),
           "Event",             vb::Constructor<nu::Event>(),
           "FileDialog",        vb::Constructor<nu::FileDialog>(),
@@ -2151,6 +2807,7 @@ void Initialize(v8::Local<v8::Object> exports) {
           "View",              vb::Constructor<nu::View>(),
           "ComboBox",          vb::Constructor<nu::ComboBox>(),
           "Container",         vb::Constructor<nu::Container>(),
+          "SceneItem",         vb::Constructor<nu::SceneItem>(),
           "Button",            vb::Constructor<nu::Button>(),
           "ProtocolStringJob", vb::Constructor<nu::ProtocolStringJob>(),
           "ProtocolFileJob",   vb::Constructor<nu::ProtocolFileJob>(),
@@ -2171,6 +2828,11 @@ void Initialize(v8::Local<v8::Object> exports) {
           "Table",             vb::Constructor<nu::Table>(),
           "TextEdit",          vb::Constructor<nu::TextEdit>(),
           "Tray",              vb::Constructor<nu::Tray>(),
+#if defined(OS_LINUX)
+          "TreeModel",         vb::Constructor<nu::TreeModel>(),
+          "AbstractTreeModel", vb::Constructor<nu::AbstractTreeModel>(),
+          "Tree",              vb::Constructor<nu::Tree>(),
+#endif
 #if defined(OS_MACOSX)
           "Toolbar",           vb::Constructor<nu::Toolbar>(),
           "Vibrant",           vb::Constructor<nu::Vibrant>(),
@@ -2178,7 +2840,9 @@ void Initialize(v8::Local<v8::Object> exports) {
           // Properties.
           "app",      nu::State::GetCurrent()->GetApp(),
           // Functions.
-          "memoryPressureNotification", &MemoryPressureNotification);
+          "memoryPressureNotification", &MemoryPressureNotification,
+          "enableMemoryTracking", &nu::EnableMemoryTracking,
+          "getMemoryUsage", &GetMemoryUsage);
   if (is_electron) {
 #if defined(OS_MACOSX)
     vb::Set(context, exports,
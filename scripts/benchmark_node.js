@@ -0,0 +1,224 @@
+#!/usr/bin/env node
+
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+// Measure the overhead of the V8 bindings, run it against a built addon:
+//
+//   node scripts/benchmark_node.js [--addon=out/Node/gui.node]
+//                                  [--iterations=20] [--warmup=3]
+//                                  [--json=results.json]
+//                                  [--baseline=results.json]
+//                                  [--threshold=5]
+//
+// When comparing with --baseline, the run only fails for regressions beyond
+// --threshold percent if it is passed, otherwise the comparison is printed.
+
+const {spawnSync} = require('child_process')
+const fs = require('fs')
+const path = require('path')
+
+// Collecting wrappers requires the gc function.
+if (typeof global.gc != 'function') {
+  const result = spawnSync(process.execPath,
+                           ['--expose-gc', __filename].concat(process.argv.slice(2)),
+                           {stdio: 'inherit'})
+  process.exit(result.status)
+}
+
+// Parse args.
+const options = {
+  addon: 'out/Node/gui.node',
+  iterations: 20,
+  warmup: 3,
+  // Negative value means regressions are not checked.
+  threshold: -1,
+}
+for (const arg of process.argv.slice(2)) {
+  const match = arg.match(/^--([a-z]+)=(.*)$/)
+  if (!match) {
+    console.error(`Unknown argument: ${arg}`)
+    process.exit(1)
+  }
+  options[match[1]] = match[2]
+}
+
+const gui = require(path.resolve(options.addon))
+
+// How many times the code is run in each iteration of the benchmark.
+const kLoopCount = 10000
+
+const results = []
+
+function median(sorted) {
+  const n = sorted.length
+  return n % 2 ? sorted[(n - 1) / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2
+}
+
+// Run |task| with warmups and record the summary in microseconds.
+function run(name, items, task) {
+  for (let i = 0; i < options.warmup; ++i)
+    task()
+  const samples = []
+  for (let i = 0; i < options.iterations; ++i) {
+    const start = process.hrtime()
+    task()
+    const [s, ns] = process.hrtime(start)
+    samples.push(s * 1e6 + ns / 1e3)
+  }
+  samples.sort((a, b) => a - b)
+  const mean = samples.reduce((a, b) => a + b, 0) / samples.length
+  const variance = samples.reduce((a, b) => a + (b - mean) * (b - mean), 0)
+  const result = {
+    name,
+    items,
+    iterations: samples.length,
+    mean,
+    median: median(samples),
+    stddev: samples.length > 1 ? Math.sqrt(variance / (samples.length - 1)) : 0,
+    min: samples[0],
+    max: samples[samples.length - 1],
+  }
+  result.median_per_item = result.median / items
+  results.push(result)
+  console.log(`[ PERF     ] ${name.padEnd(40)} ` +
+              `${mean.toFixed(3).padStart(12)} us/iter ` +
+              `(median ${result.median.toFixed(3)}, ` +
+              `stddev ${result.stddev.toFixed(3)}), ` +
+              `${(mean / items).toFixed(3)} us/item`)
+}
+
+// Run |fn| inside a loop of |kLoopCount| times.
+function runLoop(name, fn) {
+  run(name, kLoopCount, () => {
+    for (let i = 0; i < kLoopCount; ++i)
+      fn(i)
+  })
+}
+
+const canvas = gui.Canvas.createForMainScreen({width: 100, height: 100})
+const painter = canvas.getPainter()
+const slider = gui.Slider.create()
+const label = gui.Label.create('label')
+const item = gui.MenuItem.create('label')
+const font = gui.Font.default()
+
+// The cost of the loop itself, which is included in all other results.
+runLoop('Node.EmptyLoop', (i) => {})
+
+// Method calls.
+runLoop('Node.MethodCall.0Args', () => { painter.save(); painter.restore() })
+runLoop('Node.MethodCall.1Args', () => painter.setLineWidth(1))
+runLoop('Node.MethodCall.2Args', () => slider.setRange(0, 100))
+runLoop('Node.MethodCall.3Args', () => gui.Color.rgb(1, 2, 3))
+runLoop('Node.MethodCall.4Args', () => gui.Color.argb(1, 2, 3, 4))
+runLoop('Node.MethodCall.ReturnString', () => label.getText())
+
+// Property access.
+runLoop('Node.PropertyAccess.Method', () => painter.save)
+runLoop('Node.PropertyAccess.Signal', () => item.onClick)
+
+// Struct conversions.
+runLoop('Node.RectF.FromObject',
+        () => painter.rect({x: 0, y: 0, width: 10, height: 10}))
+runLoop('Node.RectF.ToObject', () => label.getBounds())
+// Compare with the empty attributes to get the conversion cost.
+runLoop('Node.TextAttributes.Empty', () => painter.measureText('a', -1, {}))
+runLoop('Node.TextAttributes.Full', () => painter.measureText('a', -1, {
+  font, color: '#FFF', align: 'center', valign: 'center',
+}))
+
+// Drawing, the number forms skip the conversion of objects, and can be called
+// through V8 fast API calls when the code gets optimized on V8 10 and 11.
+runLoop('Node.Painter.LineTo.Object', (i) => {
+  if (i == 0) painter.beginPath()
+  painter.lineTo({x: i % 100, y: i % 50})
+})
+runLoop('Node.Painter.LineTo.Numbers', (i) => {
+  if (i == 0) painter.beginPath()
+  painter.lineTo(i % 100, i % 50)
+})
+runLoop('Node.Painter.FillRect.Object',
+        () => painter.fillRect({x: 0, y: 0, width: 10, height: 10}))
+runLoop('Node.Painter.FillRect.Numbers', () => painter.fillRect(0, 0, 10, 10))
+runLoop('Node.Painter.SetColor.String', () => painter.setColor('#FF0000'))
+runLoop('Node.Painter.SetColor.Number', () => painter.setColor(0xFFFF0000))
+runLoop('Node.View.Getter', () => label.isVisible())
+
+// Drawing 100 rectangles with individual calls vs one command buffer.
+const {commands} = gui.Painter
+const rects = new Float32Array(100 * 5)
+for (let i = 0; i < 100; ++i)
+  rects.set([commands.fillRect, i, i, 10, 10], i * 5)
+runLoop('Node.Painter.Rects.Calls', () => {
+  for (let i = 0; i < 100; ++i)
+    painter.fillRect(i, i, 10, 10)
+})
+runLoop('Node.Painter.Rects.Commands', () => painter.executeCommands(rects))
+
+// Signal emission into script, emitting without handlers is the baseline.
+let count = 0
+runLoop('Node.Signal.NoHandler', () => item.click())
+item.onClick.connect(() => { count++ })
+runLoop('Node.Signal.OneHandler', () => item.click())
+for (let i = 0; i < 9; ++i)
+  item.onClick.connect(() => { count++ })
+runLoop('Node.Signal.TenHandlers', () => item.click())
+
+// Wrapper creation and collection.
+runLoop('Node.Wrapper.Create', () => gui.Label.create('label'))
+run('Node.Wrapper.CreateAndGC.1000', 1000, () => {
+  for (let i = 0; i < 1000; ++i)
+    gui.Label.create('label')
+  global.gc()
+})
+
+// base::Value round trips through table model.
+for (const size of [1, 10, 100, 1000]) {
+  const value = []
+  for (let i = 0; i < size; ++i)
+    value.push({id: i, name: 'name', checked: i % 2 == 0, ratio: i * 0.5})
+  const model = gui.SimpleTableModel.create(1)
+  model.addRow([null])
+  run(`Node.Value.RoundTrip.${size}`, size, () => {
+    model.setValue(0, 0, value)
+    model.getValue(0, 0)
+  })
+}
+
+// Write results.
+if (options.json) {
+  const json = {unit: 'us', results}
+  fs.writeFileSync(options.json, JSON.stringify(json, null, 2))
+}
+
+// Compare with baseline.
+if (options.baseline) {
+  const baseline = {}
+  for (const r of JSON.parse(fs.readFileSync(options.baseline)).results)
+    baseline[r.name] = r.median_per_item
+  let passed = true
+  console.log('\n' + 'Benchmark'.padEnd(40) + 'Baseline'.padStart(15) +
+              'Current'.padStart(15) + 'Delta'.padStart(10))
+  for (const r of results) {
+    const current = r.median_per_item
+    const old = baseline[r.name]
+    if (!old) {
+      console.log(r.name.padEnd(40) + '-'.padStart(15) +
+                  current.toFixed(3).padStart(15) + 'new'.padStart(10))
+      continue
+    }
+    const delta = (current - old) / old * 100
+    const threshold = Number(options.threshold)
+    const regressed = threshold >= 0 && delta > threshold
+    if (regressed)
+      passed = false
+    console.log(r.name.padEnd(40) + old.toFixed(3).padStart(15) +
+                current.toFixed(3).padStart(15) +
+                `${delta >= 0 ? '+' : ''}${delta.toFixed(1)}%`.padStart(10) +
+                (regressed ? ' REGRESSED' : ''))
+  }
+  if (!passed)
+    process.exit(1)
+}
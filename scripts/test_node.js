@@ -0,0 +1,145 @@
+#!/usr/bin/env node
+
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+// Test the V8 bindings of fast methods, run it against a built addon:
+//
+//   node scripts/test_node.js [--addon=out/Node/gui.node]
+
+const {spawnSync} = require('child_process')
+const assert = require('assert')
+const path = require('path')
+
+// Collecting wrappers requires the gc function, and optimizing the callers
+// requires the natives syntax.
+if (typeof global.gc != 'function') {
+  const flags = ['--expose-gc', '--allow-natives-syntax']
+  const result = spawnSync(process.execPath,
+                           flags.concat(__filename, process.argv.slice(2)),
+                           {stdio: 'inherit'})
+  process.exit(result.status)
+}
+
+// Parse args.
+const options = {
+  addon: 'out/Node/gui.node',
+}
+for (const arg of process.argv.slice(2)) {
+  const match = arg.match(/^--([a-z]+)=(.*)$/)
+  if (!match) {
+    console.error(`Unknown argument: ${arg}`)
+    process.exit(1)
+  }
+  options[match[1]] = match[2]
+}
+
+const gui = require(path.resolve(options.addon))
+
+// Run |fn| until it gets optimized, so the fast function is called by V8 when
+// it is available.
+function optimize(fn) {
+  try {
+    eval('%PrepareFunctionForOptimization(fn)')
+  } catch (e) {
+    // Not needed by old versions of V8.
+  }
+  fn()
+  fn()
+  eval('%OptimizeFunctionOnNextCall(fn)')
+  fn()
+}
+
+const tests = {
+  numberAndObjectForms() {
+    const canvas = gui.Canvas.create({width: 10, height: 10}, 1)
+    const painter = canvas.getPainter()
+    optimize(() => {
+      painter.beginPath()
+      painter.moveTo(0, 0)
+      painter.lineTo({x: 5, y: 5})
+      painter.lineTo(5, 0)
+      painter.setColor(0xFFFF0000)
+      painter.setColor('#FF0000')
+      painter.fillRect(0, 0, 5, 5)
+      painter.fillRect({x: 0, y: 0, width: 5, height: 5})
+      painter.setLineWidth(2)
+      painter.stroke()
+    })
+  },
+
+  throwsAfterPainterIsGone() {
+    let canvas = gui.Canvas.create({width: 10, height: 10}, 1)
+    const painter = canvas.getPainter()
+    const calls = {
+      save: () => painter.save(),
+      lineTo: () => painter.lineTo(1, 1),
+      fillRect: () => painter.fillRect(0, 0, 1, 1),
+      fillRectObject: () => painter.fillRect({x: 0, y: 0, width: 1, height: 1}),
+      setColor: () => painter.setColor(0xFF000000),
+      setLineWidth: () => painter.setLineWidth(1),
+    }
+    for (const name in calls)
+      optimize(calls[name])
+    canvas = null
+    for (let i = 0; i < 10; ++i)
+      global.gc()
+    // Both the fast functions and the slow paths should fall back to the
+    // normal method, which throws.
+    for (const name in calls)
+      assert.throws(calls[name], Error, name)
+  },
+
+  executeCommands() {
+    const canvas = gui.Canvas.create({width: 10, height: 10}, 1)
+    const painter = canvas.getPainter()
+    const {commands} = gui.Painter
+    const rect = [commands.fillRect, 0, 0, 5, 5]
+    const packed = gui.Painter.packCommands(rect)
+    assert.ok(packed instanceof Float32Array)
+    painter.executeCommands(rect)
+    painter.executeCommands(packed)
+    painter.executeCommands(packed.buffer)
+    painter.executeCommands(Buffer.from(packed.buffer))
+  },
+
+  executeMalformedCommands() {
+    const canvas = gui.Canvas.create({width: 10, height: 10}, 1)
+    const painter = canvas.getPainter()
+    const {commands} = gui.Painter
+    const malformed = {
+      missingArguments: new Float32Array([commands.fillRect, 0, 0]),
+      unknownOpcode: new Float32Array([999]),
+      notNumbers: [commands.rotate, 'a'],
+      partialFloat: new Uint8Array(3),
+      notCommands: {},
+    }
+    for (const name in malformed) {
+      assert.throws(() => painter.executeCommands(malformed[name]),
+                    /Malformed painter commands/, name)
+    }
+    assert.throws(() => gui.Painter.packCommands([commands.rotate, {}]))
+  },
+
+  viewGetters() {
+    const label = gui.Label.create('label')
+    let visible
+    optimize(() => { visible = label.isVisible() })
+    assert.strictEqual(visible, true)
+    optimize(() => label.setFocusable(false))
+    assert.strictEqual(label.isFocusable(), false)
+  },
+}
+
+let failed = false
+for (const name in tests) {
+  try {
+    tests[name]()
+    console.log(`[       OK ] ${name}`)
+  } catch (e) {
+    console.error(`[  FAILED  ] ${name}\n${e.stack}`)
+    failed = true
+  }
+}
+process.exit(failed ? 1 : 0)
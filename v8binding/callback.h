@@ -65,6 +65,20 @@ bool WeakFunctionFromV8(v8::Local<v8::Context> context,
 template<typename ReturnType, typename... ArgTypes>
 struct Type<std::function<ReturnType(ArgTypes...)>> {
   static constexpr const char* name = "Function";
+  // Create the function directly instead of using a FunctionTemplate, since
+  // the templates are cached by V8 and would leak for every callback passed.
+  static inline v8::Local<v8::Value> ToV8(
+      v8::Local<v8::Context> context,
+      const std::function<ReturnType(ArgTypes...)>& callback) {
+    if (!callback)
+      return v8::Null(context->GetIsolate());
+    using Sig = ReturnType(ArgTypes...);
+    v8::Isolate* isolate = context->GetIsolate();
+    auto* holder = new internal::CallbackHolder<Sig>(isolate, callback, 0);
+    return v8::Function::New(context,
+                             &internal::Dispatcher<Sig>::DispatchToCallback,
+                             holder->GetHandle(isolate)).ToLocalChecked();
+  }
   static bool FromV8(v8::Local<v8::Context> context,
                      v8::Local<v8::Value> val,
                      std::function<ReturnType(ArgTypes...)>* out) {
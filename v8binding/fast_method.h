@@ -0,0 +1,200 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+//
+// Binding hot methods with V8 Fast API calls.
+
+#ifndef V8BINDING_FAST_METHOD_H_
+#define V8BINDING_FAST_METHOD_H_
+
+#include <functional>
+#include <type_traits>
+
+#include "v8binding/callback.h"
+#include "v8binding/prototype.h"
+
+// The Fast API calls with v8::Local<v8::Object> receivers are available since
+// V8 10, and FastApiCallbackOptions::fallback, which is used to throw when the
+// native object is gone, was removed in V8 12. Other versions only get the
+// slow path, which still benefits from the signature check.
+//
+// Note that none of the Node versions tested by CI has V8 10 or 11, so the
+// fast path is not compiled there.
+#if !defined(BUILDING_CHAKRASHIM) && defined(V8_MAJOR_VERSION) && \
+    V8_MAJOR_VERSION >= 10 && V8_MAJOR_VERSION < 12
+#define VB_HAS_FAST_API
+#include "v8-fast-api-calls.h"  // NOLINT(build/include)
+#endif
+
+namespace vb {
+
+// Get the native object from the receiver of a fast method. The receiver's
+// type has been checked by V8 with the method's signature, but the native
+// object may still be gone, in which case nullptr is returned.
+template<typename T, typename Enable = void>
+struct Receiver {};
+
+template<typename T>
+struct Receiver<T, typename std::enable_if<std::is_base_of<
+                       base::subtle::RefCountedBase, T>::value>::type> {
+  static inline T* Get(v8::Local<v8::Object> receiver) {
+    return static_cast<T*>(receiver->GetAlignedPointerFromInternalField(0));
+  }
+};
+
+template<typename T>
+struct Receiver<T, typename std::enable_if<std::is_base_of<
+                       base::internal::WeakPtrBase,
+                       decltype(((T*)nullptr)->GetWeakPtr())>::value>::type> {  // NOLINT
+  static inline T* Get(v8::Local<v8::Object> receiver) {
+    auto* tracker = static_cast<internal::WeakPtrObjectTracker<T>*>(
+        receiver->GetAlignedPointerFromInternalField(0));
+    return tracker ? tracker->Get() : nullptr;
+  }
+};
+
+namespace internal {
+
+// Find out the class of a member function.
+template<typename T>
+struct MethodClass {};
+
+template<typename R, typename C, typename... Args>
+struct MethodClass<R(C::*)(Args...)> {
+  using Type = C;
+};
+
+template<typename R, typename C, typename... Args>
+struct MethodClass<R(C::*)(Args...) const> {
+  using Type = C;
+};
+
+// Stores the normal method, the fast version is stored in the type.
+template<typename Method, typename Fast>
+struct FastMethodRef {
+  explicit FastMethodRef(Method method) : method(method) {}
+
+  Method method;
+};
+
+// Calls |Fast::Run|, which receives the native object and primitive arguments.
+template<typename Fast, typename Run = decltype(&Fast::Run)>
+struct FastCall {};
+
+template<typename Fast, typename R, typename C, typename... Args>
+struct FastCall<Fast, R(*)(C*, Args...)> {
+  static constexpr int kArgc = sizeof...(Args);
+
+#if defined(VB_HAS_FAST_API)
+  // Called by V8 from optimized code. When the native object is gone, ask V8
+  // to fall back to the slow path, which throws the error.
+  static R Call(v8::Local<v8::Object> receiver, Args... args,
+                v8::FastApiCallbackOptions& options) {  // NOLINT
+    C* self = Receiver<C>::Get(receiver);
+    if (!self) {
+      options.fallback = true;
+      return R();
+    }
+    return Fast::Run(self, args...);
+  }
+#endif
+
+  // Called by the slow path, return false if the native object is gone.
+  static bool TryCall(Arguments* args) {
+    C* self = Receiver<C>::Get(args->This());
+    if (!self)
+      return false;
+    std::function<R(Arguments*, Args...)> callback =
+        [self](Arguments*, Args... values) {
+      return Fast::Run(self, values...);
+    };
+    using Indices = typename IndicesGenerator<sizeof...(Args) + 1>::type;
+    Invoker<Indices, Arguments*, Args...> invoker(args, 0);
+    if (invoker.IsOK())
+      invoker.DispatchToCallback(callback);
+    return true;
+  }
+};
+
+// The slow path, which is called by unoptimized code or when the arguments
+// are not all numbers.
+template<typename Sig, typename Fast>
+struct FastMethodDispatcher {};
+
+template<typename ReturnType, typename... ArgTypes, typename Fast>
+struct FastMethodDispatcher<ReturnType(ArgTypes...), Fast> {
+  using HolderT = CallbackHolder<ReturnType(ArgTypes...)>;
+
+  static void DispatchToCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info) {
+    Arguments args(info);
+
+    // Accept the arguments of fast function in the slow path too, so the
+    // result does not depend on whether the caller is optimized. If the
+    // native object is gone, the normal path below throws.
+    if (FastCall<Fast>::kArgc > 0 &&
+        info.Length() == FastCall<Fast>::kArgc &&
+        info[0]->IsNumber() &&
+        FastCall<Fast>::TryCall(&args))
+      return;
+
+    v8::Local<v8::External> v8_holder;
+    args.GetData(&v8_holder);
+    HolderT* holder = static_cast<HolderT*>(v8_holder->Value());
+    using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
+    Invoker<Indices, ArgTypes...> invoker(&args, holder->flags);
+    if (invoker.IsOK())
+      invoker.DispatchToCallback(holder->callback);
+  }
+};
+
+}  // namespace internal
+
+// Bind |method| with a fast version |Fast::Run|, which receives the native
+// object and primitive arguments. V8 calls it directly from optimized code
+// when all arguments are primitives, and falls back to |method| otherwise.
+template<typename Fast, typename Method>
+internal::FastMethodRef<Method, Fast> FastMethod(Method method) {
+  return internal::FastMethodRef<Method, Fast>(method);
+}
+
+template<typename Method, typename Fast>
+struct Type<internal::FastMethodRef<Method, Fast>> {
+  static constexpr const char* name = "Method";
+  static v8::Local<v8::Value> ToV8(
+      v8::Local<v8::Context> context,
+      const internal::FastMethodRef<Method, Fast>& ref) {
+#ifndef NDEBUG
+    internal::FunctionTemplateCreated();
+#endif
+    using RunType = typename internal::FunctorTraits<Method>::RunType;
+    using Class = typename internal::MethodClass<Method>::Type;
+    using HolderT = internal::CallbackHolder<RunType>;
+    using DispatcherT = internal::FastMethodDispatcher<RunType, Fast>;
+    v8::Isolate* isolate = context->GetIsolate();
+    auto* holder = new HolderT(isolate, std::function<RunType>(ref.method),
+                               internal::HolderIsFirstArgument);
+    // The signature makes V8 check the receiver before calling, which is
+    // required by fast functions.
+    auto signature = v8::Signature::New(
+        isolate, internal::InheritanceChain<Class>::Get(context));
+#if defined(VB_HAS_FAST_API)
+    v8::CFunction c_function =
+        v8::CFunction::Make(&internal::FastCall<Fast>::Call);
+    v8::Local<v8::FunctionTemplate> tmpl = v8::FunctionTemplate::New(
+        isolate, &DispatcherT::DispatchToCallback, holder->GetHandle(isolate),
+        signature, 0, v8::ConstructorBehavior::kThrow,
+        v8::SideEffectType::kHasSideEffect, &c_function);
+#else
+    v8::Local<v8::FunctionTemplate> tmpl = v8::FunctionTemplate::New(
+        isolate, &DispatcherT::DispatchToCallback, holder->GetHandle(isolate),
+        signature);
+    tmpl->RemovePrototype();
+#endif
+    return tmpl->GetFunction(context).ToLocalChecked();
+  }
+};
+
+}  // namespace vb
+
+#endif  // V8BINDING_FAST_METHOD_H_
@@ -5,6 +5,7 @@
 #ifndef V8BINDING_TYPES_H_
 #define V8BINDING_TYPES_H_
 
+#include <cmath>
 #include <map>
 #include <string>
 #include <tuple>
@@ -63,6 +64,29 @@ struct Type<uint32_t> {
   }
 };
 
+// JavaScript numbers can only represent integers up to 2^53 exactly.
+template<>
+struct Type<uint64_t> {
+  static constexpr const char* name = "Integer";
+  static inline v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                          uint64_t value) {
+    return v8::Number::New(context->GetIsolate(),
+                           static_cast<double>(value));
+  }
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     uint64_t* out) {
+    if (!value->IsNumber())
+      return false;
+    double number = value->NumberValue(context).ToChecked();
+    // Converting NaN or numbers out of range is undefined behavior.
+    if (std::isnan(number) || number < 0 || number >= 18446744073709551616.0)
+      return false;
+    *out = static_cast<uint64_t>(number);
+    return true;
+  }
+};
+
 template<>
 struct Type<float> {
   static constexpr const char* name = "Number";
@@ -80,6 +104,23 @@ struct Type<float> {
   }
 };
 
+template<>
+struct Type<double> {
+  static constexpr const char* name = "Number";
+  static inline v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                          double value) {
+    return v8::Number::New(context->GetIsolate(), value);
+  }
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     double* out) {
+    if (!value->IsNumber())
+      return false;
+    *out = value->NumberValue(context).ToChecked();
+    return true;
+  }
+};
+
 template<>
 struct Type<bool> {
   static constexpr const char* name = "Boolean";
@@ -6,6 +6,7 @@
 #define V8BINDING_V8BINDING_H_
 
 #include "v8binding/dict.h"
+#include "v8binding/fast_method.h"
 #include "v8binding/property.h"
 #include "v8binding/prototype.h"
 #include "v8binding/ref_method.h"